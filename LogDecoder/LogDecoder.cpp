@@ -0,0 +1,251 @@
+/*!
+\file LogDecoder.cpp
+\brief Turns binary logs back into text logs.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Header File: none.
+
+Notes:
+
+	Usage: LogDecoder <binary log or ring> [text log]
+
+	Reads a file written by CLogOutput_BinaryFile (or a CLogOutput_FlightRecorder ring)
+	and prints it in the format of CLogOutput_TextFile: "[I] [hh:mm:ss.uuuuuu] message",
+	one record per line. Output goes to stdout unless a text log name is given.
+
+	A truncated last chunk (ie. the server died mid-write) is reported and skipped.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include "Logger.h"
+#include "LogBinary.h"
+#include "LogClock.h"
+#include "LogFormat.h"
+#include "LogRing.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+using namespace TRC::VCS;
+
+//=====================================================
+//Function: ReadWholeFile()
+//Last Revised: 18.10.2026
+//	Reads whole file into memory.
+//=====================================================
+static bool ReadWholeFile(const char8* name, std::vector<char8>& data)
+{
+	FILE* file = fopen(name, "rb");
+	if(file == NULL)
+	{
+		return false;
+	}
+
+	char8 chunk[64 * 1024];
+	size_t count;
+	while((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+	{
+		data.insert(data.end(), chunk, chunk + count);
+	}
+	bool bOk = (ferror(file) == 0);
+	fclose(file);
+	return bOk;
+}
+
+//=====================================================
+//Function: PrintLine()
+//Last Revised: 18.10.2026
+//	Prints a record the way CLogOutput_TextFile does.
+//=====================================================
+static void PrintLine(FILE* out, const CLogClock& clock, uint32 msgType, uint64 timestamp, const char8* message, uint32 length)
+{
+	char8 timeText[LOG_TIME_SIZE];
+	clock.Format(timestamp, timeText);
+	fprintf(out, "[%c] [%s] %.*s\n", LogTypeChar(msgType), timeText, (int)length, message);
+}
+
+//=====================================================
+//Function: DecodeBinary()
+//Last Revised: 18.10.2026
+//	Prints records of a binary log.
+//=====================================================
+static int DecodeBinary(const std::vector<char8>& data, FILE* out)
+{
+	sint64 wallAnchor;
+	uint64 monotonicAnchor;
+	memcpy(&wallAnchor, &data[LOG_BINARY_MAGIC_SIZE], sizeof(wallAnchor));
+	memcpy(&monotonicAnchor, &data[LOG_BINARY_MAGIC_SIZE + 8], sizeof(monotonicAnchor));
+	CLogClock clock(wallAnchor, monotonicAnchor);
+
+	std::map<uint16, std::string> formats;	//format id -> format string
+	char8 messageText[LOG_MESSAGE_SIZE];
+	const char8* bytes = &data[0];
+	size_t size = data.size();
+	size_t pos = LOG_BINARY_HEADER_SIZE;
+	int result = 0;
+	while(pos < size)
+	{
+		if(bytes[pos] == LBC_Format && pos + LOG_BINARY_FORMAT_HEADER_SIZE <= size)
+		{
+			uint16 id, length;
+			memcpy(&id, bytes + pos + 1, sizeof(id));
+			memcpy(&length, bytes + pos + 3, sizeof(length));
+			pos += LOG_BINARY_FORMAT_HEADER_SIZE;
+			if(pos + length > size)
+			{
+				break;
+			}
+			formats[id] = std::string(bytes + pos, length);
+			pos += length;
+		}
+		else if(bytes[pos] == LBC_Record && pos + LOG_BINARY_RECORD_HEADER_SIZE <= size)
+		{
+			uint32 msgType = (uint8)bytes[pos + 1];
+			uint64 timestamp;
+			uint16 formatId, length;
+			memcpy(&timestamp, bytes + pos + 2, sizeof(timestamp));
+			memcpy(&formatId, bytes + pos + 10, sizeof(formatId));
+			memcpy(&length, bytes + pos + 12, sizeof(length));
+			pos += LOG_BINARY_RECORD_HEADER_SIZE;
+			if(pos + length > size)
+			{
+				break;
+			}
+
+			const char8* message = bytes + pos;
+			uint32 messageLength = length;
+			if(formatId != LOG_BINARY_TEXT_FORMAT)
+			{
+				std::map<uint16, std::string>::iterator itor = formats.find(formatId);
+				if(itor == formats.end())
+				{
+					sprintf(messageText, "<unknown format #%u>", (uint32)formatId);
+					messageLength = (uint32)strlen(messageText);
+				}
+				else
+				{
+					messageLength = CLogFormat::Render(messageText, LOG_MESSAGE_SIZE, (*itor).second.c_str(), message, length);
+				}
+				message = messageText;
+			}
+			pos += length;
+
+			PrintLine(out, clock, msgType, timestamp, message, messageLength);
+		}
+		else if(bytes[pos] != LBC_Format && bytes[pos] != LBC_Record)
+		{
+			fprintf(stderr, "LogDecoder: corrupt chunk at offset %lu\n", (unsigned long)pos);
+			result = 2;
+			break;
+		}
+		else
+		{
+			break;	//truncated chunk header
+		}
+	}
+	if(result == 0 && pos < size)
+	{
+		fprintf(stderr, "LogDecoder: truncated chunk at offset %lu skipped\n", (unsigned long)pos);
+	}
+	return result;
+}
+
+//=====================================================
+//Function: DecodeRing()
+//Last Revised: 18.10.2026
+//	Prints records of a flight recorder ring, oldest first.
+//=====================================================
+static int DecodeRing(std::vector<char8>& data, FILE* out)
+{
+	CLogRing ring;
+	if(!ring.Attach(&data[0], (uint32)data.size()))
+	{
+		fprintf(stderr, "LogDecoder: corrupt ring header\n");
+		return 2;
+	}
+
+	CLogClock clock = ring.GetClock();
+	SLogRingCursor cursor = ring.Begin();
+	SLogRingEntry entry;
+	char8 messageText[LOG_MESSAGE_SIZE];
+	uint32 count = 0;
+	while(ring.Next(cursor, entry))
+	{
+		uint32 length = CLogRing::RenderMessage(entry, messageText, LOG_MESSAGE_SIZE);
+		PrintLine(out, clock, entry.msgType, entry.timestamp, messageText, length);
+		++count;
+	}
+	if(count != ring.GetCount())
+	{
+		fprintf(stderr, "LogDecoder: ring is corrupt after %u records\n", count);
+		return 2;
+	}
+	return 0;
+}
+
+//=====================================================
+//Function: main()
+//Last Revised: 18.10.2026
+//	Decodes binary log given on the command line.
+//=====================================================
+int main(int argc, char* argv[])
+{
+	if(argc < 2 || argc > 3)
+	{
+		fprintf(stderr, "Usage: LogDecoder <binary log or ring> [text log]\n");
+		return 1;
+	}
+
+	std::vector<char8> data;
+	if(!ReadWholeFile(argv[1], data))
+	{
+		fprintf(stderr, "LogDecoder: can't read %s\n", argv[1]);
+		return 1;
+	}
+	if( data.size() < LOG_BINARY_HEADER_SIZE
+		|| ( memcmp(&data[0], LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) != 0 && memcmp(&data[0], LOG_RING_MAGIC, LOG_RING_MAGIC_SIZE) != 0 ) )
+	{
+		fprintf(stderr, "LogDecoder: %s is neither a binary log nor a ring\n", argv[1]);
+		return 1;
+	}
+
+	FILE* out = stdout;
+	if(argc == 3)
+	{
+		out = fopen(argv[2], "w");
+		if(out == NULL)
+		{
+			fprintf(stderr, "LogDecoder: can't write %s\n", argv[2]);
+			return 1;
+		}
+	}
+
+	int result;
+	if(memcmp(&data[0], LOG_RING_MAGIC, LOG_RING_MAGIC_SIZE) == 0)
+	{
+		result = DecodeRing(data, out);
+	}
+	else
+	{
+		result = DecodeBinary(data, out);
+	}
+
+	if(out != stdout)
+	{
+		fclose(out);
+	}
+	return result;
+}
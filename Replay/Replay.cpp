@@ -0,0 +1,1107 @@
+/*!
+\file Replay.cpp
+\brief vcs-replay - measures command throughput and latency of VC System.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Header File: none.
+
+Notes:
+
+	Usage: vcs-replay <transcript> [-interval <ms>] [-repeat <n>] [-realtime] [-early] [-fuzzy]
+	       vcs-replay -bench-grammar [<phrases>]
+	       vcs-replay -bench-fuzzy [<phrases>]
+	       vcs-replay -bench-cache [<phrases>]
+	       vcs-replay -bench-log [<events>]
+	       vcs-replay -bench-timers [<timers>]
+
+	Runs the real CVCSystem::Run() with its dialogues, and CWinAMPController commands
+	on utterances from a transcript (see Recognizer_Replay.h for the format),
+	with a stub player and no sounds. By default utterances come back to back
+	as fast as VC System takes them; -realtime waits the transcript's delays,
+	-interval sets the default delay, -repeat plays the transcript n times.
+	-early makes VC System act on "~" hypotheses of the transcript; -fuzzy takes
+	utterances that aren't phrases as the nearest phrase (see FuzzyMatcher.h).
+
+	Latency of a command is the time from handing its recognition result to
+	VC System until VC System polls for the next one - that is the whole dispatch,
+	player call included, plus a turn of VC System's reactor. Reported per command text, with percentiles.
+
+	Run from the VCServer directory, so grammar/ files are found. Logs go to
+	vcs.log as usual, with VC System's own per-stage latency dump at the end.
+
+	-bench-grammar doesn't run VC System: it generates grammars of 100 up to
+	<phrases> (50000) phrases, playlist-like, and times CGrammarMatcher's
+	compile and lookups against a scan of every phrase, on the same queries -
+	half of them phrases, half near misses. -bench-fuzzy times CFuzzyMatcher's
+	kernels - edit distances of a text to every phrase, SSE2 against scalar -
+	and Find(), on phrases of such grammars with a few letters changed; it
+	checks the kernels agree, and counts texts mapped back to their phrase.
+	-bench-cache writes such grammars as XML (bench-grammar.xml, in the current
+	directory) and times loading them the old way - CGrammarXML parsing and
+	expanding every start - against CGrammarCache, the first start (parsing,
+	and writing the cache) and the next ones (reading it); it checks the cache
+	gives the grammar back.
+	-bench-log times the debug logging of the old BlockForResult() loop - a
+	boost::format "Awaiting for event" per empty wakeup, "Event received" and
+	"Event processed" per event - with VCS_LOG_MIN_LEVEL above debug (the
+	calls compiled out), and at debug, with an output taking debug messages
+	and without one. Then it counts heap allocations (vcs-replay replaces
+	operator new) made while logging plain text, std::string and printf-style
+	messages - synchronously and asynchronously, rate limited as VC System
+	sets it up - and fails if there were any.
+	-bench-timers stress tests CTimingWheel: it starts <timers> (100000) timers
+	due from 0 ms up to days ahead, so every level of the wheel and its
+	cascades get used, cancels some of them - and some that fired, with their
+	stale handles - while advancing in steps of a few ms and in big jumps;
+	handlers start timers too. It checks every timer fires once, in the
+	Advance() its tick falls in, and only if it wasn't cancelled, that the
+	wheel's count of timers and GetWaitTime() are right, and fails if not.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include "VCSystem.h"
+#include "Recognizer_Replay.h"
+#include "GrammarCache.h"
+#include "GrammarMatcher.h"
+#include "FuzzyMatcher.h"
+#include "TimingWheel.h"
+#include "Player.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace TRC::VCS;
+
+static atomic32 allocations = 0;	//!< Count of operator new calls while bCountAllocations is on.
+static atomic32 bCountAllocations = 0;	//!< Count allocations?
+
+//=====================================================
+//Function: operator new()
+//Last Revised: 18.10.2026
+//	Allocates like the default one, counting calls for -bench-log.
+//=====================================================
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+	if(AtomicLoad(&bCountAllocations))
+	{
+		AtomicIncrement(&allocations);
+	}
+	void* memory = malloc((size > 0) ? size : 1);
+	if(memory == NULL)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+//=====================================================
+//Function: operator new[]()
+//Last Revised: 18.10.2026
+//	See operator new().
+//=====================================================
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+	return operator new(size);
+}
+
+//=====================================================
+//Function: operator delete()
+//Last Revised: 18.10.2026
+//	Frees memory of operator new().
+//=====================================================
+void operator delete(void* memory) throw()
+{
+	free(memory);
+}
+
+//=====================================================
+//Function: operator delete[]()
+//Last Revised: 18.10.2026
+//	Frees memory of operator new[]().
+//=====================================================
+void operator delete[](void* memory) throw()
+{
+	free(memory);
+}
+
+//! \brief Player that only counts what it's told to do.
+class CPlayer_Stub : public IPlayer
+{
+protected:
+	std::map<std::string, uint32> calls;	//!< Count of calls, by action.
+	uint32 volume;	//!< Volume set last.
+
+	void Count(const char8* action){ ++calls[action]; }
+
+public:
+	CPlayer_Stub():volume(PLAYER_MAX_VOLUME){}	//!< Default c-tor.
+
+	virtual bool Find(){ return true; }
+	virtual void Open(const std::string& fileName){ Count("Open"); }
+	virtual void Play(){ Count("Play"); }
+	virtual void Pause(){ Count("Pause"); }
+	virtual void Stop(){ Count("Stop"); }
+	virtual void Next(){ Count("Next"); }
+	virtual void Previous(){ Count("Previous"); }
+	virtual void ToggleShuffle(){ Count("ToggleShuffle"); }
+	virtual void ToggleRepeat(){ Count("ToggleRepeat"); }
+	virtual void SetVolume(uint32 _volume){ Count("SetVolume"); volume = _volume; }
+	virtual uint32 GetVolume(){ return volume; }
+	virtual void VolumeUp(){ Count("VolumeUp"); }
+	virtual void VolumeDown(){ Count("VolumeDown"); }
+
+	//! \brief Returns calls counted so far.
+	const std::map<std::string, uint32>& GetCalls() const { return calls; }
+};
+
+//! \brief Log output that only counts what it's given.
+class CLogOutput_Null : public ILogOutput
+{
+protected:
+	atomic32 count;	//!< Messages written.
+
+public:
+	CLogOutput_Null():count(0){}	//!< Default c-tor.
+
+	virtual bool Init(){ return true; }
+	virtual bool DeInit(){ return true; }
+	virtual void Write(uint32 msgType, const SLogText& time, const SLogText& message){ AtomicIncrement(&count); }
+
+	//! \brief Returns count of messages written so far.
+	uint32 GetCount() const { return (uint32)AtomicLoad(&count); }
+};
+
+//! \brief Utterance injection shim: replays the transcript and times VC System's dispatch.
+class CReplayShim : public CRecognizer_Replay
+{
+protected:
+	typedef std::map<std::string, std::vector<uint64> > latencyMap_t;	//!< Type of latencies by command.
+
+	uint32 repeat;	//!< How many more times to play the transcript.
+	bool bOutstanding;	//!< Is VC System busy with a result?
+	uint64 delivered;	//!< CLogClock::Now() when the last result was handed over.
+	std::string command;	//!< Text of the last result.
+	latencyMap_t latencies;	//!< Dispatch times [ns], by command.
+
+	//! \brief Records dispatch time of the outstanding result, if any.
+	void Complete()
+	{
+		if(bOutstanding)
+		{
+			latencies[command].push_back(CLogClock::Now() - delivered);
+			bOutstanding = false;
+		}
+	}
+
+public:
+	CReplayShim(CLogger& _logger, const std::string& _fileName, uint32 _interval, bool _bRealTime, uint32 _repeat)
+		:CRecognizer_Replay(_logger, _fileName, _interval, _bRealTime), repeat(_repeat), bOutstanding(false), delivered(0){}
+
+	virtual bool DeInit()
+	{
+		Complete();
+		return CRecognizer_Replay::DeInit();
+	}
+
+	virtual E_RecoStatus PollResult(SRecoResult& result, uint32 timeLeft = RECO_INFINITE)
+	{
+		Complete();
+		E_RecoStatus status = CRecognizer_Replay::PollResult(result, timeLeft);
+		while(status == RS_Finished && repeat > 1)
+		{
+			--repeat;
+			Rewind();
+			status = CRecognizer_Replay::PollResult(result, timeLeft);
+		}
+		if(status == RS_Recognized || status == RS_Hypothesis)
+		{
+			command = std::string((status == RS_Hypothesis) ? "~" : "") + result.text;
+			std::transform(command.begin(), command.end(), command.begin(), tolower);
+			bOutstanding = true;
+			delivered = CLogClock::Now();
+		}
+		return status;
+	}
+
+	//! \brief Returns dispatch times [ns], by command.
+	const latencyMap_t& GetLatencies() const { return latencies; }
+};
+
+//=====================================================
+//Function: Percentile()
+//Last Revised: 18.10.2026
+//	Returns nearest-rank percentile of sorted samples.
+//=====================================================
+static uint64 Percentile(const std::vector<uint64>& sorted, uint32 percent)
+{
+	if(sorted.empty())
+	{
+		return 0;
+	}
+	size_t rank = (sorted.size() * percent + 99) / 100;
+	return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+//=====================================================
+//Function: PrintLatencies()
+//Last Revised: 18.10.2026
+//	Prints a row of latency table [us].
+//=====================================================
+static void PrintLatencies(const std::string& name, std::vector<uint64> samples)
+{
+	std::sort(samples.begin(), samples.end());
+	printf("%-24s %8u %10.1f %10.1f %10.1f %10.1f\n", name.c_str(), (uint32)samples.size(),
+		Percentile(samples, 50) / 1000.0, Percentile(samples, 90) / 1000.0, Percentile(samples, 99) / 1000.0,
+		(samples.empty() ? 0 : samples.back()) / 1000.0);
+}
+
+//=====================================================
+//Function: Random()
+//Last Revised: 18.10.2026
+//	Returns next number of a fixed pseudo-random sequence, so benchmarks are repeatable.
+//=====================================================
+static uint32 Random(uint32& state)
+{
+	state = state * 1664525 + 1013904223;
+	return state >> 8;
+}
+
+//=====================================================
+//Function: GenerateGrammar()
+//Last Revised: 18.10.2026
+//	Generates grammar of phraseCount playlist-like phrases.
+//=====================================================
+static void GenerateGrammar(uint32 phraseCount, SGrammar& grammar)
+{
+	static const char8* syllables[] = { "la", "mo", "ri", "ven", "dar", "su", "kel", "to", "bra", "nim", "os", "phe" };
+	const uint32 syllableCount = sizeof(syllables) / sizeof(syllables[0]);
+	const uint32 ruleCount = 8;
+	uint32 wordCount = (phraseCount / 4 > 64) ? phraseCount / 4 : 64;
+	uint32 state = phraseCount;
+
+	std::vector<std::string> words;
+	for(uint32 i = 0 ; i < wordCount ; ++i)
+	{
+		std::string word;
+		for(uint32 n = i ; ; n /= syllableCount)
+		{
+			word += syllables[n % syllableCount];
+			if(n < syllableCount)
+			{
+				break;
+			}
+		}
+		words.push_back(word);
+	}
+
+	grammar.rules.resize(ruleCount);
+	for(uint32 r = 0 ; r < ruleCount ; ++r)
+	{
+		grammar.rules[r].id = 100 + r;
+		grammar.rules[r].bTopLevel = true;
+		grammar.rules[r].bActive = true;
+	}
+	for(uint32 i = 0 ; i < phraseCount ; ++i)
+	{
+		SGrammarPhrase phrase;
+		phrase.words.push_back("play");
+		uint32 length = 2 + Random(state) % 3;
+		for(uint32 w = 0 ; w < length ; ++w)
+		{
+			phrase.words.push_back(words[Random(state) % wordCount]);
+		}
+		phrase.value = 1 + i % 255;
+		phrase.bValue = true;
+		grammar.rules[i % ruleCount].phrases.push_back(phrase);
+	}
+}
+
+//=====================================================
+//Function: ScanGrammar()
+//Last Revised: 18.10.2026
+//	Looks phrase up the way replay did before CGrammarMatcher - every phrase of every rule.
+//=====================================================
+static bool ScanGrammar(const SGrammar& grammar, const std::vector<std::string>& words, uint32& ruleId, uint32& value)
+{
+	for(std::vector<SGrammarRule>::const_iterator rule = grammar.rules.begin() ; rule != grammar.rules.end() ; ++rule)
+	{
+		for(std::vector<SGrammarPhrase>::const_iterator phrase = (*rule).phrases.begin() ; phrase != (*rule).phrases.end() ; ++phrase)
+		{
+			if((*phrase).words == words)
+			{
+				ruleId = (*rule).id;
+				value = (*phrase).value;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+//=====================================================
+//Function: BenchGrammar()
+//Last Revised: 18.10.2026
+//	Times CGrammarMatcher against ScanGrammar() on generated grammars.
+//=====================================================
+static int BenchGrammar(uint32 maxPhrases)
+{
+	const uint32 queryCount = 2000;
+	printf("%10s %8s %8s %10s %12s %12s %12s %8s\n", "phrases", "words", "nodes", "size [kB]", "compile [ms]", "trie [ns]", "scan [ns]", "speedup");
+
+	bool bAgree = true;
+	for(uint32 phraseCount = 100 ; ; phraseCount *= 10)
+	{
+		if(phraseCount > maxPhrases)
+		{
+			phraseCount = maxPhrases;
+		}
+		SGrammar grammar;
+		GenerateGrammar(phraseCount, grammar);
+
+		uint64 start = CLogClock::Now();
+		CGrammarMatcher matcher;
+		matcher.Add(0, grammar);
+		matcher.Compile();
+		uint64 compileTime = CLogClock::Now() - start;
+
+		//every other query a phrase; the rest have a word swapped for one of another phrase
+		uint32 state = 1;
+		std::vector<std::vector<std::string> > queries;
+		for(uint32 i = 0 ; i < queryCount ; ++i)
+		{
+			const SGrammarRule& rule = grammar.rules[Random(state) % grammar.rules.size()];
+			std::vector<std::string> query = rule.phrases[Random(state) % rule.phrases.size()].words;
+			if(i % 2)
+			{
+				const SGrammarRule& other = grammar.rules[Random(state) % grammar.rules.size()];
+				const std::vector<std::string>& donor = other.phrases[Random(state) % other.phrases.size()].words;
+				query[query.size() - 1] = donor[1 + Random(state) % (donor.size() - 1)];
+			}
+			queries.push_back(query);
+		}
+
+		uint32 rounds = 100;
+		uint32 found = 0;
+		start = CLogClock::Now();
+		for(uint32 round = 0 ; round < rounds ; ++round)
+		{
+			for(uint32 i = 0 ; i < queryCount ; ++i)
+			{
+				const SGrammarMatch* match = NULL;
+				found += matcher.Find(queries[i], match);
+			}
+		}
+		float64 trieTime = (float64)(CLogClock::Now() - start) / ((float64)rounds * queryCount);
+
+		uint32 scanned = (phraseCount > 10000) ? queryCount / 10 : queryCount;	//scan's slow; time fewer
+		start = CLogClock::Now();
+		for(uint32 i = 0 ; i < scanned ; ++i)
+		{
+			uint32 ruleId = 0, value = 0;
+			const SGrammarMatch* match = NULL;
+			bool bScan = ScanGrammar(grammar, queries[i], ruleId, value);
+			bool bTrie = (matcher.Find(queries[i], match) > 0);
+			if(bScan != bTrie || (bScan && (match->ruleId != ruleId || match->value != value)))
+			{
+				bAgree = false;
+			}
+		}
+		float64 scanTime = (float64)(CLogClock::Now() - start) / scanned - trieTime;
+
+		printf("%10u %8u %8u %10.1f %12.2f %12.1f %12.1f %7.0fx\n", matcher.GetPhraseCount(), matcher.GetWordCount(), matcher.GetNodeCount(),
+			matcher.GetSize() / 1024.0, compileTime / 1e6, trieTime, scanTime, (trieTime > 0.0) ? scanTime / trieTime : 0.0);
+		if(phraseCount >= maxPhrases)
+		{
+			break;
+		}
+	}
+	printf("\ntrie and scan %s\n", (bAgree) ? "agree" : "DISAGREE");
+	return (bAgree) ? 0 : 1;
+}
+
+//=====================================================
+//Function: AllActive()
+//Last Revised: 18.10.2026
+//	Tells CFuzzyMatcher::Find() every rule is active.
+//=====================================================
+static bool AllActive(uint32 grammar, uint32 rule)
+{
+	return true;
+}
+
+//=====================================================
+//Function: BenchFuzzy()
+//Last Revised: 18.10.2026
+//	Times CFuzzyMatcher's kernels against each other on generated grammars.
+//=====================================================
+static int BenchFuzzy(uint32 maxPhrases)
+{
+	const uint32 queryCount = 200;
+	printf("%10s %12s %12s %8s %12s %8s\n", "phrases", "scalar [us]", "sse2 [us]", "speedup", "find [us]", "found");
+
+	bool bAgree = true;
+	for(uint32 phraseCount = 100 ; ; phraseCount *= 10)
+	{
+		if(phraseCount > maxPhrases)
+		{
+			phraseCount = maxPhrases;
+		}
+		SGrammar grammar;
+		GenerateGrammar(phraseCount, grammar);
+		CFuzzyMatcher matcher;
+		matcher.Add(0, grammar);
+		matcher.Compile();
+
+		//phrases with a letter or two changed, dropped or added
+		uint32 state = 1;
+		std::vector<std::string> queries;
+		std::vector<std::pair<uint32, uint32> > sources;	//rule and value of the phrase a query was made of
+		for(uint32 i = 0 ; i < queryCount ; ++i)
+		{
+			const SGrammarRule& rule = grammar.rules[Random(state) % grammar.rules.size()];
+			const SGrammarPhrase& phrase = rule.phrases[Random(state) % rule.phrases.size()];
+			std::string query;
+			for(size_t w = 0 ; w < phrase.words.size() ; ++w)
+			{
+				query += (query.empty() ? "" : " ") + phrase.words[w];
+			}
+			for(uint32 edits = 1 + Random(state) % 2 ; edits > 0 ; --edits)
+			{
+				size_t at = 5 + Random(state) % (query.size() - 5);	//past "play "
+				switch(Random(state) % 3)
+				{
+				case 0: query[at] = (char8)('a' + Random(state) % 26); break;
+				case 1: query.erase(at, 1); break;
+				default: query.insert(at, 1, (char8)('a' + Random(state) % 26)); break;
+				}
+			}
+			queries.push_back(query);
+			sources.push_back(std::make_pair(rule.id, phrase.value));
+		}
+
+		uint32 scalarCount = (phraseCount > 10000) ? queryCount / 10 : queryCount;	//scalar's slow; time fewer
+		std::vector<std::vector<uint8> > scalarDistances;
+		uint64 start = CLogClock::Now();
+		for(uint32 i = 0 ; i < scalarCount ; ++i)
+		{
+			scalarDistances.push_back(matcher.GetDistances(queries[i], CFuzzyMatcher::FK_Scalar));
+		}
+		float64 scalarTime = (float64)(CLogClock::Now() - start) / scalarCount / 1000.0;
+
+		float64 sseTime = 0.0;
+	#if VCS_FUZZY_SSE2
+		start = CLogClock::Now();
+		for(uint32 i = 0 ; i < queryCount ; ++i)
+		{
+			const std::vector<uint8>& distances = matcher.GetDistances(queries[i], CFuzzyMatcher::FK_SSE2);
+			if(i < scalarCount && distances != scalarDistances[i])
+			{
+				bAgree = false;
+			}
+		}
+		sseTime = (float64)(CLogClock::Now() - start) / queryCount / 1000.0;
+	#endif //VCS_FUZZY_SSE2
+
+		uint32 found = 0;
+		start = CLogClock::Now();
+		for(uint32 i = 0 ; i < queryCount ; ++i)
+		{
+			SFuzzyMatch match;
+			if(matcher.Find(queries[i], AllActive, &match, 1) > 0 && match.ruleId == sources[i].first && match.value == sources[i].second)
+			{
+				++found;
+			}
+		}
+		float64 findTime = (float64)(CLogClock::Now() - start) / queryCount / 1000.0;
+
+		printf("%10u %12.1f %12.1f %7.1fx %12.1f %7u%%\n", matcher.GetPhraseCount(), scalarTime, sseTime,
+			(sseTime > 0.0) ? scalarTime / sseTime : 0.0, findTime, found * 100 / queryCount);
+		if(phraseCount >= maxPhrases)
+		{
+			break;
+		}
+	}
+	printf("\nkernels %s\n", (bAgree) ? "agree" : "DISAGREE");
+	return (bAgree) ? 0 : 1;
+}
+
+//=====================================================
+//Function: WriteGrammarXML()
+//Last Revised: 18.10.2026
+//	Writes grammar as SAPI XML, a list of phrases per rule.
+//=====================================================
+static bool WriteGrammarXML(const SGrammar& grammar, const std::string& fileName)
+{
+	FILE* file = fopen(fileName.c_str(), "wb");
+	if(file == NULL)
+	{
+		return false;
+	}
+	fprintf(file, "<GRAMMAR LANGID=\"409\">\n");
+	for(std::vector<SGrammarRule>::const_iterator rule = grammar.rules.begin() ; rule != grammar.rules.end() ; ++rule)
+	{
+		fprintf(file, "\t<RULE ID=\"%u\" TOPLEVEL=\"%s\">\n\t\t<L>\n", (*rule).id, ((*rule).bActive) ? "Active" : "Inactive");
+		for(std::vector<SGrammarPhrase>::const_iterator phrase = (*rule).phrases.begin() ; phrase != (*rule).phrases.end() ; ++phrase)
+		{
+			fprintf(file, "\t\t\t<P VAL=\"%u\">", (*phrase).value);
+			for(size_t w = 0 ; w < (*phrase).words.size() ; ++w)
+			{
+				fprintf(file, (w > 0) ? " %s" : "%s", (*phrase).words[w].c_str());
+			}
+			fprintf(file, "</P>\n");
+		}
+		fprintf(file, "\t\t</L>\n\t</RULE>\n");
+	}
+	fprintf(file, "</GRAMMAR>\n");
+	return fclose(file) == 0;
+}
+
+//=====================================================
+//Function: SameGrammar()
+//Last Revised: 18.10.2026
+//	Checks if two grammars have the same rules and phrases.
+//=====================================================
+static bool SameGrammar(const SGrammar& first, const SGrammar& second)
+{
+	if(first.rules.size() != second.rules.size() || first.defines != second.defines)
+	{
+		return false;
+	}
+	for(size_t r = 0 ; r < first.rules.size() ; ++r)
+	{
+		const SGrammarRule& a = first.rules[r];
+		const SGrammarRule& b = second.rules[r];
+		if(a.id != b.id || a.name != b.name || a.bTopLevel != b.bTopLevel || a.bActive != b.bActive || a.phrases.size() != b.phrases.size())
+		{
+			return false;
+		}
+		for(size_t p = 0 ; p < a.phrases.size() ; ++p)
+		{
+			if(a.phrases[p].words != b.phrases[p].words || a.phrases[p].value != b.phrases[p].value || a.phrases[p].bValue != b.phrases[p].bValue)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+//=====================================================
+//Function: BenchCache()
+//Last Revised: 18.10.2026
+//	Times loading grammars through CGrammarCache against parsing their XML.
+//=====================================================
+static int BenchCache(uint32 maxPhrases)
+{
+	const std::string xmlFile = "bench-grammar.xml";
+	const std::string cacheFile = CGrammarCache::GetFileName(xmlFile, "phrases");
+	printf("%10s %10s %12s %10s %12s %10s %8s\n", "phrases", "xml [kB]", "cache [kB]", "xml [ms]", "first [ms]", "next [ms]", "speedup");
+
+	bool bSame = true;
+	for(uint32 phraseCount = 100 ; ; phraseCount *= 10)
+	{
+		if(phraseCount > maxPhrases)
+		{
+			phraseCount = maxPhrases;
+		}
+		SGrammar generated;
+		GenerateGrammar(phraseCount, generated);
+		if(!WriteGrammarXML(generated, xmlFile))
+		{
+			fprintf(stderr, "vcs-replay: can't write %s\n", xmlFile.c_str());
+			return 1;
+		}
+		remove(cacheFile.c_str());
+
+		uint32 rounds = (phraseCount > 10000) ? 3 : 20;
+		std::string error;
+		SGrammar parsed;
+		uint64 start = CLogClock::Now();
+		for(uint32 round = 0 ; round < rounds ; ++round)
+		{
+			CGrammarXML::Load(xmlFile, parsed, error);
+		}
+		float64 xmlTime = (float64)(CLogClock::Now() - start) / rounds / 1e6;
+
+		//first start - a miss: parsed, and cached
+		SGrammar cached;
+		bool bCached = true, bStored = false;
+		start = CLogClock::Now();
+		CGrammarCache::LoadGrammar(xmlFile, cached, error, bCached, bStored);
+		float64 firstTime = (float64)(CLogClock::Now() - start) / 1e6;
+		if(bCached || !bStored)
+		{
+			bSame = false;
+		}
+
+		//next starts - hits
+		uint32 hits = 0;
+		start = CLogClock::Now();
+		for(uint32 round = 0 ; round < rounds ; ++round)
+		{
+			CGrammarCache::LoadGrammar(xmlFile, cached, error, bCached, bStored);
+			hits += (bCached) ? 1 : 0;
+		}
+		float64 nextTime = (float64)(CLogClock::Now() - start) / rounds / 1e6;
+		if(hits != rounds || !SameGrammar(parsed, cached))
+		{
+			bSame = false;
+		}
+
+		std::string xml, cache;
+		CGrammarCache::ReadFile(xmlFile, xml);
+		CGrammarCache::ReadFile(cacheFile, cache);
+		printf("%10u %10.1f %12.1f %10.2f %12.2f %10.2f %7.1fx\n", phraseCount, xml.size() / 1024.0, cache.size() / 1024.0,
+			xmlTime, firstTime, nextTime, (nextTime > 0.0) ? xmlTime / nextTime : 0.0);
+		if(phraseCount >= maxPhrases)
+		{
+			break;
+		}
+	}
+	remove(xmlFile.c_str());
+	remove(cacheFile.c_str());
+	printf("\ncached grammars %s\n", (bSame) ? "match" : "DON'T MATCH");
+	return (bSame) ? 0 : 1;
+}
+
+//VCS_LOG_DEBUG as Logger.h defines it with VCS_LOG_MIN_LEVEL at debug...
+#define BENCH_LOG_DEBUG_IN(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_Debug, message)
+//...and above it.
+#define BENCH_LOG_DEBUG_OUT(logger, message) ((void)0)
+
+//Debug logging of the old BlockForResult() loop, through LOG_DEBUG.
+#define BENCH_BLOCK_FOR_RESULT(LOG_DEBUG) \
+	for(uint32 event = 0 ; event < events ; ++event) \
+	{ \
+		for(uint32 wakeup = 0 ; wakeup < wakeups ; ++wakeup) \
+		{ \
+			LOG_DEBUG(logger, boost::format("Awaiting for event...[%x]") % howLong); \
+		} \
+		LOG_DEBUG(logger, "Event received"); \
+		LOG_DEBUG(logger, "Event processed"); \
+	}
+
+//=====================================================
+//Function: BlockForResultLogIn()
+//Last Revised: 18.10.2026
+//	Runs the old BlockForResult() logging with debug calls compiled in; returns time it took [ns].
+//=====================================================
+static uint64 BlockForResultLogIn(CLogger& logger, uint32 events, uint32 wakeups, uint32 howLong)
+{
+	uint64 start = CLogClock::Now();
+	BENCH_BLOCK_FOR_RESULT(BENCH_LOG_DEBUG_IN)
+	return CLogClock::Now() - start;
+}
+
+//=====================================================
+//Function: BlockForResultLogOut()
+//Last Revised: 18.10.2026
+//	Runs the old BlockForResult() logging with debug calls compiled out; returns time it took [ns].
+//=====================================================
+static uint64 BlockForResultLogOut(CLogger& logger, uint32 events, uint32 wakeups, uint32 howLong)
+{
+	uint64 start = CLogClock::Now();
+	BENCH_BLOCK_FOR_RESULT(BENCH_LOG_DEBUG_OUT)
+	return CLogClock::Now() - start;
+}
+
+//=====================================================
+//Function: CountLogAllocations()
+//Last Revised: 18.10.2026
+//	Logs messages of every kind that shouldn't allocate; returns count of allocations made meanwhile.
+//=====================================================
+static uint32 CountLogAllocations(CLogger& logger, uint32 messages)
+{
+	const std::string text("Recognized: music volume half");	//built before counting
+	AtomicExchange(&allocations, 0);
+	AtomicExchange(&bCountAllocations, 1);
+	for(uint32 i = 0 ; i < messages ; ++i)
+	{
+		logger.Log(LMT_Info, "CVCSystem::Run() - Waiting for a command");
+		logger.Log(LMT_Info, text);
+		logger.LogF(LMT_Info, "Dispatched %u/%u in %u us", i, i % 255, i * 3);
+		VCS_LOGF_DEBUG(logger, "Awaiting for event...[%lx]", (unsigned long)i);
+		VCS_LOGF_INFO(logger, "Recognized: %s (%u%%)", text.c_str(), i % 100);
+	}
+	logger.Flush();	//asynchronously, writers have to be done too
+	AtomicExchange(&bCountAllocations, 0);
+	return (uint32)AtomicLoad(&allocations);
+}
+
+//=====================================================
+//Function: BenchLog()
+//Last Revised: 18.10.2026
+//	Times debug logging of the old BlockForResult() loop, compiled out and in.
+//=====================================================
+static int BenchLog(uint32 events)
+{
+	const uint32 wakeups = 3;	//empty wakeups per event
+	const uint32 howLong = (uint32)events | 0x1000;	//not a constant, so nothing's folded away
+	printf("%-36s %12s %10s\n", "VCS_LOG_DEBUG", "[ns/event]", "records");
+
+	CLogOutput_Null output;
+	CLogger logger;
+	logger.Init();
+
+	//compiled out: no output needed, there's nothing left to call one
+	float64 outTime = (float64)BlockForResultLogOut(logger, events, wakeups, howLong) / events;
+	printf("%-36s %12.1f %10u\n", "compiled out (MIN_LEVEL > debug)", outTime, 0);
+
+	//compiled in, nobody takes debug: Accepts() skips the message
+	logger.AddLogOutput(&output, LMTF_Default & ~LMT_Debug);
+	uint32 before = output.GetCount();
+	float64 skippedTime = (float64)BlockForResultLogIn(logger, events, wakeups, howLong) / events;
+	printf("%-36s %12.1f %10u\n", "compiled in, debug not taken", skippedTime, output.GetCount() - before);
+	logger.RemoveLogOutput(&output);
+
+	//compiled in, debug taken: formatted and written
+	logger.AddLogOutput(&output, LMTF_Default);
+	before = output.GetCount();
+	float64 inTime = (float64)BlockForResultLogIn(logger, events, wakeups, howLong) / events;
+	uint32 written = output.GetCount() - before;
+	printf("%-36s %12.1f %10u\n", "compiled in, debug written", inTime, written);
+	logger.RemoveLogOutput(&output);
+	logger.DeInit();
+
+	printf("\ncompiled out saves %.1f ns/event against debug written, %.1f ns/event against debug not taken\n",
+		inTime - outTime, skippedTime - outTime);
+	bool bOk = (written == events * (wakeups + 2));
+	if(!bOk)
+	{
+		printf("records written: %u, expected %u\n", written, events * (wakeups + 2));
+	}
+
+	//heap allocations while logging, set up like VC System's logger
+	const uint32 messages = 10000;
+	printf("\n%-36s %12s %10s\n", "logging mode", "messages", "allocs");
+	CLogger counted;
+	counted.Init();
+	counted.AddLogOutput(&output, LMTF_Default);
+	counted.SetDefaultLimit(SLogLimit(50, 1000, 10));
+	uint32 syncAllocations = CountLogAllocations(counted, messages);
+	printf("%-36s %12u %10u\n", "synchronous", messages * 5, syncAllocations);
+	counted.StartAsync(4096, LOP_Block);
+	uint32 asyncAllocations = CountLogAllocations(counted, messages);
+	printf("%-36s %12u %10u\n", "asynchronous", messages * 5, asyncAllocations);
+	counted.StopAsync();
+	counted.RemoveLogOutput(&output);
+	counted.DeInit();
+	if(syncAllocations != 0 || asyncAllocations != 0)
+	{
+		printf("\nlogging ALLOCATES\n");
+		bOk = false;
+	}
+	else
+	{
+		printf("\nlogging doesn't allocate\n");
+	}
+	return (bOk) ? 0 : 1;
+}
+
+//! \brief Handler of -bench-timers' timers; checks they fire on time, once, and only if not cancelled.
+class CTimerCheck
+{
+protected:
+	enum
+	{
+		TS_Pending,	//!< Timer is yet to fire.
+		TS_Cancelled,	//!< Timer was cancelled.
+		TS_Fired	//!< Timer fired.
+	};
+
+	CTimingWheel<CTimerCheck> wheel;	//!< Wheel under test.
+	std::vector<uint64> dues;	//!< Ticks timers are due at, by id.
+	std::vector<uint32> handles;	//!< Handles of timers, by id.
+	std::vector<uint8> states;	//!< TS_ states of timers, by id.
+	uint64 from;	//!< Tick the last Advance() started from.
+	uint64 now;	//!< Tick the wheel was advanced to.
+	uint64 current;	//!< Tick the wheel is at - of the timer firing, in OnEvent().
+	uint32 pending;	//!< Timers yet to fire.
+	uint32 fired;	//!< Timers that fired.
+	uint32 errors;	//!< Timers that fired off time, twice or cancelled, and wrong counts and wait times.
+	uint32 random;	//!< State of Random() for timers started by OnEvent().
+
+public:
+	//! Default c-tor.
+	CTimerCheck():wheel(0), from(0), now(0), current(0), pending(0), fired(0), errors(0), random(7){}
+
+	//! \brief Starts a timer due at tick due; one that's gone by is due on the next tick.
+	//! \return Returns id of the timer.
+	uint32 Start(uint64 due)
+	{
+		uint32 id = (uint32)dues.size();
+		dues.push_back((due > current) ? due : current + 1);
+		states.push_back(TS_Pending);
+		handles.push_back(wheel.Schedule(due, this, id));
+		++pending;
+		return id;
+	}
+
+	//! \brief Cancels timer id, whatever state it's in; a stale handle mustn't cancel anything.
+	void Cancel(uint32 id)
+	{
+		uint32 count = wheel.GetCount();
+		wheel.Cancel(handles[id]);
+		if(states[id] == TS_Pending)
+		{
+			states[id] = TS_Cancelled;
+			--pending;
+			errors += (wheel.GetCount() != count - 1);
+		}
+		else
+		{
+			errors += (wheel.GetCount() != count);
+		}
+	}
+
+	//! \brief Advances the wheel to tick to, and checks its count of timers.
+	void Advance(uint64 to)
+	{
+		from = now;
+		now = to;
+		wheel.Advance(to);
+		current = to;
+		errors += (wheel.GetCount() != pending);
+	}
+
+	//! \brief Checks GetWaitTime() doesn't sleep past the earliest timer; scans all of them.
+	void CheckWaitTime()
+	{
+		uint64 earliest = 0;
+		for(uint32 id = 0 ; id < states.size() ; ++id)
+		{
+			if(states[id] == TS_Pending && (earliest == 0 || dues[id] < earliest))
+			{
+				earliest = dues[id];
+			}
+		}
+		sint32 wait = wheel.GetWaitTime(now);
+		errors += (earliest == 0) ? (wait != -1) : (wait < 0 || now + wait > earliest);
+	}
+
+	//! \brief Called by the wheel when timer id fires.
+	void OnEvent(uint32 id)
+	{
+		if(states[id] != TS_Pending || dues[id] <= from || dues[id] > now)
+		{
+			++errors;
+			return;
+		}
+		states[id] = TS_Fired;
+		--pending;
+		++fired;
+		current = dues[id];
+		if(Random(random) % 8 == 0)
+		{
+			Start(current + Random(random) % 1000);	//handlers may start timers; 0 fires on the next tick
+		}
+	}
+
+	//! \brief Returns count of timers started.
+	uint32 GetStarted() const { return (uint32)states.size(); }
+
+	//! \brief Returns count of timers that fired.
+	uint32 GetFired() const { return fired; }
+
+	//! \brief Returns count of timers yet to fire.
+	uint32 GetPending() const { return pending; }
+
+	//! \brief Returns tick the wheel was advanced to.
+	uint64 GetNow() const { return now; }
+
+	//! \brief Returns count of errors; timers that never fired nor were cancelled count too.
+	uint32 GetErrors() const { return errors + pending; }
+};
+
+//=====================================================
+//Function: BenchTimers()
+//Last Revised: 18.10.2026
+//	Stress tests CTimingWheel against CTimerCheck's bookkeeping.
+//=====================================================
+static int BenchTimers(uint32 timers)
+{
+	uint32 state = 1;
+	uint32 cancels = 0;
+	uint32 maxPending = 0;
+	CTimerCheck check;
+
+	for(uint32 step = 1 ; check.GetStarted() < timers ; ++step)
+	{
+		for(uint32 i = 0 ; i < 16 && check.GetStarted() < timers ; ++i)
+		{
+			//spread over the levels: up to 2^8, 2^16, 2^24 and 2^28 ms ahead
+			uint32 level = Random(state) % TIMER_WHEEL_LEVELS;
+			uint32 range = (level < TIMER_WHEEL_LEVELS - 1) ? 1 << (TIMER_WHEEL_BITS * (level + 1)) : 1 << 28;
+			check.Start(check.GetNow() + (((Random(state) << 8) ^ Random(state)) & (range - 1)));
+		}
+		for(uint32 i = 0 ; i < 4 ; ++i)
+		{
+			check.Cancel(Random(state) % check.GetStarted());	//pending, fired or cancelled already
+			++cancels;
+		}
+		if(check.GetPending() > maxPending)
+		{
+			maxPending = check.GetPending();
+		}
+
+		uint32 ahead = (step % 256 == 0) ? Random(state) % (1 << 20) : 1 + Random(state) % 64;
+		check.Advance(check.GetNow() + ahead);
+		if(step % 4 == 0)
+		{
+			check.CheckWaitTime();
+		}
+	}
+	while(check.GetPending() > 0)
+	{
+		check.Advance(check.GetNow() + (1 << 20));
+		check.CheckWaitTime();
+	}
+
+	printf("%10s %10s %10s %12s %12s\n", "started", "fired", "cancels", "max pending", "ticks [ms]");
+	printf("%10u %10u %10u %12u %12.0f\n", check.GetStarted(), check.GetFired(), cancels, maxPending, (float64)check.GetNow());
+	uint32 errors = check.GetErrors();
+	if(errors > 0)
+	{
+		printf("\ntiming wheel FAILS: %u errors\n", errors);
+		return 1;
+	}
+	printf("\ntiming wheel fires every timer once, on time\n");
+	return 0;
+}
+
+//=====================================================
+//Function: main()
+//Last Revised: 18.10.2026
+//	Replays transcript through VC System and reports.
+//=====================================================
+int main(int argc, char* argv[])
+{
+	if(argc < 2)
+	{
+		fprintf(stderr, "Usage: vcs-replay <transcript> [-interval <ms>] [-repeat <n>] [-realtime] [-early] [-fuzzy]\n"
+			"       vcs-replay -bench-grammar [<phrases>]\n"
+			"       vcs-replay -bench-fuzzy [<phrases>]\n"
+			"       vcs-replay -bench-cache [<phrases>]\n"
+			"       vcs-replay -bench-log [<events>]\n"
+			"       vcs-replay -bench-timers [<timers>]\n");
+		return 1;
+	}
+	if(std::string(argv[1]) == "-bench-grammar")
+	{
+		uint32 maxPhrases = (argc > 2) ? (uint32)atoi(argv[2]) : 50000;
+		return BenchGrammar((maxPhrases > 0) ? maxPhrases : 50000);
+	}
+	if(std::string(argv[1]) == "-bench-fuzzy")
+	{
+		uint32 maxPhrases = (argc > 2) ? (uint32)atoi(argv[2]) : 50000;
+		return BenchFuzzy((maxPhrases > 0) ? maxPhrases : 50000);
+	}
+	if(std::string(argv[1]) == "-bench-cache")
+	{
+		uint32 maxPhrases = (argc > 2) ? (uint32)atoi(argv[2]) : 50000;
+		return BenchCache((maxPhrases > 0) ? maxPhrases : 50000);
+	}
+	if(std::string(argv[1]) == "-bench-log")
+	{
+		uint32 events = (argc > 2) ? (uint32)atoi(argv[2]) : 200000;
+		return BenchLog((events > 0) ? events : 200000);
+	}
+	if(std::string(argv[1]) == "-bench-timers")
+	{
+		uint32 timers = (argc > 2) ? (uint32)atoi(argv[2]) : 100000;
+		return BenchTimers((timers > 0) ? timers : 100000);
+	}
+
+	uint32 interval = 0;
+	uint32 repeat = 1;
+	bool bRealTime = false;
+	bool bEarly = false;
+	bool bFuzzy = false;
+	for(int i = 2 ; i < argc ; ++i)
+	{
+		std::string arg(argv[i]);
+		if(arg == "-interval" && i + 1 < argc)
+		{
+			interval = (uint32)atoi(argv[++i]);
+		}
+		else if(arg == "-repeat" && i + 1 < argc)
+		{
+			repeat = (uint32)atoi(argv[++i]);
+		}
+		else if(arg == "-realtime")
+		{
+			bRealTime = true;
+		}
+		else if(arg == "-early")
+		{
+			bEarly = true;
+		}
+		else if(arg == "-fuzzy")
+		{
+			bFuzzy = true;
+		}
+	}
+
+	new CVCSystem;
+	CVCSystem& vcs = CVCSystem::GetSingleton();
+
+	CPlayer_Stub player;
+	CReplayShim shim(vcs.logger, argv[1], interval, bRealTime, (repeat > 0) ? repeat : 1);
+	shim.SetFuzzy(bFuzzy);
+	vcs.SetRecognizer(&shim);
+	vcs.SetPlayer(&player);
+
+	char8* vcsArgs[] = { argv[0], (char8*)"-quiet", (char8*)"-early" };
+	uint32 vcsArgCount = (bEarly) ? 3 : 2;
+	vcs.Init(vcsArgCount, vcsArgs);
+
+	uint64 start = CLogClock::Now();
+	vcs.Run(vcsArgCount, vcsArgs);
+	uint64 elapsed = CLogClock::Now() - start;
+
+	vcs.DeInit();
+	delete CVCSystem::GetSingletonPtr();
+
+	//---- report
+	std::vector<uint64> all;
+	const std::map<std::string, std::vector<uint64> >& latencies = shim.GetLatencies();
+	for(std::map<std::string, std::vector<uint64> >::const_iterator itor = latencies.begin() ; itor != latencies.end() ; ++itor)
+	{
+		all.insert(all.end(), (*itor).second.begin(), (*itor).second.end());
+	}
+
+	float64 seconds = elapsed / 1e9;
+	printf("vcs-replay: %u commands in %.3f s - %.1f commands/s\n\n", (uint32)all.size(), seconds,
+		(seconds > 0.0) ? all.size() / seconds : 0.0);
+
+	printf("%-24s %8s %10s %10s %10s %10s\n", "command", "count", "p50 [us]", "p90 [us]", "p99 [us]", "max [us]");
+	for(std::map<std::string, std::vector<uint64> >::const_iterator itor = latencies.begin() ; itor != latencies.end() ; ++itor)
+	{
+		PrintLatencies((*itor).first, (*itor).second);
+	}
+	PrintLatencies("(all)", all);
+
+	printf("\nplayer calls:");
+	const std::map<std::string, uint32>& calls = player.GetCalls();
+	for(std::map<std::string, uint32>::const_iterator itor = calls.begin() ; itor != calls.end() ; ++itor)
+	{
+		printf(" %s=%u", (*itor).first.c_str(), (*itor).second);
+	}
+	printf("\n");
+	return 0;
+}
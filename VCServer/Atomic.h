@@ -0,0 +1,122 @@
+#ifndef __TRC_VCS_ATOMIC_H__
+#define __TRC_VCS_ATOMIC_H__
+
+/*!
+\file Atomic.h
+\brief Thin wrappers over platform atomic operations.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	All operations are full memory barriers, except AtomicLoad (acquire)
+	and AtomicStore (release).
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#ifdef WIN32
+	#include <windows.h>
+#endif //WIN32
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! 32-bit value shared between threads; touch it only through functions below.
+		#ifdef WIN32
+			typedef volatile LONG atomic32;
+		#else //WIN32
+			typedef volatile sint32 atomic32;
+		#endif //WIN32
+
+		//! \brief Atomically increments value.
+		//! \return Returns incremented value.
+		inline sint32 AtomicIncrement(atomic32* value)
+		{
+		#ifdef WIN32
+			return InterlockedIncrement(value);
+		#else //WIN32
+			return __sync_add_and_fetch(value, 1);
+		#endif //WIN32
+		}
+
+		//! \brief Atomically decrements value.
+		//! \return Returns decremented value.
+		inline sint32 AtomicDecrement(atomic32* value)
+		{
+		#ifdef WIN32
+			return InterlockedDecrement(value);
+		#else //WIN32
+			return __sync_sub_and_fetch(value, 1);
+		#endif //WIN32
+		}
+
+		//! \brief Atomically adds amount to value.
+		//! \return Returns value *before* the addition.
+		inline sint32 AtomicAdd(atomic32* value, sint32 amount)
+		{
+		#ifdef WIN32
+			return InterlockedExchangeAdd(value, amount);
+		#else //WIN32
+			return __sync_fetch_and_add(value, amount);
+		#endif //WIN32
+		}
+
+		//! \brief Atomically replaces value.
+		//! \return Returns previous value.
+		inline sint32 AtomicExchange(atomic32* value, sint32 exchange)
+		{
+		#ifdef WIN32
+			return InterlockedExchange(value, exchange);
+		#else //WIN32
+			sint32 previous = __sync_lock_test_and_set(value, exchange);	//only an acquire barrier...
+			__sync_synchronize();	//...so make it a full one
+			return previous;
+		#endif //WIN32
+		}
+
+		//! \brief Atomically replaces value with exchange, if value equals comparand.
+		//! \return Returns initial value; exchange happened if it equals comparand.
+		inline sint32 AtomicCompareExchange(atomic32* value, sint32 exchange, sint32 comparand)
+		{
+		#ifdef WIN32
+			return InterlockedCompareExchange(value, exchange, comparand);
+		#else //WIN32
+			return __sync_val_compare_and_swap(value, comparand, exchange);
+		#endif //WIN32
+		}
+
+		//! \brief Reads value with acquire semantics.
+		inline sint32 AtomicLoad(const atomic32* value)
+		{
+		#ifdef WIN32
+			return *value;	//volatile reads have acquire semantics in MS VC++ 2005+
+		#else //WIN32
+			return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+		#endif //WIN32
+		}
+
+		//! \brief Writes value with release semantics.
+		inline void AtomicStore(atomic32* value, sint32 newValue)
+		{
+		#ifdef WIN32
+			*value = newValue;	//volatile writes have release semantics in MS VC++ 2005+
+		#else //WIN32
+			__atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+		#endif //WIN32
+		}
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_ATOMIC_H__
@@ -0,0 +1,218 @@
+#ifndef __TRC_VCS_COMMAND_LATENCY_H__
+#define __TRC_VCS_COMMAND_LATENCY_H__
+
+/*!
+\file CommandLatency.h
+\brief Latency of command path stages, per command.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	A command goes through stages stamped in SCommandTrace:
+		speechEnd	- user stopped talking (engine's estimate);
+		event		- recognition event arrived;
+		decoded		- phrase decoded (SAPI GetPhrase);
+		dispatched	- a module's switch picked the command up;
+		notified	- notification sound started;
+		done		- player call returned, or module moved on.
+	CCommandLatency keeps a CLatencyHistogram per stage, for every command
+	(CMD_*, PLAYLIST_*) of a module; a stage that didn't happen (no sound, no
+	speech timing) is left out and the next stage counts from the previous one
+	that did. LS_Total spans the whole path, speech end (or event) to done.
+
+	Command IDs are only unique within a grammar, so every module has its own
+	CCommandLatency. Recording is lock-free, so Dump() may run on any thread.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include "Atomic.h"
+#include "LatencyHistogram.h"
+#include "Logger.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Stages of command path, measured from the previous one.
+		enum E_LatencyStage
+		{
+			LS_Recognition = 0,	//!< Speech end -> recognition event.
+			LS_Decode,	//!< Event -> phrase decoded.
+			LS_Dispatch,	//!< Decoded -> picked up by a module.
+			LS_Notify,	//!< Dispatched -> notification sound started.
+			LS_Action,	//!< -> player call returned.
+			LS_Total,	//!< Speech end -> player call returned.
+			LS_MaxStages	//!< Count of stages
+		};
+
+		//! \brief Timestamps of a command going through VC System; CLogClock::Now() units, 0 if stage didn't happen.
+		struct SCommandTrace
+		{
+			uint64 speechEnd;
+			uint64 event;
+			uint64 decoded;
+			uint64 dispatched;
+			uint64 notified;
+			uint64 done;
+
+			SCommandTrace(){ Clear(); }
+
+			void Clear(){ speechEnd = event = decoded = dispatched = notified = done = 0; }
+		};
+
+		//! \brief Returns name of latency stage.
+		inline const char8* GetLatencyStageName(E_LatencyStage stage)
+		{
+			static const char8* names[LS_MaxStages] = { "recognition", "decode", "dispatch", "notify", "action", "total" };
+			return (stage < LS_MaxStages) ? names[stage] : "?";
+		}
+
+		//! \brief Per-command latency histograms of a module.
+		class CCommandLatency
+		{
+		public:
+			enum
+			{
+				MAX_COMMANDS = 32	//!< Distinct commands tracked; later ones aren't.
+			};
+
+		protected:
+			//! \brief Histograms of a command.
+			struct SCommand
+			{
+				atomic32 id;	//!< Command ID + 1; 0 if slot's free.
+				CLatencyHistogram stages[LS_MaxStages];	//!< Latency by stage.
+			};
+
+			const char8* name;	//!< Module name, for reports.
+			SCommand* commands;	//!< MAX_COMMANDS slots, claimed in order.
+
+			//! \brief Returns slot of command, claiming a free one if needed.
+			//! \return Returns NULL if all slots are taken.
+			SCommand* Find(uint32 id)
+			{
+				for(uint32 i = 0 ; i < MAX_COMMANDS ; ++i)
+				{
+					sint32 current = AtomicLoad(&commands[i].id);
+					if(current == 0)
+					{
+						current = AtomicCompareExchange(&commands[i].id, (sint32)(id + 1), 0);
+						if(current == 0)
+						{
+							return &commands[i];
+						}
+					}
+					if((uint32)current == id + 1)
+					{
+						return &commands[i];
+					}
+				}
+				return NULL;
+			}
+
+			//! \brief Records a stage, if both ends happened.
+			static void RecordStage(SCommand& command, E_LatencyStage stage, uint64 from, uint64 to)
+			{
+				if(from != 0 && to >= from)
+				{
+					uint64 us = (to - from) / 1000;
+					command.stages[stage].Record((us < 0xFFFFFFFF) ? (uint32)us : 0xFFFFFFFF);
+				}
+			}
+
+		private:
+			CCommandLatency(const CCommandLatency&);
+			CCommandLatency& operator=(const CCommandLatency&);
+
+		public:
+			//! \brief C-tor.
+			//! \param _name: Module name, for reports; must outlive the object.
+			CCommandLatency(const char8* _name):name(_name)
+			{
+				commands = new SCommand[MAX_COMMANDS];
+				for(uint32 i = 0 ; i < MAX_COMMANDS ; ++i)
+				{
+					commands[i].id = 0;
+				}
+			}
+
+			~CCommandLatency(){ delete [] commands; }	//!< D-tor.
+
+			//! \brief Records a finished command.
+			//! \param id: Command ID (result value).
+			//! \param trace: Command's timestamps; done must be set.
+			void Record(uint32 id, const SCommandTrace& trace)
+			{
+				SCommand* command = Find(id);
+				if(command == NULL || trace.done == 0)
+				{
+					return;
+				}
+
+				RecordStage(*command, LS_Recognition, (trace.speechEnd <= trace.event) ? trace.speechEnd : 0, trace.event);
+				RecordStage(*command, LS_Decode, trace.event, trace.decoded);
+				uint64 last = (trace.decoded != 0) ? trace.decoded : trace.event;
+				RecordStage(*command, LS_Dispatch, last, trace.dispatched);
+				last = (trace.dispatched != 0) ? trace.dispatched : last;
+				RecordStage(*command, LS_Notify, last, trace.notified);
+				last = (trace.notified != 0) ? trace.notified : last;
+				RecordStage(*command, LS_Action, last, trace.done);
+				uint64 first = (trace.speechEnd != 0 && trace.speechEnd <= trace.event) ? trace.speechEnd : trace.event;
+				RecordStage(*command, LS_Total, first, trace.done);
+			}
+
+			//! \brief Returns histogram of a command's stage.
+			//! \return Returns NULL if command wasn't recorded.
+			const CLatencyHistogram* GetHistogram(uint32 id, E_LatencyStage stage) const
+			{
+				for(uint32 i = 0 ; i < MAX_COMMANDS ; ++i)
+				{
+					if((uint32)AtomicLoad(&commands[i].id) == id + 1)
+					{
+						return &commands[i].stages[stage];
+					}
+				}
+				return NULL;
+			}
+
+			//! \brief Logs percentiles of every recorded command and stage.
+			void Dump(CLogger& logger) const
+			{
+				for(uint32 i = 0 ; i < MAX_COMMANDS ; ++i)
+				{
+					sint32 id = AtomicLoad(&commands[i].id);
+					if(id == 0)
+					{
+						continue;
+					}
+					for(uint32 stage = 0 ; stage < LS_MaxStages ; ++stage)
+					{
+						const CLatencyHistogram& histogram = commands[i].stages[stage];
+						if(histogram.GetCount() > 0)
+						{
+							VCS_LOGF_INFO(logger, DumpFormat(), name, id - 1, GetLatencyStageName((E_LatencyStage)stage), histogram.GetCount(),
+								histogram.GetPercentile(50), histogram.GetPercentile(90), histogram.GetPercentile(99), histogram.GetMax());
+						}
+					}
+				}
+			}
+
+			//! \brief Format of Dump() lines; exempt it from log rate limits.
+			static const char8* DumpFormat(){ return "Latency %s/%u %-11s n=%u p50=%u p90=%u p99=%u max=%u [us]"; }
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_COMMAND_LATENCY_H__
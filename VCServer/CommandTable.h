@@ -0,0 +1,120 @@
+#ifndef __TRC_VCS_COMMAND_TABLE_H__
+#define __TRC_VCS_COMMAND_TABLE_H__
+
+/*!
+\file CommandTable.h
+\brief Table mapping recognized commands to module handlers.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	A module lists its commands as static const rows (rule, value, handler),
+	expanded from its grammar's X-macro list (see Commands.h), so they're
+	built by the compiler. CCommandTable indexes the rows once, by rule slot
+	and value, and then finds a handler in two array reads.
+
+	Values of a grammar's commands are unique too, so a deep command - a whole
+	path through menus said at once, matched by a rule that references the
+	menus' rules - is found by its value alone (FindByValue()).
+
+	Rule IDs and values must be below COMMAND_MAX_ID; Commands.h checks that,
+	and collisions, at compile time.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <vector>
+
+#include "Recognizer.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			COMMAND_MAX_ID = 256	//!< Rule IDs and values are below that.
+		};
+
+		//! \brief Handlers of module T, by rule and value.
+		template<typename T>
+		class CCommandTable
+		{
+		public:
+			typedef void (T::*handler_t)(const SRecoResult& result);	//!< Type of command handler.
+
+			//! \brief Command; rows are meant to be a static const array.
+			struct SRow
+			{
+				uint32 rule;	//!< ID of rule.
+				uint32 value;	//!< Value of rule's phrase.
+				handler_t handler;	//!< Called when phrase is recognized.
+			};
+
+		protected:
+			uint8 ruleSlots[COMMAND_MAX_ID];	//!< Slot of rule in handlers + 1; 0 if rule has no commands.
+			std::vector<handler_t> handlers;	//!< COMMAND_MAX_ID handlers per rule slot; NULL if value has none.
+			handler_t valueHandlers[COMMAND_MAX_ID];	//!< Handlers by value alone.
+
+		private:
+			CCommandTable(const CCommandTable&);
+			CCommandTable& operator=(const CCommandTable&);
+
+		public:
+			//! \brief C-tor; indexes rows.
+			//! \param rows: Commands; IDs checked by Commands.h.
+			//! \param count: Count of rows.
+			CCommandTable(const SRow* rows, uint32 count)
+			{
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					ruleSlots[i] = 0;
+					valueHandlers[i] = NULL;
+				}
+				uint32 slots = 0;
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					if(ruleSlots[rows[i].rule] == 0)
+					{
+						ruleSlots[rows[i].rule] = (uint8)++slots;
+					}
+				}
+				handlers.resize(slots * COMMAND_MAX_ID, NULL);
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					handlers[(ruleSlots[rows[i].rule] - 1) * COMMAND_MAX_ID + rows[i].value] = rows[i].handler;
+					valueHandlers[rows[i].value] = rows[i].handler;
+				}
+			}
+
+			//! \brief Returns handler of command, or NULL if there's none.
+			handler_t Find(uint32 rule, uint32 value) const
+			{
+				if(rule >= COMMAND_MAX_ID || value >= COMMAND_MAX_ID || ruleSlots[rule] == 0)
+				{
+					return NULL;
+				}
+				return handlers[(ruleSlots[rule] - 1) * COMMAND_MAX_ID + value];
+			}
+
+			//! \brief Returns handler of command with value in any rule, or NULL if there's none.
+			handler_t FindByValue(uint32 value) const
+			{
+				return (value < COMMAND_MAX_ID) ? valueHandlers[value] : NULL;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_COMMAND_TABLE_H__
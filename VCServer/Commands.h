@@ -0,0 +1,119 @@
+#ifndef __TRC_VCS_COMMANDS_H__
+#define __TRC_VCS_COMMANDS_H__
+
+/*!
+\file Commands.h
+\brief IDs of all grammars, and compile-time checks of them.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Every grammar has an X-macro header in grammar/ listing its rules, its
+	property values and its commands - X(rule, value, handler) rows. IDs
+	become enums here; modules expand commands into CCommandTable rows.
+	To add a command, add its phrase to the grammar XML, its value and
+	row to the grammar header, and write the handler.
+
+	CheckCommandIds() is never called; it just doesn't compile (duplicate
+	case value) if:
+		- two grammars use the same rule ID - a result's rule tells its grammar;
+		- two IDs of a grammar are the same;
+		- a command is listed twice, or two commands share a value - deep
+		  commands are found by value; same for early commands;
+		- a rule has two confidence thresholds, or one over 100%;
+	or (static assertion) if an ID doesn't fit in COMMAND_MAX_ID.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <boost/static_assert.hpp>
+
+#include "CommandTable.h"
+
+#include "grammar/grammar.h"
+#include "grammar/winamp.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		#define VCS_ID_ENUM(name, value) name = value,
+		#define VCS_ID_CASE(name, value) case name: BOOST_STATIC_ASSERT((uint32)name < COMMAND_MAX_ID); break;
+		#define VCS_COMMAND_CASE(rule, value, handler) case value: break;
+		#define VCS_CONFIDENCE_CASE(rule, percent) case rule: BOOST_STATIC_ASSERT(percent <= 100); break;
+
+		//! \brief IDs of core grammar.
+		enum E_CoreIds
+		{
+			VCS_CORE_RULES(VCS_ID_ENUM)
+			VCS_CORE_VALUES(VCS_ID_ENUM)
+			CORE_IDS_END
+		};
+
+		//! \brief IDs of WinAMP grammar.
+		enum E_WinAMPIds
+		{
+			VCS_WINAMP_RULES(VCS_ID_ENUM)
+			VCS_WINAMP_VALUES(VCS_ID_ENUM)
+			WINAMP_IDS_END
+		};
+
+		//! \brief Compile-time check of grammar IDs; never called.
+		inline void CheckCommandIds(uint32 id)
+		{
+			switch(id)
+			{
+				VCS_CORE_RULES(VCS_ID_CASE)
+				VCS_WINAMP_RULES(VCS_ID_CASE)
+			}
+			switch(id)
+			{
+				VCS_CORE_RULES(VCS_ID_CASE)
+				VCS_CORE_VALUES(VCS_ID_CASE)
+			}
+			switch(id)
+			{
+				VCS_WINAMP_RULES(VCS_ID_CASE)
+				VCS_WINAMP_VALUES(VCS_ID_CASE)
+			}
+			switch(id)
+			{
+				VCS_CORE_COMMANDS(VCS_COMMAND_CASE)
+			}
+			switch(id)
+			{
+				VCS_WINAMP_COMMANDS(VCS_COMMAND_CASE)
+			}
+			switch(id)
+			{
+				VCS_WINAMP_EARLY(VCS_COMMAND_CASE)
+			}
+			switch(id)
+			{
+				VCS_CORE_CONFIDENCE(VCS_CONFIDENCE_CASE)
+				VCS_WINAMP_CONFIDENCE(VCS_CONFIDENCE_CASE)
+			}
+		}
+
+		#undef VCS_ID_ENUM
+		#undef VCS_ID_CASE
+		#undef VCS_COMMAND_CASE
+		#undef VCS_CONFIDENCE_CASE
+
+		//! \brief Expands a grammar's X(rule, value, handler) into a CCommandTable<T>::SRow of module T.
+		#define VCS_COMMAND_ROW(T, rule, value, handler) { rule, value, &T::handler },
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_COMMANDS_H__
@@ -1,31 +1,61 @@
-#ifndef __TRC_VCS_DEFINES_H__
-#define __TRC_VCS_DEFINES_H__
-
-/*!
-\file Defines.h
-\brief Base definitions
-
-Project:	TRC Voice Control Server
-
-
-Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
-
-Created: 29.11.2006
-Last Revised:	29.11.2006
-
-Implementation File: none
-
-Notes:
-
-*/
-
-/*
-	This header contains some preprocessor definitions.
-	Should be included by all .h`s and .cpp`s .
-*/
-
-//! Exclude rarely used Win32 stuff...
-//#define WIN32_LEAN_AND_MEAN
-
-
+#ifndef __TRC_VCS_DEFINES_H__
+#define __TRC_VCS_DEFINES_H__
+
+/*!
+\file Defines.h
+\brief Base definitions
+
+Project:	TRC Voice Control Server
+
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 29.11.2006
+Last Revised:	18.10.2026
+
+Implementation File: none
+
+Notes:
+
+*/
+
+/*
+	This header contains some preprocessor definitions.
+	Should be included by all .h`s and .cpp`s .
+*/
+
+//! Exclude rarely used Win32 stuff...
+//#define WIN32_LEAN_AND_MEAN
+
+//! Storage class for per-thread variables; use only with POD types.
+#ifdef _MSC_VER
+	#define VCS_THREAD_LOCAL __declspec(thread)
+#else //_MSC_VER
+	#define VCS_THREAD_LOCAL __thread
+#endif //_MSC_VER
+
+//! Lowest severity of log messages compiled into the binary:
+//! 0 - debug, 1 - info, 2 - success, 3 - warning, 4 - error. Fatal messages are always kept.
+//! VCS_LOG_* calls (see Logger.h) below this level compile to nothing, arguments included.
+#ifndef VCS_LOG_MIN_LEVEL
+	#define VCS_LOG_MIN_LEVEL 0
+#endif //VCS_LOG_MIN_LEVEL
+
+//! Non-zero makes VCS log into vcs.blog in binary format (see LogOutput_BinaryFile.h),
+//! instead of vcs.log text. Use LogDecoder to read it.
+#ifndef VCS_LOG_BINARY
+	#define VCS_LOG_BINARY 0
+#endif //VCS_LOG_BINARY
+
+//! Non-zero makes CFuzzyMatcher (see FuzzyMatcher.h) work out edit distances with SSE2,
+//! 16 phrases at a time; on by default for x86 and x64 - define it 0 for CPUs older than Pentium 4.
+#ifndef VCS_FUZZY_SSE2
+	#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+		#define VCS_FUZZY_SSE2 1
+	#else
+		#define VCS_FUZZY_SSE2 0
+	#endif
+#endif //VCS_FUZZY_SSE2
+
+
 #endif //__TRC_VCS_DEFINES_H__
\ No newline at end of file
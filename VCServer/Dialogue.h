@@ -0,0 +1,185 @@
+#ifndef __TRC_VCS_DIALOGUE_H__
+#define __TRC_VCS_DIALOGUE_H__
+
+/*!
+\file Dialogue.h
+\brief Voice menus written as sequential code that never blocks.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	A dialogue is a stackless coroutine: its body is a function that returns
+	whenever it waits for the next utterance, and is called again - resumed
+	right after that wait - when one comes, or the wait times out:
+
+		void CModule::Menu(CDialogue& dialogue, E_RecoStatus status, const SRecoResult& result)
+		{
+			VCS_DIALOGUE_BEGIN(dialogue)
+				VCS_DIALOGUE_AWAIT(dialogue, NextUtterance(timeout, MODE_Menu));
+				if(status == RS_Recognized)
+				{
+					...
+				}
+			VCS_DIALOGUE_END(dialogue)
+		}
+
+	status and result are what the last wait ended with. It's the switch and
+	__LINE__ trick of boost::asio::coroutine: locals don't survive a wait (the
+	compiler won't let a wait jump over their initialization), so state lives
+	in members; two waits can't share a line, and __LINE__ must be a constant -
+	no /ZI (Edit and Continue) builds.
+
+	VC System runs dialogues (CVCSystem::StartDialogue()): it keeps the rules
+	dialogues wait for active, hands every result to the dialogue waiting for
+	its rule, and times waits out - or ends Delay()s - on its reactor's timers;
+	a LISTEN_ADAPTIVE wait lasts as long as the user tends to take to answer
+	(CListenTimes). Nothing is parked meanwhile, so any number of dialogues may
+	be going on at once; stopping one just forgets where it was.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include "Recognizer.h"
+
+//! \brief Starts body of dialogue d.
+#define VCS_DIALOGUE_BEGIN(d) switch((d).resumePoint) { case 0:
+
+//! \brief Makes dialogue d wait, as told by call (d's NextUtterance()), and returns; execution goes on from here when it's resumed.
+#define VCS_DIALOGUE_AWAIT(d, call) do { (d).call; (d).resumePoint = __LINE__; return; case __LINE__:; } while(0)
+
+//! \brief Ends dialogue d right away.
+#define VCS_DIALOGUE_EXIT(d) do { (d).Stop(); return; } while(0)
+
+//! \brief Ends body of dialogue d.
+#define VCS_DIALOGUE_END(d) } (d).Stop();
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			LISTEN_ADAPTIVE = 0xFFFFFFFE	//!< Timeout of CDialogue::NextUtterance() fitted to the user; see ListenTimes.h.
+		};
+
+		//! \brief State of a dialogue, and what it waits for.
+		class CDialogue
+		{
+		public:
+			enum
+			{
+				DIALOGUE_STOPPED = -1,	//!< resumePoint of a dialogue that's not running.
+				MAX_AWAIT_RULES = 2	//!< Max count of rules waited for at once.
+			};
+
+			sint32 resumePoint;	//!< Where body goes on; 0 - from start. For VCS_DIALOGUE_* only.
+
+		protected:
+			uint32 rules[MAX_AWAIT_RULES];	//!< Rules waited for; 0 if slot's unused.
+			uint32 timeout;	//!< Max time [ms] to wait for them, or RECO_INFINITE.
+
+			//! \brief Stops waiting.
+			void ClearAwait()
+			{
+				for(uint32 i = 0 ; i < MAX_AWAIT_RULES ; ++i)
+				{
+					rules[i] = 0;
+				}
+				timeout = RECO_INFINITE;
+			}
+
+		public:
+			CDialogue():resumePoint(DIALOGUE_STOPPED){ ClearAwait(); }	//!< Default c-tor.
+			virtual ~CDialogue(){}	//!< Virtual d-tor.
+
+			//! \brief Makes body run from start on the next Resume().
+			void Start(){ resumePoint = 0; ClearAwait(); }
+
+			//! \brief Ends dialogue; it won't be resumed anymore.
+			void Stop(){ resumePoint = DIALOGUE_STOPPED; ClearAwait(); }
+
+			//! \brief Checks if dialogue was started and didn't end yet.
+			bool IsRunning() const { return resumePoint != DIALOGUE_STOPPED; }
+
+			//! \brief Waits for a command of rule (or otherRule); use with VCS_DIALOGUE_AWAIT.
+			//! \param _timeout: Max time to wait [ms], RECO_INFINITE, or LISTEN_ADAPTIVE - as long as the user usually takes to answer rule.
+			//! \param rule: Rule ID, of any grammar.
+			//! \param otherRule: Another rule ID; 0 if none.
+			void NextUtterance(uint32 _timeout, uint32 rule, uint32 otherRule = 0)
+			{
+				ClearAwait();
+				rules[0] = rule;
+				rules[1] = otherRule;
+				timeout = _timeout;
+			}
+
+			//! \brief Waits for nothing but time; use with VCS_DIALOGUE_AWAIT. Resumed with RS_Timeout.
+			//! \param ms: Time to wait [ms].
+			void Delay(uint32 ms)
+			{
+				ClearAwait();
+				timeout = ms;
+			}
+
+			//! \brief Returns i-th rule waited for; 0 if none.
+			uint32 GetRule(uint32 i) const { return (i < MAX_AWAIT_RULES) ? rules[i] : 0; }
+
+			//! \brief Checks if dialogue waits for rule.
+			bool Awaits(uint32 rule) const
+			{
+				for(uint32 i = 0 ; i < MAX_AWAIT_RULES ; ++i)
+				{
+					if(rules[i] != 0 && rules[i] == rule)
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+
+			//! \brief Returns max time [ms] to wait, RECO_INFINITE, or LISTEN_ADAPTIVE.
+			uint32 GetTimeout() const { return timeout; }
+
+			//! \brief Runs body till it waits again or ends.
+			//! \param status: How the wait ended; RS_Pending on start.
+			//! \param result: Command recognized, if status is RS_Recognized.
+			virtual void Resume(E_RecoStatus status, const SRecoResult& result) = 0;
+		};
+
+		//! \brief Dialogue with body in a member function of T.
+		template<typename T>
+		class CMemberDialogue : public CDialogue
+		{
+		public:
+			typedef void (T::*body_t)(CDialogue& dialogue, E_RecoStatus status, const SRecoResult& result);	//!< Type of dialogue body.
+
+		protected:
+			T* owner;	//!< Object body is called on.
+			body_t body;	//!< Body of dialogue.
+
+		public:
+			CMemberDialogue():owner(NULL), body(NULL){}	//!< Default c-tor.
+
+			//! \brief Sets body of dialogue; call before it's started.
+			void Bind(T* _owner, body_t _body){ owner = _owner; body = _body; }
+
+			virtual void Resume(E_RecoStatus status, const SRecoResult& result)
+			{
+				(owner->*body)(*this, status, result);
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_DIALOGUE_H__
@@ -0,0 +1,250 @@
+#ifndef __TRC_VCS_EARLY_EXECUTION_H__
+#define __TRC_VCS_EARLY_EXECUTION_H__
+
+/*!
+\file EarlyExecution.h
+\brief Acting on recognition hypotheses before the final result.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	The engine knows "next" was said well before it's sure nothing follows -
+	the final result waits out a stretch of silence. With -early, VC System
+	runs a command on a hypothesis already, if:
+		- the command can be undone (grammar/winamp.h lists those, with undo
+		  handlers);
+		- a dialogue waits for its rule;
+		- the hypothesis is stable: it's a whole phrase of that rule, and every
+		  phrase of every active rule that starts with its words means the same
+		  command - "volume" isn't, as long as "volume half" may still come.
+	Grammar files are read with CGrammarXML to know that.
+
+	One command per utterance runs early. The next final result settles it:
+	the same command - it's done, and the final result is dropped; anything
+	else - the early command is undone and the final one runs instead. No final
+	result within EARLY_CONFIRM_TIME undoes it too.
+
+	Per command, CEarlyExecution counts how many ran early and how many were
+	undone, and how much sooner than the final result they ran (Dump()).
+	Dump() may run on another thread than the one running commands (Ctrl+Break
+	in main.cpp): counts are atomic, and the stats map is guarded by a mutex.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <ctype.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "Atomic.h"
+
+#include "GrammarXML.h"
+#include "GrammarCache.h"
+#include "LatencyHistogram.h"
+#include "LogClock.h"
+#include "Logger.h"
+#include "Recognizer.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Decides which hypotheses to act on, and keeps track of commands run early.
+		class CEarlyExecution : private boost::noncopyable
+		{
+		protected:
+			//! \brief Stats of a command.
+			struct SStats
+			{
+				uint32 rule;	//!< Rule of command.
+				uint32 value;	//!< Value of command.
+				atomic32 early;	//!< Times it ran early.
+				atomic32 undone;	//!< Times it was undone.
+				CLatencyHistogram saved;	//!< How much sooner than the final result it ran [us].
+			};
+			typedef std::map<uint32, std::vector<SGrammarPhrase> > ruleMap_t;	//!< Type of phrases, by rule.
+			typedef std::map<uint32, SStats*> statsMap_t;	//!< Type of stats, by rule and value.
+
+			ruleMap_t rules;	//!< Phrases of all grammars, by rule.
+			statsMap_t stats;	//!< Stats of commands that ran early; stats themselves never move, so they're used unlocked.
+			mutable boost::mutex statsMutex;	//!< Guards stats.
+			SRecoResult pending;	//!< Hypothesis acted on, waiting for its final result.
+			bool bPending;	//!< Is there one?
+			uint64 executed;	//!< CLogClock::Now() when it ran.
+
+			//! \brief Returns stats of command, creating them if needed.
+			SStats& GetStats(uint32 rule, uint32 value)
+			{
+				uint32 key = (rule << 16) | value;
+				boost::mutex::scoped_lock lock(statsMutex);
+				statsMap_t::iterator itor = stats.find(key);
+				if(itor == stats.end())
+				{
+					SStats* command = new SStats;
+					command->rule = rule;
+					command->value = value;
+					command->early = 0;
+					command->undone = 0;
+					itor = stats.insert(statsMap_t::value_type(key, command)).first;
+				}
+				return *(*itor).second;
+			}
+
+			//! \brief Splits text into lowercase words.
+			static void Split(const std::string& text, std::vector<std::string>& words)
+			{
+				std::string word;
+				for(size_t i = 0 ; i <= text.size() ; ++i)
+				{
+					if(i == text.size() || isspace((uint8)text[i]))
+					{
+						if(!word.empty())
+						{
+							words.push_back(word);
+							word.clear();
+						}
+					}
+					else
+					{
+						word += (char8)tolower((uint8)text[i]);
+					}
+				}
+			}
+
+		public:
+			CEarlyExecution():bPending(false), executed(0){}	//!< Default c-tor.
+
+			//! \brief D-tor.
+			~CEarlyExecution()
+			{
+				for(statsMap_t::iterator itor = stats.begin() ; itor != stats.end() ; ++itor)
+				{
+					delete (*itor).second;
+				}
+			}
+
+			//! \brief Reads phrases of a grammar file, from its cache if it's fresh.
+			//! \param error: Receives what's wrong, on failure.
+			//! \return Returns false if grammar can't be read.
+			bool AddGrammar(const std::string& fileName, std::string& error)
+			{
+				SGrammar grammar;
+				bool bCached, bStored;
+				if(!CGrammarCache::LoadGrammar(fileName, grammar, error, bCached, bStored))
+				{
+					return false;
+				}
+				for(std::vector<SGrammarRule>::const_iterator rule = grammar.rules.begin() ; rule != grammar.rules.end() ; ++rule)
+				{
+					rules[(*rule).id] = (*rule).phrases;
+				}
+				return true;
+			}
+
+			//! \brief Checks if hypothesis can't turn out to be another command of activeRules.
+			bool IsStable(const SRecoResult& hypothesis, const std::vector<uint32>& activeRules) const
+			{
+				std::vector<std::string> words;
+				Split(hypothesis.text, words);
+				if(words.empty())
+				{
+					return false;
+				}
+
+				bool bWhole = false;
+				for(std::vector<uint32>::const_iterator rule = activeRules.begin() ; rule != activeRules.end() ; ++rule)
+				{
+					ruleMap_t::const_iterator phrases = rules.find(*rule);
+					if(phrases == rules.end())
+					{
+						return false;	//don't know what it may still become
+					}
+					for(std::vector<SGrammarPhrase>::const_iterator phrase = (*phrases).second.begin() ; phrase != (*phrases).second.end() ; ++phrase)
+					{
+						if((*phrase).words.size() < words.size() || !std::equal(words.begin(), words.end(), (*phrase).words.begin()))
+						{
+							continue;
+						}
+						if(*rule != hypothesis.ruleId || (*phrase).value != hypothesis.value)
+						{
+							return false;
+						}
+						bWhole = bWhole || ((*phrase).words.size() == words.size());
+					}
+				}
+				return bWhole;
+			}
+
+			//! \brief Notes that hypothesis is acted on; call as its command runs.
+			void Start(const SRecoResult& hypothesis)
+			{
+				pending = hypothesis;
+				bPending = true;
+				executed = CLogClock::Now();
+				AtomicIncrement(&GetStats(hypothesis.ruleId, hypothesis.value).early);
+			}
+
+			//! \brief Checks if a command that ran early waits for its final result.
+			bool IsPending() const { return bPending; }
+
+			//! \brief Returns hypothesis that was acted on; valid while IsPending().
+			const SRecoResult& GetPending() const { return pending; }
+
+			//! \brief Settles pending command with the final result.
+			//! \return Returns true if result is the same command; false if it has to be undone.
+			bool Confirm(const SRecoResult& result)
+			{
+				bPending = false;
+				SStats& command = GetStats(pending.ruleId, pending.value);
+				if(result.ruleId != pending.ruleId || result.value != pending.value)
+				{
+					AtomicIncrement(&command.undone);
+					return false;
+				}
+				uint64 us = (result.recognized > executed) ? (result.recognized - executed) / 1000 : 0;
+				command.saved.Record((us < 0xFFFFFFFF) ? (uint32)us : 0xFFFFFFFF);
+				return true;
+			}
+
+			//! \brief Gives up on pending command's final result; it has to be undone.
+			void Abandon()
+			{
+				bPending = false;
+				AtomicIncrement(&GetStats(pending.ruleId, pending.value).undone);
+			}
+
+			//! \brief Logs stats of every command that ran early; safe to call from any thread.
+			void Dump(CLogger& logger) const
+			{
+				boost::mutex::scoped_lock lock(statsMutex);
+				for(statsMap_t::const_iterator itor = stats.begin() ; itor != stats.end() ; ++itor)
+				{
+					const SStats& command = *(*itor).second;
+					VCS_LOGF_INFO(logger, DumpFormat(), command.rule, command.value, (uint32)AtomicLoad(&command.early), (uint32)AtomicLoad(&command.undone),
+						command.saved.GetPercentile(50), command.saved.GetPercentile(90), command.saved.GetMax());
+				}
+			}
+
+			//! \brief Format of Dump() lines; exempt it from log rate limits.
+			static const char8* DumpFormat(){ return "Early %u/%u ran=%u undone=%u saved p50=%u p90=%u max=%u [us]"; }
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_EARLY_EXECUTION_H__
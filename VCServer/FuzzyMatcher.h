@@ -0,0 +1,436 @@
+#ifndef __TRC_VCS_FUZZY_MATCHER_H__
+#define __TRC_VCS_FUZZY_MATCHER_H__
+
+/*!
+\file FuzzyMatcher.h
+\brief Nearest phrase of the grammars to a text, by edit distance.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	A recognizer that isn't driven by our grammars (dictation, another engine,
+	a typed transcript like grammar/cmds.txt) gives text that's almost, but not
+	quite, a phrase: "nex", "volume louder please". CFuzzyMatcher maps such text
+	to the phrases of active rules nearest to it, by Levenshtein distance of
+	the two texts after Fold() - lowercase, letters and digits only, a
+	rough phonetic spelling (c -> k, z -> s, ph -> f) and no doubled letters, so
+	"shuffel" and "shufle" are both "shufel". A phrase is a match if it's at
+	most FUZZY_MAX_ERROR percent off; its similarity, 1 - distance / length,
+	is what the recognizer reports as confidence, and the runners-up are the
+	result's alternates (so CRescorer gets to weigh them).
+
+	One Find() compares the text with every phrase at once: phrases are sorted
+	by length and packed in blocks of FUZZY_LANES, stored a column at a time -
+	the j-th letters of a block's phrases side by side - so the dynamic
+	programming tables of 16 phrases are filled at once, a few SSE2
+	instructions per cell (VCS_FUZZY_SSE2; distances are bytes, as texts are
+	cut to FUZZY_MAX_LENGTH letters). Blocks of phrases too much shorter or
+	longer than the text to be a match are skipped; sorting puts those at the
+	ends.
+
+	Both kernels - SSE2 and scalar, one phrase at a time - are there; Find()
+	uses the first one there is, and vcs-replay -bench-fuzzy times them
+	against each other.
+
+	Like CGrammarMatcher: Add() grammars, Compile(), and to add another,
+	Clear() and add them all again.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <string.h>
+
+#if VCS_FUZZY_SSE2
+	#include <emmintrin.h>
+#endif //VCS_FUZZY_SSE2
+
+#include <boost/noncopyable.hpp>
+
+#include "GrammarXML.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			FUZZY_LANES = 16,	//!< Phrases compared at once.
+			FUZZY_MAX_LENGTH = 64,	//!< Letters of a text compared; the rest are ignored.
+			FUZZY_MAX_ERROR = 35	//!< Max distance of a match, in percent of the longer text's length.
+		};
+
+		//! \brief Phrase nearest to a text.
+		struct SFuzzyMatch
+		{
+			uint32 grammar;	//!< Grammar index, as given to CFuzzyMatcher::Add().
+			uint32 rule;	//!< Index of the rule in SGrammar::rules.
+			uint32 ruleId;	//!< Rule ID.
+			uint32 value;	//!< Value of the phrase.
+			std::string text;	//!< The phrase.
+			uint32 distance;	//!< Edit distance of folded texts.
+			float32 similarity;	//!< 1 - distance / length of the longer one.
+		};
+
+		//! \brief Finds phrases of grammars nearest to texts.
+		class CFuzzyMatcher : private boost::noncopyable
+		{
+		public:
+			//! \brief How distances are worked out.
+			enum E_FuzzyKernel
+			{
+				FK_Scalar = 0,	//!< A phrase at a time.
+				FK_SSE2	//!< FUZZY_LANES phrases at a time; VCS_FUZZY_SSE2 only.
+			};
+
+		protected:
+			//! \brief Phrase to compare with.
+			struct SPhrase
+			{
+				uint32 grammar;	//!< Grammar index.
+				uint32 rule;	//!< Index of rule.
+				uint32 ruleId;	//!< Rule ID.
+				uint32 value;	//!< Value of phrase.
+				std::string text;	//!< Words joined with spaces.
+				std::string folded;	//!< Fold()ed text.
+
+				bool operator<(const SPhrase& other) const { return folded.size() < other.folded.size(); }
+			};
+
+			//! \brief Block of FUZZY_LANES phrases.
+			struct SBlock
+			{
+				uint32 offset;	//!< Index of its first letter in letters.
+				uint8 minLength;	//!< Length of its shortest phrase.
+				uint8 maxLength;	//!< Length of its longest phrase; columns in letters.
+				uint8 lengths[FUZZY_LANES];	//!< Lengths of its phrases; 0 for lanes past the last phrase.
+			};
+
+			std::vector<SPhrase> phrases;	//!< All phrases; by length after Compile().
+			std::vector<SBlock> blocks;	//!< Blocks of phrases, in order.
+			std::vector<uint8> letters;	//!< Letters of blocks, a column (FUZZY_LANES bytes) at a time; 0-padded.
+			std::vector<uint8> distances;	//!< Distances of the last text to every phrase.
+			bool bCompiled;	//!< Was Compile() called since the last Add()?
+
+			//! \brief Fills distances of text to phrases of blocks [first, last), one at a time.
+			void ScalarDistances(const std::string& text, uint32 first, uint32 last)
+			{
+				uint8 row[FUZZY_MAX_LENGTH + 1];
+				uint32 m = (uint32)text.size();
+				for(uint32 b = first ; b < last ; ++b)
+				{
+					const SBlock& block = blocks[b];
+					for(uint32 lane = 0 ; lane < FUZZY_LANES ; ++lane)
+					{
+						uint32 n = block.lengths[lane];
+						const uint8* phrase = &letters[block.offset + lane];	//a letter every FUZZY_LANES bytes
+						for(uint32 i = 0 ; i <= m ; ++i)
+						{
+							row[i] = (uint8)i;
+						}
+						for(uint32 j = 0 ; j < n ; ++j)
+						{
+							uint8 diagonal = row[0];
+							row[0] = (uint8)(j + 1);
+							uint8 letter = phrase[j * FUZZY_LANES];
+							for(uint32 i = 1 ; i <= m ; ++i)
+							{
+								uint8 up = row[i];
+								uint8 best = (uint8)(diagonal + (((uint8)text[i - 1] == letter) ? 0 : 1));
+								uint8 gap = (uint8)(((up < row[i - 1]) ? up : row[i - 1]) + 1);
+								row[i] = (gap < best) ? gap : best;
+								diagonal = up;
+							}
+						}
+						distances[b * FUZZY_LANES + lane] = row[m];
+					}
+				}
+			}
+
+		#if VCS_FUZZY_SSE2
+			//! \brief Fills distances of text to phrases of blocks [first, last), FUZZY_LANES at a time.
+			//! Blocks go in pairs: a cell depends on the one above it, so one block alone keeps the CPU waiting.
+			void SSE2Distances(const std::string& text, uint32 first, uint32 last)
+			{
+				__m128i queryLetters[FUZZY_MAX_LENGTH];
+				__m128i columns[FUZZY_MAX_LENGTH + 1][2];	//distances of text prefixes to phrase prefixes of the column so far, of both blocks
+				uint32 m = (uint32)text.size();
+				for(uint32 i = 0 ; i < m ; ++i)
+				{
+					queryLetters[i] = _mm_set1_epi8((char8)text[i]);
+				}
+				const __m128i one = _mm_set1_epi8(1);
+				const __m128i zero = _mm_setzero_si128();
+
+				for(uint32 b = first ; b < last ; b += 2)
+				{
+					const SBlock& blockA = blocks[b];
+					const SBlock& blockB = blocks[(b + 1 < last) ? b + 1 : b];
+					const __m128i lengthsA = _mm_loadu_si128((const __m128i*)blockA.lengths);
+					const __m128i lengthsB = _mm_loadu_si128((const __m128i*)blockB.lengths);
+					__m128i resultA = _mm_set1_epi8((char8)m);	//phrases of length 0, if any
+					__m128i resultB = resultA;
+					for(uint32 i = 0 ; i <= m ; ++i)
+					{
+						columns[i][0] = columns[i][1] = _mm_set1_epi8((char8)i);
+					}
+
+					uint32 n = (blockA.maxLength > blockB.maxLength) ? blockA.maxLength : blockB.maxLength;
+					for(uint32 j = 0 ; j < n ; ++j)
+					{
+						const __m128i lettersA = (j < blockA.maxLength) ? _mm_loadu_si128((const __m128i*)&letters[blockA.offset + j * FUZZY_LANES]) : zero;
+						const __m128i lettersB = (j < blockB.maxLength) ? _mm_loadu_si128((const __m128i*)&letters[blockB.offset + j * FUZZY_LANES]) : zero;
+						__m128i diagonalA = columns[0][0];
+						__m128i diagonalB = columns[0][1];
+						columns[0][0] = columns[0][1] = _mm_set1_epi8((char8)(j + 1));
+						for(uint32 i = 1 ; i <= m ; ++i)
+						{
+							__m128i upA = columns[i][0];
+							__m128i upB = columns[i][1];
+							__m128i costA = _mm_andnot_si128(_mm_cmpeq_epi8(lettersA, queryLetters[i - 1]), one);
+							__m128i costB = _mm_andnot_si128(_mm_cmpeq_epi8(lettersB, queryLetters[i - 1]), one);
+							__m128i gapA = _mm_adds_epu8(_mm_min_epu8(upA, columns[i - 1][0]), one);
+							__m128i gapB = _mm_adds_epu8(_mm_min_epu8(upB, columns[i - 1][1]), one);
+							columns[i][0] = _mm_min_epu8(_mm_adds_epu8(diagonalA, costA), gapA);
+							columns[i][1] = _mm_min_epu8(_mm_adds_epu8(diagonalB, costB), gapB);
+							diagonalA = upA;
+							diagonalB = upB;
+						}
+						//lanes whose phrase ends here take their distance
+						const __m128i column = _mm_set1_epi8((char8)(j + 1));
+						__m128i endsA = _mm_cmpeq_epi8(lengthsA, column);
+						__m128i endsB = _mm_cmpeq_epi8(lengthsB, column);
+						resultA = _mm_or_si128(_mm_and_si128(endsA, columns[m][0]), _mm_andnot_si128(endsA, resultA));
+						resultB = _mm_or_si128(_mm_and_si128(endsB, columns[m][1]), _mm_andnot_si128(endsB, resultB));
+					}
+					_mm_storeu_si128((__m128i*)&distances[b * FUZZY_LANES], resultA);
+					if(b + 1 < last)
+					{
+						_mm_storeu_si128((__m128i*)&distances[(b + 1) * FUZZY_LANES], resultB);
+					}
+				}
+			}
+		#endif //VCS_FUZZY_SSE2
+
+			//! \brief Fills distances of text to phrases of blocks [first, last).
+			void Distances(const std::string& text, uint32 first, uint32 last, E_FuzzyKernel kernel)
+			{
+			#if VCS_FUZZY_SSE2
+				if(kernel == FK_SSE2)
+				{
+					SSE2Distances(text, first, last);
+					return;
+				}
+			#endif //VCS_FUZZY_SSE2
+				ScalarDistances(text, first, last);
+			}
+
+			//! \brief Returns max distance of a match of texts of lengths m and n.
+			static uint32 GetMaxError(uint32 m, uint32 n)
+			{
+				uint32 maxError = ((m > n) ? m : n) * FUZZY_MAX_ERROR / 100;
+				return (maxError > 0) ? maxError : 1;
+			}
+
+		public:
+			CFuzzyMatcher():bCompiled(false){}	//!< Default c-tor.
+
+			//! \brief Lowercases text, keeps letters and digits, spells it roughly phonetically, drops doubled letters.
+			static std::string Fold(const std::string& text)
+			{
+				std::string folded;
+				for(size_t i = 0 ; i < text.size() && folded.size() < FUZZY_MAX_LENGTH ; ++i)
+				{
+					char8 letter = (char8)tolower((uint8)text[i]);
+					if(!isalnum((uint8)letter))
+					{
+						letter = ' ';
+					}
+					else if(letter == 'c')
+					{
+						letter = 'k';
+					}
+					else if(letter == 'z')
+					{
+						letter = 's';
+					}
+					else if(letter == 'h' && !folded.empty() && folded[folded.size() - 1] == 'p')
+					{
+						folded[folded.size() - 1] = 'f';
+						continue;
+					}
+					if(letter == ' ' && folded.empty())
+					{
+						continue;
+					}
+					if(!folded.empty() && folded[folded.size() - 1] == letter)
+					{
+						continue;	//doubled letter, or run of spaces
+					}
+					folded += letter;
+				}
+				if(!folded.empty() && folded[folded.size() - 1] == ' ')
+				{
+					folded.erase(folded.size() - 1);
+				}
+				return folded;
+			}
+
+			//! \brief Forgets all grammars.
+			void Clear()
+			{
+				phrases.clear();
+				blocks.clear();
+				letters.clear();
+				bCompiled = false;
+			}
+
+			//! \brief Adds phrases of top-level rules of a grammar; Compile() when all are added.
+			//! \param grammar: Grammar index reported in matches.
+			void Add(uint32 grammar, const SGrammar& source)
+			{
+				for(size_t r = 0 ; r < source.rules.size() ; ++r)
+				{
+					const SGrammarRule& rule = source.rules[r];
+					for(std::vector<SGrammarPhrase>::const_iterator phrase = rule.phrases.begin() ; phrase != rule.phrases.end() && rule.bTopLevel ; ++phrase)
+					{
+						SPhrase added;
+						added.grammar = grammar;
+						added.rule = (uint32)r;
+						added.ruleId = rule.id;
+						added.value = (*phrase).value;
+						for(std::vector<std::string>::const_iterator word = (*phrase).words.begin() ; word != (*phrase).words.end() ; ++word)
+						{
+							added.text += (added.text.empty() ? "" : " ") + *word;
+						}
+						added.folded = Fold(added.text);
+						if(!added.folded.empty())
+						{
+							phrases.push_back(added);
+						}
+					}
+				}
+				bCompiled = false;
+			}
+
+			//! \brief Sorts phrases by length and packs them into blocks.
+			void Compile()
+			{
+				std::stable_sort(phrases.begin(), phrases.end());	//stable: equal distances go in grammar order
+				blocks.clear();
+				letters.clear();
+				for(size_t first = 0 ; first < phrases.size() ; first += FUZZY_LANES)
+				{
+					SBlock block;
+					block.offset = (uint32)letters.size();
+					block.minLength = (uint8)phrases[first].folded.size();
+					size_t last = (first + FUZZY_LANES < phrases.size()) ? first + FUZZY_LANES : phrases.size();
+					block.maxLength = (uint8)phrases[last - 1].folded.size();
+					memset(block.lengths, 0, sizeof(block.lengths));
+					letters.resize(letters.size() + block.maxLength * FUZZY_LANES, 0);
+					for(size_t p = first ; p < last ; ++p)
+					{
+						const std::string& folded = phrases[p].folded;
+						block.lengths[p - first] = (uint8)folded.size();
+						for(size_t j = 0 ; j < folded.size() ; ++j)
+						{
+							letters[block.offset + j * FUZZY_LANES + (p - first)] = (uint8)folded[j];
+						}
+					}
+					blocks.push_back(block);
+				}
+				distances.resize(blocks.size() * FUZZY_LANES);
+				bCompiled = true;
+			}
+
+			//! \brief Finds phrases nearest to text, of rules isActive(grammar, rule) says are active.
+			//! \param found: Receives matches, nearest first.
+			//! \param maxFound: Max count of matches to return.
+			//! \return Returns count of matches; 0 if no phrase is near enough.
+			template<typename A>
+			uint32 Find(const std::string& text, const A& isActive, SFuzzyMatch* found, uint32 maxFound, E_FuzzyKernel kernel = (VCS_FUZZY_SSE2) ? FK_SSE2 : FK_Scalar)
+			{
+				std::string folded = Fold(text);
+				if(!bCompiled || folded.empty() || maxFound == 0)
+				{
+					return 0;
+				}
+
+				//only blocks with phrases that may be near enough
+				uint32 m = (uint32)folded.size();
+				uint32 window = m * FUZZY_MAX_ERROR / (100 - FUZZY_MAX_ERROR) + 1;
+				uint32 first = 0;
+				while(first < blocks.size() && blocks[first].maxLength + window < m)
+				{
+					++first;
+				}
+				uint32 last = first;
+				while(last < blocks.size() && blocks[last].minLength <= m + window)
+				{
+					++last;
+				}
+				Distances(folded, first, last, kernel);
+
+				uint32 count = 0;
+				for(uint32 p = first * FUZZY_LANES ; p < last * FUZZY_LANES && p < phrases.size() ; ++p)
+				{
+					uint32 distance = distances[p];
+					const SPhrase& phrase = phrases[p];
+					if(distance > GetMaxError(m, (uint32)phrase.folded.size()) || (count == maxFound && distance >= found[count - 1].distance))
+					{
+						continue;
+					}
+					if(!isActive(phrase.grammar, phrase.rule))
+					{
+						continue;
+					}
+
+					//insert, keeping found sorted by distance
+					uint32 slot = (count < maxFound) ? count++ : count - 1;
+					while(slot > 0 && found[slot - 1].distance > distance)
+					{
+						found[slot] = found[slot - 1];
+						--slot;
+					}
+					SFuzzyMatch& match = found[slot];
+					match.grammar = phrase.grammar;
+					match.rule = phrase.rule;
+					match.ruleId = phrase.ruleId;
+					match.value = phrase.value;
+					match.text = phrase.text;
+					match.distance = distance;
+					uint32 length = (m > phrase.folded.size()) ? m : (uint32)phrase.folded.size();
+					match.similarity = 1.0f - (float32)distance / length;
+				}
+				return count;
+			}
+
+			//! \brief Works out distances of text to every phrase; for benchmarks.
+			//! \return Returns distances, in Compile()d phrase order.
+			const std::vector<uint8>& GetDistances(const std::string& text, E_FuzzyKernel kernel)
+			{
+				std::string folded = Fold(text);
+				Distances(folded, 0, (uint32)blocks.size(), kernel);
+				return distances;
+			}
+
+			uint32 GetPhraseCount() const { return (uint32)phrases.size(); }	//!< Returns count of phrases.
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_FUZZY_MATCHER_H__
@@ -0,0 +1,371 @@
+#ifndef __TRC_VCS_GRAMMAR_CACHE_H__
+#define __TRC_VCS_GRAMMAR_CACHE_H__
+
+/*!
+\file GrammarCache.h
+\brief Compiled grammars cached next to their XML, keyed by a hash of it.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Grammars used to be compiled from XML on every start - by SAPI, and by
+	CGrammarXML for replay and early execution, which parses the file and
+	expands every rule into its phrases. Now whoever compiles a grammar
+	keeps the compiled form in a cache file next to the XML: grammar/core.xml
+	gets grammar/core.<kind>.cache, one per kind of compiled form ("cfg" for
+	SAPI's binary grammar, "phrases" for expanded rules). On the next start
+	the cache is taken if it was made from the same XML - its header holds a
+	64-bit FNV-1a hash of the XML's bytes - and the XML is compiled (and the
+	cache written) again otherwise. Nothing needs to be run by hand when a
+	grammar changes.
+
+	The payload has a hash of its own, so a cache cut short or damaged is
+	just a miss. Cache files are native byte order - they're made and read
+	on the same machine. A cache that can't be written (read-only directory)
+	is a warning, not an error; the grammar was compiled anyway.
+
+	LoadGrammar() is CGrammarXML::Load() through the "phrases" cache; Pack()
+	and Unpack() are its payload - words are stored once, and phrases as
+	their indices.
+
+	vcs-replay -bench-cache times it against parsing the XML.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+#include "GrammarXML.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Cache of compiled grammars.
+		class CGrammarCache
+		{
+		protected:
+			enum
+			{
+				CACHE_MAGIC = 0x43475643,	//!< "VCGC", as read from a little endian file.
+				CACHE_VERSION = 1	//!< Bump when a payload's format changes.
+			};
+
+			//! \brief Header of a cache file; payload follows.
+			struct SHeader
+			{
+				uint32 magic;	//!< CACHE_MAGIC.
+				uint32 version;	//!< CACHE_VERSION.
+				uint64 sourceHash;	//!< Hash of the XML it was compiled from.
+				uint64 payloadHash;	//!< Hash of the payload.
+				uint32 payloadSize;	//!< Size of the payload [bytes].
+				uint32 reserved;	//!< 0; pads the header to 8 bytes.
+			};
+
+			//! \brief Reads packed payload, checking it's not cut short.
+			struct SReader
+			{
+				const std::string& data;	//!< Payload.
+				size_t at;	//!< Read position.
+				bool bOk;	//!< Has everything read been there?
+
+				SReader(const std::string& _data):data(_data), at(0), bOk(true){}	//!< C-tor.
+
+				//! \brief Reads a number; 0 past the end.
+				uint32 Number()
+				{
+					uint32 value = 0;
+					if(at + sizeof(value) > data.size())
+					{
+						bOk = false;
+						return 0;
+					}
+					memcpy(&value, data.data() + at, sizeof(value));
+					at += sizeof(value);
+					return value;
+				}
+
+				//! \brief Reads a string; empty past the end.
+				std::string String()
+				{
+					uint32 length = Number();
+					if(at + length > data.size())
+					{
+						bOk = false;
+						return std::string();
+					}
+					at += length;
+					return data.substr(at - length, length);
+				}
+			};
+
+			//! \brief Appends number to payload.
+			static void PutNumber(std::string& data, uint32 value)
+			{
+				data.append((const char8*)&value, sizeof(value));
+			}
+
+			//! \brief Appends string to payload.
+			static void PutString(std::string& data, const std::string& text)
+			{
+				PutNumber(data, (uint32)text.size());
+				data += text;
+			}
+
+		public:
+			//! \brief Returns 64-bit FNV-1a hash of data.
+			static uint64 Hash(const std::string& data)
+			{
+				uint64 hash = 14695981039346656037ULL;
+				for(size_t i = 0 ; i < data.size() ; ++i)
+				{
+					hash ^= (uint8)data[i];
+					hash *= 1099511628211ULL;
+				}
+				return hash;
+			}
+
+			//! \brief Reads whole file.
+			//! \return Returns false if it can't be read.
+			static bool ReadFile(const std::string& fileName, std::string& data)
+			{
+				FILE* file = fopen(fileName.c_str(), "rb");
+				if(file == NULL)
+				{
+					return false;
+				}
+				data.clear();
+				char8 chunk[4096];
+				size_t count;
+				while((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+				{
+					data.append(chunk, count);
+				}
+				bool bOk = (ferror(file) == 0);
+				fclose(file);
+				return bOk;
+			}
+
+			//! \brief Returns name of cache file of a grammar.
+			//! \param kind: Kind of compiled form, like "cfg".
+			static std::string GetFileName(const std::string& sourceFile, const std::string& kind)
+			{
+				std::string::size_type dot = sourceFile.rfind('.');
+				std::string::size_type slash = sourceFile.find_last_of("/\\");
+				if(dot == std::string::npos || (slash != std::string::npos && dot < slash))
+				{
+					dot = sourceFile.size();
+				}
+				return sourceFile.substr(0, dot) + "." + kind + ".cache";
+			}
+
+			//! \brief Reads cache file, if it was made from the same source.
+			//! \param sourceHash: Hash() of the source.
+			//! \param payload: Receives the compiled form.
+			//! \return Returns false if there's no cache, it's stale or damaged.
+			static bool Load(const std::string& cacheFile, uint64 sourceHash, std::string& payload)
+			{
+				std::string data;
+				if(!ReadFile(cacheFile, data) || data.size() < sizeof(SHeader))
+				{
+					return false;
+				}
+				SHeader header;
+				memcpy(&header, data.data(), sizeof(header));
+				if(header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.sourceHash != sourceHash
+					|| header.payloadSize != data.size() - sizeof(header))
+				{
+					return false;
+				}
+				payload.assign(data, sizeof(header), header.payloadSize);
+				return Hash(payload) == header.payloadHash;
+			}
+
+			//! \brief Writes cache file.
+			//! \param sourceHash: Hash() of the source payload was compiled from.
+			//! \return Returns false if it couldn't be written.
+			static bool Store(const std::string& cacheFile, uint64 sourceHash, const std::string& payload)
+			{
+				SHeader header;
+				header.magic = CACHE_MAGIC;
+				header.version = CACHE_VERSION;
+				header.sourceHash = sourceHash;
+				header.payloadHash = Hash(payload);
+				header.payloadSize = (uint32)payload.size();
+				header.reserved = 0;
+
+				FILE* file = fopen(cacheFile.c_str(), "wb");
+				if(file == NULL)
+				{
+					return false;
+				}
+				bool bOk = (fwrite(&header, sizeof(header), 1, file) == 1)
+					&& (payload.empty() || fwrite(payload.data(), payload.size(), 1, file) == 1);
+				bOk = (fclose(file) == 0) && bOk;
+				if(!bOk)
+				{
+					remove(cacheFile.c_str());
+				}
+				return bOk;
+			}
+
+			//! \brief Packs expanded grammar into a payload.
+			static void Pack(const SGrammar& grammar, std::string& data)
+			{
+				data.clear();
+
+				std::map<std::string, uint32> wordIds;
+				std::vector<const std::string*> words;
+				for(std::vector<SGrammarRule>::const_iterator rule = grammar.rules.begin() ; rule != grammar.rules.end() ; ++rule)
+				{
+					for(std::vector<SGrammarPhrase>::const_iterator phrase = (*rule).phrases.begin() ; phrase != (*rule).phrases.end() ; ++phrase)
+					{
+						for(std::vector<std::string>::const_iterator word = (*phrase).words.begin() ; word != (*phrase).words.end() ; ++word)
+						{
+							if(wordIds.insert(std::map<std::string, uint32>::value_type(*word, (uint32)words.size())).second)
+							{
+								words.push_back(&(*word));
+							}
+						}
+					}
+				}
+
+				PutNumber(data, (uint32)words.size());
+				for(std::vector<const std::string*>::const_iterator word = words.begin() ; word != words.end() ; ++word)
+				{
+					PutString(data, *(*word));
+				}
+
+				PutNumber(data, (uint32)grammar.defines.size());
+				for(std::map<std::string, uint32>::const_iterator define = grammar.defines.begin() ; define != grammar.defines.end() ; ++define)
+				{
+					PutString(data, (*define).first);
+					PutNumber(data, (*define).second);
+				}
+
+				PutNumber(data, (uint32)grammar.rules.size());
+				for(std::vector<SGrammarRule>::const_iterator rule = grammar.rules.begin() ; rule != grammar.rules.end() ; ++rule)
+				{
+					PutNumber(data, (*rule).id);
+					PutString(data, (*rule).name);
+					PutNumber(data, ((*rule).bTopLevel ? 1 : 0) | ((*rule).bActive ? 2 : 0));
+					PutNumber(data, (uint32)(*rule).phrases.size());
+					for(std::vector<SGrammarPhrase>::const_iterator phrase = (*rule).phrases.begin() ; phrase != (*rule).phrases.end() ; ++phrase)
+					{
+						PutNumber(data, (*phrase).value);
+						PutNumber(data, (*phrase).bValue ? 1 : 0);
+						PutNumber(data, (uint32)(*phrase).words.size());
+						for(std::vector<std::string>::const_iterator word = (*phrase).words.begin() ; word != (*phrase).words.end() ; ++word)
+						{
+							PutNumber(data, wordIds[*word]);
+						}
+					}
+				}
+			}
+
+			//! \brief Unpacks expanded grammar from a payload.
+			//! \return Returns false if payload isn't a packed grammar.
+			static bool Unpack(const std::string& data, SGrammar& grammar)
+			{
+				SReader reader(data);
+				grammar.rules.clear();
+				grammar.defines.clear();
+
+				std::vector<std::string> words(reader.Number());
+				for(size_t i = 0 ; i < words.size() && reader.bOk ; ++i)
+				{
+					words[i] = reader.String();
+				}
+
+				uint32 defineCount = reader.Number();
+				for(uint32 i = 0 ; i < defineCount && reader.bOk ; ++i)
+				{
+					std::string name = reader.String();
+					grammar.defines[name] = reader.Number();
+				}
+
+				grammar.rules.resize(reader.Number());
+				for(size_t r = 0 ; r < grammar.rules.size() && reader.bOk ; ++r)
+				{
+					SGrammarRule& rule = grammar.rules[r];
+					rule.id = reader.Number();
+					rule.name = reader.String();
+					uint32 flags = reader.Number();
+					rule.bTopLevel = (flags & 1) != 0;
+					rule.bActive = (flags & 2) != 0;
+					rule.phrases.resize(reader.Number());
+					for(size_t p = 0 ; p < rule.phrases.size() && reader.bOk ; ++p)
+					{
+						SGrammarPhrase& phrase = rule.phrases[p];
+						phrase.value = reader.Number();
+						phrase.bValue = (reader.Number() != 0);
+						phrase.words.resize(reader.Number());
+						for(size_t w = 0 ; w < phrase.words.size() && reader.bOk ; ++w)
+						{
+							uint32 word = reader.Number();
+							if(word >= words.size())
+							{
+								reader.bOk = false;
+								break;
+							}
+							phrase.words[w] = words[word];
+						}
+					}
+				}
+				return reader.bOk && reader.at == data.size();
+			}
+
+			//! \brief Loads expanded grammar, from its cache if it's fresh; parses the XML and caches it otherwise.
+			//! \param fileName: Name of SAPI XML grammar file.
+			//! \param grammar: Receives the grammar.
+			//! \param error: Receives description of error, if any.
+			//! \param bCached: Receives true if grammar came from the cache.
+			//! \param bStored: Receives false if the cache was stale, but couldn't be written.
+			//! \return Returns true on success; false otherwise.
+			static bool LoadGrammar(const std::string& fileName, SGrammar& grammar, std::string& error, bool& bCached, bool& bStored)
+			{
+				bCached = false;
+				bStored = true;
+				std::string source;
+				if(!ReadFile(fileName, source))
+				{
+					error = "can't read " + fileName;
+					return false;
+				}
+				uint64 sourceHash = Hash(source);
+				std::string cacheFile = GetFileName(fileName, "phrases");
+				std::string payload;
+				if(Load(cacheFile, sourceHash, payload) && Unpack(payload, grammar))
+				{
+					bCached = true;
+					return true;
+				}
+
+				if(!CGrammarXML::Load(fileName, grammar, error))
+				{
+					return false;
+				}
+				Pack(grammar, payload);
+				bStored = Store(cacheFile, sourceHash, payload);
+				return true;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_GRAMMAR_CACHE_H__
@@ -0,0 +1,285 @@
+#ifndef __TRC_VCS_GRAMMAR_MATCHER_H__
+#define __TRC_VCS_GRAMMAR_MATCHER_H__
+
+/*!
+\file GrammarMatcher.h
+\brief Grammars compiled into a word trie - text to (rule, value) without SAPI.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	CGrammarXML expands every top-level rule into the word sequences it
+	accepts; CGrammarMatcher compiles those of any number of grammars into a
+	trie over words - as a grammar accepts finitely many phrases, that's
+	a DFA already (not minimized: nodes where phrases end say what they mean,
+	so few suffixes could be shared anyway). A lookup costs a word ID lookup
+	and a binary search of a node's edges per word, however many phrases there
+	are; the scan of every phrase of every rule it replaces grew with them.
+
+	Words are interned: each distinct word gets an ID, and the compiled trie is
+	three flat arrays - nodes, edges (sorted by word, contiguous per node), and
+	matches (grammar, rule, value) of nodes where phrases end. A phrase may
+	mean something in more than one rule; its matches keep the order grammars
+	were added in, rules of a grammar in file order, so the first one of an
+	active rule is what the old scan would have found.
+
+	Add() grammars, then Compile(); Find() works on the compiled trie only.
+	Compile() drops what Add() built, so to add another grammar, Clear() and
+	add them all again - grammars are loaded once, at startup.
+
+	vcs-replay -bench-grammar times it against the scan, on generated grammars
+	of up to tens of thousands of phrases.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "GrammarXML.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief What a phrase means.
+		struct SGrammarMatch
+		{
+			uint32 grammar;	//!< Grammar index, as given to CGrammarMatcher::Add().
+			uint32 rule;	//!< Index of the rule in SGrammar::rules.
+			uint32 ruleId;	//!< Rule ID.
+			uint32 value;	//!< Value of the phrase.
+		};
+
+		//! \brief Word trie of the phrases of grammars.
+		class CGrammarMatcher : private boost::noncopyable
+		{
+		protected:
+			enum
+			{
+				NO_WORD = 0xFFFFFFFF	//!< ID of a word no phrase has.
+			};
+
+			//! \brief Node of the compiled trie.
+			struct SNode
+			{
+				uint32 firstEdge;	//!< Index of first edge in edges.
+				uint32 edgeCount;	//!< Count of edges.
+				uint32 firstMatch;	//!< Index of first match in matches.
+				uint32 matchCount;	//!< Count of matches; 0 if no phrase ends here.
+			};
+
+			//! \brief Edge of the compiled trie.
+			struct SEdge
+			{
+				uint32 word;	//!< Word ID.
+				uint32 target;	//!< Node it leads to.
+
+				bool operator<(const SEdge& other) const { return word < other.word; }
+			};
+
+			typedef std::map<std::string, uint32> wordMap_t;	//!< Type of word IDs, by word.
+			typedef std::map<uint32, uint32> childMap_t;	//!< Type of children of a node being built, by word ID.
+
+			wordMap_t words;	//!< Word IDs.
+
+			std::vector<childMap_t> building;	//!< Children of nodes, by node, till Compile().
+			std::vector<std::vector<SGrammarMatch> > buildingMatches;	//!< Matches of nodes, by node, till Compile().
+
+			std::vector<SNode> nodes;	//!< Compiled nodes; the root is 0.
+			std::vector<SEdge> edges;	//!< Compiled edges.
+			std::vector<SGrammarMatch> matches;	//!< Compiled matches.
+			uint32 phraseCount;	//!< Phrases added.
+
+			//! \brief Returns ID of word, giving it one if it has none.
+			uint32 Intern(const std::string& word)
+			{
+				wordMap_t::iterator itor = words.find(word);
+				if(itor == words.end())
+				{
+					itor = words.insert(wordMap_t::value_type(word, (uint32)words.size())).first;
+				}
+				return (*itor).second;
+			}
+
+			//! \brief Returns ID of word; NO_WORD if no phrase has it.
+			uint32 GetWordId(const std::string& word) const
+			{
+				wordMap_t::const_iterator itor = words.find(word);
+				return (itor == words.end()) ? (uint32)NO_WORD : (*itor).second;
+			}
+
+		public:
+			CGrammarMatcher(){ Clear(); }	//!< Default c-tor.
+
+			//! \brief Forgets all grammars.
+			void Clear()
+			{
+				words.clear();
+				building.assign(1, childMap_t());
+				buildingMatches.assign(1, std::vector<SGrammarMatch>());
+				nodes.clear();
+				edges.clear();
+				matches.clear();
+				phraseCount = 0;
+			}
+
+			//! \brief Adds phrases of top-level rules of a grammar; Compile() when all are added.
+			//! \param grammar: Grammar index reported in matches.
+			void Add(uint32 grammar, const SGrammar& source)
+			{
+				if(building.empty())
+				{
+					return;	//compiled already; Clear() first
+				}
+				for(size_t r = 0 ; r < source.rules.size() ; ++r)
+				{
+					const SGrammarRule& rule = source.rules[r];
+					if(!rule.bTopLevel)
+					{
+						continue;
+					}
+					for(std::vector<SGrammarPhrase>::const_iterator phrase = rule.phrases.begin() ; phrase != rule.phrases.end() ; ++phrase)
+					{
+						if((*phrase).words.empty())
+						{
+							continue;
+						}
+						uint32 node = 0;
+						for(std::vector<std::string>::const_iterator word = (*phrase).words.begin() ; word != (*phrase).words.end() ; ++word)
+						{
+							uint32 id = Intern(*word);
+							childMap_t::const_iterator child = building[node].find(id);
+							if(child != building[node].end())
+							{
+								node = (*child).second;
+								continue;
+							}
+							uint32 added = (uint32)building.size();
+							building.push_back(childMap_t());	//may move building[node] - look it up again
+							buildingMatches.push_back(std::vector<SGrammarMatch>());
+							building[node][id] = added;
+							node = added;
+						}
+
+						SGrammarMatch match;
+						match.grammar = grammar;
+						match.rule = (uint32)r;
+						match.ruleId = rule.id;
+						match.value = (*phrase).value;
+						std::vector<SGrammarMatch>& ends = buildingMatches[node];
+						if(ends.empty() || ends.back().grammar != grammar || ends.back().rule != match.rule || ends.back().value != match.value)
+						{
+							ends.push_back(match);
+						}
+						++phraseCount;
+					}
+				}
+			}
+
+			//! \brief Flattens what was added into the compiled trie.
+			void Compile()
+			{
+				if(building.empty())
+				{
+					return;	//compiled already
+				}
+				nodes.clear();
+				edges.clear();
+				matches.clear();
+				nodes.reserve(building.size());
+				edges.reserve(building.size() - 1);
+
+				//breadth first, so children of a node get consecutive numbers
+				std::vector<uint32> order(1, 0);	//built node, by compiled node
+				for(size_t i = 0 ; i < order.size() ; ++i)
+				{
+					const childMap_t& children = building[order[i]];
+					const std::vector<SGrammarMatch>& ends = buildingMatches[order[i]];
+
+					SNode node;
+					node.firstEdge = (uint32)edges.size();
+					node.edgeCount = (uint32)children.size();
+					node.firstMatch = (uint32)matches.size();
+					node.matchCount = (uint32)ends.size();
+					nodes.push_back(node);
+					matches.insert(matches.end(), ends.begin(), ends.end());
+
+					for(childMap_t::const_iterator child = children.begin() ; child != children.end() ; ++child)
+					{
+						SEdge edge;
+						edge.word = (*child).first;
+						edge.target = (uint32)order.size();	//std::map iterates by word, so edges come sorted
+						edges.push_back(edge);
+						order.push_back((*child).second);
+					}
+				}
+
+				std::vector<childMap_t>().swap(building);
+				std::vector<std::vector<SGrammarMatch> >().swap(buildingMatches);
+			}
+
+			//! \brief Looks words up.
+			//! \param phrase: Lowercase words.
+			//! \param first: Receives first of the matches, if there are any.
+			//! \return Returns count of matches - what the phrase means, in grammar and rule order; 0 if nothing.
+			uint32 Find(const std::vector<std::string>& phrase, const SGrammarMatch*& first) const
+			{
+				if(nodes.empty() || phrase.empty())
+				{
+					return 0;
+				}
+				uint32 node = 0;
+				for(std::vector<std::string>::const_iterator word = phrase.begin() ; word != phrase.end() ; ++word)
+				{
+					SEdge key;
+					key.word = GetWordId(*word);
+					if(key.word == NO_WORD || nodes[node].edgeCount == 0)
+					{
+						return 0;
+					}
+					const SEdge* begin = &edges[nodes[node].firstEdge];
+					const SEdge* end = begin + nodes[node].edgeCount;
+					const SEdge* edge = std::lower_bound(begin, end, key);
+					if(edge == end || (*edge).word != key.word)
+					{
+						return 0;
+					}
+					node = (*edge).target;
+				}
+				if(nodes[node].matchCount > 0)
+				{
+					first = &matches[nodes[node].firstMatch];
+				}
+				return nodes[node].matchCount;
+			}
+
+			uint32 GetPhraseCount() const { return phraseCount; }	//!< Returns count of phrases added.
+			uint32 GetWordCount() const { return (uint32)words.size(); }	//!< Returns count of distinct words.
+			uint32 GetNodeCount() const { return (uint32)nodes.size(); }	//!< Returns count of compiled nodes.
+
+			//! \brief Returns size of the compiled trie [bytes]; words not counted.
+			uint32 GetSize() const
+			{
+				return (uint32)(nodes.size() * sizeof(SNode) + edges.size() * sizeof(SEdge) + matches.size() * sizeof(SGrammarMatch));
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_GRAMMAR_MATCHER_H__
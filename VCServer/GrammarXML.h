@@ -0,0 +1,533 @@
+#ifndef __TRC_VCS_GRAMMAR_XML_H__
+#define __TRC_VCS_GRAMMAR_XML_H__
+
+/*!
+\file GrammarXML.h
+\brief Reader of SAPI XML grammar files.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Reads grammars like grammar/core.xml without SAPI, so they can be used by
+	recognizers other than SAPI (see Recognizer_Replay.h). Every top-level rule
+	is expanded into the full list of word sequences it accepts, each with the
+	value of the phrase it goes through.
+
+	Understood: DEFINE / ID, RULE, L (LIST), P (PHRASE), O (OPT) and RULEREF (by
+	NAME or REFID). Other elements just contribute their contents; wildcards and
+	dictation match nothing. Files may be UTF-16 (as saved by SAPI tools) or 8-bit;
+	only ASCII is kept, anything else becomes '?'.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Single word sequence accepted by a rule.
+		struct SGrammarPhrase
+		{
+			std::vector<std::string> words;	//!< Lowercase words.
+			uint32 value;	//!< Value of the phrase's property; 0 if none.
+			bool bValue;	//!< Was value set by some phrase?
+
+			SGrammarPhrase():value(0), bValue(false){}
+		};
+
+		//! \brief Rule of a grammar.
+		struct SGrammarRule
+		{
+			uint32 id;	//!< Rule ID.
+			std::string name;	//!< Rule name (NAME, or ID as written).
+			bool bTopLevel;	//!< Can it be activated?
+			bool bActive;	//!< Is it active by default (TOPLEVEL="Active")?
+			std::vector<SGrammarPhrase> phrases;	//!< Everything the rule accepts.
+
+			SGrammarRule():id(0), bTopLevel(false), bActive(false){}
+		};
+
+		//! \brief Grammar read from file.
+		struct SGrammar
+		{
+			std::vector<SGrammarRule> rules;	//!< All rules, in file order.
+			std::map<std::string, uint32> defines;	//!< IDs from DEFINE section.
+		};
+
+		//! \brief Reads SAPI XML grammars.
+		class CGrammarXML
+		{
+		protected:
+			enum
+			{
+				MAX_PHRASES = 65536,	//!< Max count of word sequences per rule; generated ones (playlists) go to tens of thousands.
+				MAX_RULEREF_DEPTH = 16	//!< Max nesting of rule references.
+			};
+
+			//! \brief XML element or text.
+			struct SNode
+			{
+				std::string name;	//!< Uppercase element name; empty for text.
+				std::map<std::string, std::string> attributes;	//!< Attributes; uppercase names.
+				std::vector<SNode> children;	//!< Child nodes.
+				std::string text;	//!< Text of text nodes.
+			};
+
+			typedef std::vector<SGrammarPhrase> phraseList_t;	//!< Type of list of alternatives.
+			typedef std::map<std::string, const SNode*> ruleMap_t;	//!< Type of rule node lookup.
+
+			//! \brief Reads file as ASCII text, decoding UTF-16 if there's a byte order mark.
+			static bool ReadText(const std::string& fileName, std::string& text)
+			{
+				FILE* file = fopen(fileName.c_str(), "rb");
+				if(file == NULL)
+				{
+					return false;
+				}
+				std::string data;
+				char8 chunk[4096];
+				size_t count;
+				while((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+				{
+					data.append(chunk, count);
+				}
+				fclose(file);
+
+				text.clear();
+				const uint8* bytes = (const uint8*)data.data();
+				if(data.size() >= 2 && ( (bytes[0] == 0xFF && bytes[1] == 0xFE) || (bytes[0] == 0xFE && bytes[1] == 0xFF) ))
+				{
+					bool bLittleEndian = (bytes[0] == 0xFF);
+					for(size_t i = 2 ; i + 1 < data.size() ; i += 2)
+					{
+						uint16 unit = bLittleEndian ? (uint16)(bytes[i] | (bytes[i + 1] << 8)) : (uint16)((bytes[i] << 8) | bytes[i + 1]);
+						text += (unit < 0x80) ? (char8)unit : '?';
+					}
+					return true;
+				}
+
+				size_t start = (data.size() >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) ? 3 : 0;
+				for(size_t i = start ; i < data.size() ; ++i)
+				{
+					text += (bytes[i] < 0x80) ? (char8)bytes[i] : '?';
+				}
+				return true;
+			}
+
+			//! \brief Returns uppercase copy of text.
+			static std::string ToUpper(const std::string& text)
+			{
+				std::string result(text);
+				for(size_t i = 0 ; i < result.size() ; ++i)
+				{
+					result[i] = (char8)toupper((uint8)result[i]);
+				}
+				return result;
+			}
+
+			//! \brief Replaces XML entities.
+			static std::string Unescape(const std::string& text)
+			{
+				static const char8* entities[][2] = { {"&lt;", "<"}, {"&gt;", ">"}, {"&quot;", "\""}, {"&apos;", "'"}, {"&amp;", "&"} };
+				std::string result;
+				for(size_t i = 0 ; i < text.size() ; ++i)
+				{
+					bool bReplaced = false;
+					if(text[i] == '&')
+					{
+						for(size_t e = 0 ; e < sizeof(entities) / sizeof(entities[0]) && !bReplaced ; ++e)
+						{
+							std::string entity(entities[e][0]);
+							if(text.compare(i, entity.size(), entity) == 0)
+							{
+								result += entities[e][1];
+								i += entity.size() - 1;
+								bReplaced = true;
+							}
+						}
+					}
+					if(!bReplaced)
+					{
+						result += text[i];
+					}
+				}
+				return result;
+			}
+
+			//! \brief Parses XML text into a tree.
+			//! \param text: The XML.
+			//! \param root: Receives top-level nodes as children.
+			//! \param error: Receives description of error, if any.
+			//! \return Returns true on success; false otherwise.
+			static bool Parse(const std::string& text, SNode& root, std::string& error)
+			{
+				std::vector<SNode*> open(1, &root);
+				size_t pos = 0;
+				while(pos < text.size())
+				{
+					if(text[pos] != '<')
+					{
+						size_t end = text.find('<', pos);
+						if(end == std::string::npos)
+						{
+							end = text.size();
+						}
+						SNode node;
+						node.text = Unescape(text.substr(pos, end - pos));
+						open.back()->children.push_back(node);
+						pos = end;
+						continue;
+					}
+
+					if(text.compare(pos, 4, "<!--") == 0 || text.compare(pos, 2, "<?") == 0 || text.compare(pos, 2, "<!") == 0)
+					{
+						const char8* terminator = (text.compare(pos, 4, "<!--") == 0) ? "-->" : ">";
+						size_t end = text.find(terminator, pos);
+						if(end == std::string::npos)
+						{
+							error = "unterminated comment or declaration";
+							return false;
+						}
+						pos = end + strlen(terminator);
+						continue;
+					}
+
+					size_t end = text.find('>', pos);
+					if(end == std::string::npos)
+					{
+						error = "unterminated tag";
+						return false;
+					}
+					std::string tag = text.substr(pos + 1, end - pos - 1);
+					pos = end + 1;
+
+					if(!tag.empty() && tag[0] == '/')
+					{
+						std::string name = ToUpper(tag.substr(1));
+						name.erase(name.find_last_not_of(" \t\r\n") + 1);
+						if(open.size() < 2 || open.back()->name != name)
+						{
+							error = "unexpected </" + name + ">";
+							return false;
+						}
+						open.pop_back();
+						continue;
+					}
+
+					bool bEmpty = (!tag.empty() && tag[tag.size() - 1] == '/');
+					if(bEmpty)
+					{
+						tag.erase(tag.size() - 1);
+					}
+
+					SNode node;
+					size_t cursor = tag.find_first_of(" \t\r\n");
+					node.name = ToUpper(tag.substr(0, cursor));
+					while(cursor != std::string::npos && cursor < tag.size())
+					{
+						size_t nameStart = tag.find_first_not_of(" \t\r\n", cursor);
+						if(nameStart == std::string::npos)
+						{
+							break;
+						}
+						size_t equals = tag.find('=', nameStart);
+						if(equals == std::string::npos || equals + 1 >= tag.size())
+						{
+							error = "malformed attribute in <" + node.name + ">";
+							return false;
+						}
+						size_t quote = tag.find_first_of("\"'", equals + 1);
+						size_t closing = (quote == std::string::npos) ? std::string::npos : tag.find(tag[quote], quote + 1);
+						if(closing == std::string::npos)
+						{
+							error = "unterminated attribute in <" + node.name + ">";
+							return false;
+						}
+						std::string name = tag.substr(nameStart, equals - nameStart);
+						name.erase(name.find_last_not_of(" \t\r\n") + 1);
+						node.attributes[ToUpper(name)] = Unescape(tag.substr(quote + 1, closing - quote - 1));
+						cursor = closing + 1;
+					}
+
+					open.back()->children.push_back(node);
+					if(!bEmpty)
+					{
+						open.push_back(&open.back()->children.back());
+					}
+				}
+
+				if(open.size() > 1)
+				{
+					error = "unclosed <" + open.back()->name + ">";
+					return false;
+				}
+				return true;
+			}
+
+			//! \brief Returns attribute value, or empty string.
+			static std::string GetAttribute(const SNode& node, const char8* name)
+			{
+				std::map<std::string, std::string>::const_iterator itor = node.attributes.find(name);
+				return (itor != node.attributes.end()) ? (*itor).second : std::string();
+			}
+
+			//! \brief Resolves ID written as a number or a DEFINEd name.
+			static bool ResolveId(const SGrammar& grammar, const std::string& text, uint32& id)
+			{
+				if(text.empty())
+				{
+					return false;
+				}
+				if(isdigit((uint8)text[0]))
+				{
+					id = (uint32)strtoul(text.c_str(), NULL, 0);
+					return true;
+				}
+				std::map<std::string, uint32>::const_iterator itor = grammar.defines.find(text);
+				if(itor == grammar.defines.end())
+				{
+					return false;
+				}
+				id = (*itor).second;
+				return true;
+			}
+
+			//! \brief Appends every sequence of tail to every sequence of head.
+			static bool Concatenate(phraseList_t& head, const phraseList_t& tail)
+			{
+				if(head.size() * tail.size() > MAX_PHRASES)
+				{
+					return false;
+				}
+				phraseList_t result;
+				for(phraseList_t::const_iterator first = head.begin() ; first != head.end() ; ++first)
+				{
+					for(phraseList_t::const_iterator second = tail.begin() ; second != tail.end() ; ++second)
+					{
+						SGrammarPhrase phrase(*first);
+						phrase.words.insert(phrase.words.end(), (*second).words.begin(), (*second).words.end());
+						if((*second).bValue)
+						{
+							phrase.value = (*second).value;
+							phrase.bValue = true;
+						}
+						result.push_back(phrase);
+					}
+				}
+				head.swap(result);
+				return true;
+			}
+
+			//! \brief Expands contents of a node into alternative word sequences.
+			//! \return Returns false on error (described in error).
+			static bool Expand(const SGrammar& grammar, const ruleMap_t& rules, const SNode& node, uint32 depth, phraseList_t& phrases, std::string& error)
+			{
+				phrases.assign(1, SGrammarPhrase());
+
+				if(node.name.empty())
+				{
+					//text - split into words
+					std::string word;
+					for(size_t i = 0 ; i <= node.text.size() ; ++i)
+					{
+						if(i == node.text.size() || isspace((uint8)node.text[i]))
+						{
+							if(!word.empty())
+							{
+								phrases[0].words.push_back(word);
+								word.clear();
+							}
+						}
+						else
+						{
+							word += (char8)tolower((uint8)node.text[i]);
+						}
+					}
+					return true;
+				}
+
+				if(node.name == "RULEREF")
+				{
+					std::string name = GetAttribute(node, "NAME");
+					if(name.empty())
+					{
+						name = GetAttribute(node, "REFID");
+					}
+					ruleMap_t::const_iterator itor = rules.find(name);
+					if(itor == rules.end())
+					{
+						error = "unknown rule " + name;
+						return false;
+					}
+					if(depth >= MAX_RULEREF_DEPTH)
+					{
+						error = "rule references nested too deep at " + name;
+						return false;
+					}
+					return Expand(grammar, rules, *(*itor).second, depth + 1, phrases, error);
+				}
+
+				if(node.name == "WILDCARD" || node.name == "DICTATION" || node.name == "TEXTBUFFER")
+				{
+					phrases.clear();
+					return true;
+				}
+
+				bool bList = (node.name == "L" || node.name == "LIST");
+				if(bList)
+				{
+					phrases.clear();
+				}
+				for(std::vector<SNode>::const_iterator child = node.children.begin() ; child != node.children.end() ; ++child)
+				{
+					if(bList && (*child).name.empty())
+					{
+						continue;	//whitespace between alternatives
+					}
+					phraseList_t part;
+					if(!Expand(grammar, rules, *child, depth, part, error))
+					{
+						return false;
+					}
+					if(bList)
+					{
+						phrases.insert(phrases.end(), part.begin(), part.end());
+					}
+					else if(!Concatenate(phrases, part))
+					{
+						error = "too many phrases";
+						return false;
+					}
+				}
+
+				if(node.name == "O" || node.name == "OPT")
+				{
+					phrases.push_back(SGrammarPhrase());
+				}
+
+				uint32 value;
+				if((node.name == "P" || node.name == "PHRASE") && ResolveId(grammar, GetAttribute(node, "VAL"), value))
+				{
+					for(phraseList_t::iterator itor = phrases.begin() ; itor != phrases.end() ; ++itor)
+					{
+						if(!(*itor).bValue)	//innermost value wins
+						{
+							(*itor).value = value;
+							(*itor).bValue = true;
+						}
+					}
+				}
+				return true;
+			}
+
+		public:
+			//! \brief Loads grammar from file.
+			//! \param fileName: Name of SAPI XML grammar file.
+			//! \param grammar: Receives the grammar.
+			//! \param error: Receives description of error, if any.
+			//! \return Returns true on success; false otherwise.
+			static bool Load(const std::string& fileName, SGrammar& grammar, std::string& error)
+			{
+				std::string text;
+				if(!ReadText(fileName, text))
+				{
+					error = "can't read " + fileName;
+					return false;
+				}
+
+				SNode root;
+				if(!Parse(text, root, error))
+				{
+					return false;
+				}
+
+				const SNode* grammarNode = NULL;
+				for(std::vector<SNode>::const_iterator itor = root.children.begin() ; itor != root.children.end() ; ++itor)
+				{
+					if((*itor).name == "GRAMMAR")
+					{
+						grammarNode = &(*itor);
+					}
+				}
+				if(grammarNode == NULL)
+				{
+					error = "no <GRAMMAR> element";
+					return false;
+				}
+
+				//IDs and rules first - rules may refer to ones defined later
+				grammar.rules.clear();
+				grammar.defines.clear();
+				ruleMap_t rules;
+				std::vector<const SNode*> ruleNodes;
+				for(std::vector<SNode>::const_iterator itor = grammarNode->children.begin() ; itor != grammarNode->children.end() ; ++itor)
+				{
+					if((*itor).name == "DEFINE")
+					{
+						for(std::vector<SNode>::const_iterator id = (*itor).children.begin() ; id != (*itor).children.end() ; ++id)
+						{
+							if((*id).name == "ID")
+							{
+								grammar.defines[GetAttribute(*id, "NAME")] = (uint32)strtoul(GetAttribute(*id, "VAL").c_str(), NULL, 0);
+							}
+						}
+					}
+					else if((*itor).name == "RULE")
+					{
+						std::string name = GetAttribute(*itor, "NAME");
+						if(name.empty())
+						{
+							name = GetAttribute(*itor, "ID");
+						}
+						rules[name] = &(*itor);
+						ruleNodes.push_back(&(*itor));
+					}
+				}
+
+				for(std::vector<const SNode*>::const_iterator itor = ruleNodes.begin() ; itor != ruleNodes.end() ; ++itor)
+				{
+					const SNode& node = *(*itor);
+					SGrammarRule rule;
+					rule.name = GetAttribute(node, "NAME");
+					if(rule.name.empty())
+					{
+						rule.name = GetAttribute(node, "ID");
+					}
+					ResolveId(grammar, GetAttribute(node, "ID"), rule.id);
+					std::string topLevel = ToUpper(GetAttribute(node, "TOPLEVEL"));
+					rule.bTopLevel = !topLevel.empty();
+					rule.bActive = (topLevel == "ACTIVE");
+
+					if(!Expand(grammar, rules, node, 0, rule.phrases, error))
+					{
+						error = "rule " + rule.name + ": " + error;
+						return false;
+					}
+					grammar.rules.push_back(rule);
+				}
+				return true;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_GRAMMAR_XML_H__
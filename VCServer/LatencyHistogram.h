@@ -0,0 +1,164 @@
+#ifndef __TRC_VCS_LATENCY_HISTOGRAM_H__
+#define __TRC_VCS_LATENCY_HISTOGRAM_H__
+
+/*!
+\file LatencyHistogram.h
+\brief Lock-free histogram of latencies, HDR style.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Buckets are log-linear, like in HdrHistogram: values below
+	LATENCY_SUB_BUCKETS [us] get a bucket each, and every power of two above
+	is split into LATENCY_SUB_BUCKETS / 2 equal buckets. That keeps every value
+	within ~3% of its bucket's lower bound, from 1 us up to an hour, in
+	LATENCY_BUCKETS counters.
+
+	Record() only does atomic increments, so one thread may record while
+	another reads percentiles; a reader racing a writer may see a count that's
+	one sample off, which doesn't matter for a report.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include "Atomic.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			LATENCY_SUB_BUCKET_BITS = 5,
+			LATENCY_SUB_BUCKETS = 1 << LATENCY_SUB_BUCKET_BITS,	//!< Buckets of values below that; halves of it per power of two above.
+			LATENCY_BUCKETS = LATENCY_SUB_BUCKETS + (32 - LATENCY_SUB_BUCKET_BITS) * (LATENCY_SUB_BUCKETS / 2)	//!< Buckets covering all of uint32.
+		};
+
+		//! \brief Histogram of latencies [us].
+		class CLatencyHistogram
+		{
+		protected:
+			atomic32 buckets[LATENCY_BUCKETS];	//!< Count of samples, by bucket.
+			atomic32 count;	//!< Count of all samples.
+			atomic32 maxValue;	//!< Biggest sample.
+
+			//! \brief Returns bucket of value.
+			static uint32 BucketOf(uint32 value)
+			{
+				if(value < LATENCY_SUB_BUCKETS)
+				{
+					return value;
+				}
+				uint32 top = 31;
+				while((value & (1u << top)) == 0)
+				{
+					--top;
+				}
+				uint32 shift = top - (LATENCY_SUB_BUCKET_BITS - 1);	//leaves value in [SUB_BUCKETS / 2, SUB_BUCKETS)
+				return LATENCY_SUB_BUCKETS + (shift - 1) * (LATENCY_SUB_BUCKETS / 2) + ((value >> shift) - LATENCY_SUB_BUCKETS / 2);
+			}
+
+		public:
+			//! \brief Returns highest value that lands in bucket.
+			static uint32 BucketTop(uint32 bucket)
+			{
+				if(bucket < LATENCY_SUB_BUCKETS)
+				{
+					return bucket;
+				}
+				uint32 shift = (bucket - LATENCY_SUB_BUCKETS) / (LATENCY_SUB_BUCKETS / 2) + 1;
+				uint32 sub = (bucket - LATENCY_SUB_BUCKETS) % (LATENCY_SUB_BUCKETS / 2) + LATENCY_SUB_BUCKETS / 2;
+				return (uint32)((((uint64)sub + 1) << shift) - 1);
+			}
+
+			CLatencyHistogram(){ Reset(); }	//!< Default c-tor.
+
+			//! \brief Clears all samples; not to be raced with Record().
+			void Reset()
+			{
+				for(uint32 i = 0 ; i < LATENCY_BUCKETS ; ++i)
+				{
+					buckets[i] = 0;
+				}
+				count = 0;
+				maxValue = 0;
+			}
+
+			//! \brief Adds a sample.
+			//! \param value: Latency [us].
+			void Record(uint32 value)
+			{
+				Record(value, 1);
+			}
+
+			//! \brief Adds count samples of the same value.
+			//! \param value: Latency [us].
+			void Record(uint32 value, uint32 samples)
+			{
+				AtomicAdd(&buckets[BucketOf(value)], (sint32)samples);
+				AtomicAdd(&count, (sint32)samples);
+
+				sint32 seen = AtomicLoad(&maxValue);
+				while((uint32)seen < value)
+				{
+					sint32 previous = AtomicCompareExchange(&maxValue, (sint32)value, seen);
+					if(previous == seen)
+					{
+						break;
+					}
+					seen = previous;
+				}
+			}
+
+			//! \brief Returns count of samples in bucket (below LATENCY_BUCKETS).
+			uint32 GetBucketCount(uint32 bucket) const { return (uint32)AtomicLoad(&buckets[bucket]); }
+
+			//! \brief Returns count of samples.
+			uint32 GetCount() const { return (uint32)AtomicLoad(&count); }
+
+			//! \brief Returns biggest sample [us].
+			uint32 GetMax() const { return (uint32)AtomicLoad(&maxValue); }
+
+			//! \brief Returns value below or at which percent of samples are.
+			//! \param percent: 0 - 100.
+			//! \return Returns upper bound of the bucket the percentile falls into [us], capped at max; 0 if there are no samples.
+			uint32 GetPercentile(uint32 percent) const
+			{
+				uint32 total = GetCount();
+				if(total == 0)
+				{
+					return 0;
+				}
+				uint64 rank = ((uint64)total * percent + 99) / 100;	//nearest rank
+				if(rank == 0)
+				{
+					rank = 1;
+				}
+				uint64 seen = 0;
+				for(uint32 i = 0 ; i < LATENCY_BUCKETS ; ++i)
+				{
+					seen += (uint32)AtomicLoad(&buckets[i]);
+					if(seen >= rank)
+					{
+						uint32 top = BucketTop(i);
+						return (top < GetMax()) ? top : GetMax();
+					}
+				}
+				return GetMax();
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LATENCY_HISTOGRAM_H__
@@ -0,0 +1,299 @@
+#ifndef __TRC_VCS_LISTEN_TIMES_H__
+#define __TRC_VCS_LISTEN_TIMES_H__
+
+/*!
+\file ListenTimes.h
+\brief Listen windows fitted to how fast the user answers.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	A fixed listen window is too short for someone who thinks before
+	answering, and keeps a quick user waiting on a missed command. So for every
+	menu level (the rule a dialogue waits for) CListenTimes keeps a histogram of
+	response times - wait start to speech start - and sets the window to their
+	LISTEN_PERCENTILE-th percentile plus LISTEN_MARGIN, within
+	LISTEN_TIME_MIN and LISTEN_TIME_MAX. Until a level has LISTEN_MIN_SAMPLES
+	answers, its window is the default.
+
+	A wait that timed out says only that the answer, if any, would have come
+	later - most often there was none, the wait was a misfire nobody answered.
+	So timeouts stay out of the percentile and are only counted: if more than
+	LISTEN_TIMEOUT_RATE percent of a level's waits time out, its window gets
+	LISTEN_TIMEOUT_STEP more, once. The window can't feed on its own timeouts.
+	The rate is taken over the last LISTEN_HISTORY waits, answered or not.
+
+	Histograms are per user: Save() writes them to a text file, one
+	"<rule> <ms> <count>" line per nonempty bucket and a "<rule> timeouts
+	<count>" line, and Load() reads them back. Counts are halved whenever a level
+	goes over LISTEN_HISTORY samples, so the window follows the user as they get
+	used to the menus.
+
+	Values are in [ms], not the [us] CLatencyHistogram is made for; its buckets
+	don't care.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include "LatencyHistogram.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			LISTEN_TIME_MIN = 2500,	//!< Shortest listen window [ms].
+			LISTEN_TIME_MAX = 15000,	//!< Longest listen window [ms].
+			LISTEN_MARGIN = 1500,	//!< Added to the response time percentile [ms]; covers saying the command.
+			LISTEN_PERCENTILE = 95,	//!< Percentile of response times a window covers.
+			LISTEN_MIN_SAMPLES = 10,	//!< Answers of a menu level needed to fit its window.
+			LISTEN_TIMEOUT_RATE = 25,	//!< Percent of a level's waits that may time out before its window grows.
+			LISTEN_TIMEOUT_STEP = 1500,	//!< What a window grows by [ms] if too many of its waits time out.
+			LISTEN_HISTORY = 200	//!< Samples (answers and timeouts) of a menu level kept; older ones fade out.
+		};
+
+		//! \brief Response time histograms of menu levels, and listen windows fitted to them.
+		class CListenTimes : private boost::noncopyable
+		{
+		protected:
+			//! \brief Samples of a menu level.
+			struct SLevel
+			{
+				CLatencyHistogram responses;	//!< Response times [ms] of answered waits.
+				uint32 waits;	//!< Waits, answered or not; faded apart from responses.
+				uint32 timeouts;	//!< Waits that timed out; faded with waits.
+
+				SLevel():waits(0), timeouts(0){}
+			};
+
+			typedef std::map<uint32, SLevel*> levelMap_t;	//!< Type of levels, by rule.
+
+			levelMap_t levels;	//!< Samples, by rule waited for.
+			uint32 defaultWindow;	//!< Window [ms] of levels without enough samples.
+
+			//! \brief Returns level of rule, creating it if needed.
+			SLevel& GetLevel(uint32 rule)
+			{
+				levelMap_t::iterator itor = levels.find(rule);
+				if(itor == levels.end())
+				{
+					itor = levels.insert(levelMap_t::value_type(rule, new SLevel)).first;
+				}
+				return *(*itor).second;
+			}
+
+			//! \brief Returns level of rule; NULL if there are no samples of it.
+			const SLevel* FindLevel(uint32 rule) const
+			{
+				levelMap_t::const_iterator itor = levels.find(rule);
+				return (itor == levels.end()) ? NULL : (*itor).second;
+			}
+
+			//! \brief Halves responses of level while there are over LISTEN_HISTORY of them, and so waits.
+			//!
+			//! Apart, so levels that mostly time out don't lose the answers they have.
+			static void Fade(SLevel& level)
+			{
+				while(level.responses.GetCount() > LISTEN_HISTORY)
+				{
+					Halve(level.responses);
+				}
+				while(level.waits > LISTEN_HISTORY)
+				{
+					level.waits /= 2;
+					level.timeouts /= 2;
+				}
+			}
+
+			//! \brief Halves all counts of histogram.
+			static void Halve(CLatencyHistogram& histogram)
+			{
+				uint32 counts[LATENCY_BUCKETS];
+				for(uint32 i = 0 ; i < LATENCY_BUCKETS ; ++i)
+				{
+					counts[i] = histogram.GetBucketCount(i);
+				}
+				histogram.Reset();
+				for(uint32 i = 0 ; i < LATENCY_BUCKETS ; ++i)
+				{
+					if(counts[i] / 2 > 0)
+					{
+						histogram.Record(CLatencyHistogram::BucketTop(i), counts[i] / 2);
+					}
+				}
+			}
+
+		public:
+			//! \brief C-tor.
+			//! \param _defaultWindow: Window [ms] of levels without enough samples.
+			CListenTimes(uint32 _defaultWindow):defaultWindow(_defaultWindow){}
+
+			//! \brief D-tor.
+			~CListenTimes(){ Clear(); }
+
+			//! \brief Forgets all samples.
+			void Clear()
+			{
+				for(levelMap_t::iterator itor = levels.begin() ; itor != levels.end() ; ++itor)
+				{
+					delete (*itor).second;
+				}
+				levels.clear();
+			}
+
+			//! \brief Records how long the user took to answer.
+			//! \param rule: Rule waited for.
+			//! \param ms: Time from wait start to speech start [ms].
+			void Record(uint32 rule, uint32 ms)
+			{
+				SLevel& level = GetLevel(rule);
+				level.responses.Record(ms);
+				++level.waits;
+				Fade(level);
+			}
+
+			//! \brief Records a wait for rule that timed out.
+			void RecordTimeout(uint32 rule)
+			{
+				SLevel& level = GetLevel(rule);
+				++level.waits;
+				++level.timeouts;
+				Fade(level);
+			}
+
+			//! \brief Returns listen window [ms] for a wait for rule.
+			uint32 GetWindow(uint32 rule) const
+			{
+				const SLevel* level = FindLevel(rule);
+				if(level == NULL || level->responses.GetCount() < LISTEN_MIN_SAMPLES)
+				{
+					return defaultWindow;
+				}
+				uint32 window = level->responses.GetPercentile(LISTEN_PERCENTILE) + LISTEN_MARGIN;
+				if(level->timeouts * 100 > level->waits * LISTEN_TIMEOUT_RATE)
+				{
+					window += LISTEN_TIMEOUT_STEP;
+				}
+				if(window < LISTEN_TIME_MIN)
+				{
+					return LISTEN_TIME_MIN;
+				}
+				return (window > LISTEN_TIME_MAX) ? (uint32)LISTEN_TIME_MAX : window;
+			}
+
+			//! \brief Returns count of answered waits for rule.
+			uint32 GetCount(uint32 rule) const
+			{
+				const SLevel* level = FindLevel(rule);
+				return (level == NULL) ? 0 : level->responses.GetCount();
+			}
+
+			//! \brief Returns count of waits for rule that timed out.
+			uint32 GetTimeouts(uint32 rule) const
+			{
+				const SLevel* level = FindLevel(rule);
+				return (level == NULL) ? 0 : level->timeouts;
+			}
+
+			//! \brief Returns rules there are samples of; fills up to maxRules of them.
+			uint32 GetRules(uint32* rules, uint32 maxRules) const
+			{
+				uint32 count = 0;
+				for(levelMap_t::const_iterator itor = levels.begin() ; itor != levels.end() && count < maxRules ; ++itor)
+				{
+					rules[count++] = (*itor).first;
+				}
+				return count;
+			}
+
+			//! \brief Reads samples saved by Save(), adding them to the ones there are.
+			//! \return Returns false if file can't be read.
+			bool Load(const std::string& fileName)
+			{
+				FILE* file = fopen(fileName.c_str(), "rt");
+				if(file == NULL)
+				{
+					return false;
+				}
+
+				char8 line[256];
+				char8 timeouts[16];
+				while(fgets(line, sizeof(line), file))
+				{
+					uint32 rule = 0, ms = 0, count = 0;
+					if(sscanf(line, "%u %15s %u", &rule, timeouts, &count) == 3 && strcmp(timeouts, "timeouts") == 0)
+					{
+						if(rule != 0 && count > 0)
+						{
+							SLevel& level = GetLevel(rule);
+							level.waits += count;
+							level.timeouts += count;
+							Fade(level);
+						}
+					}
+					else if(sscanf(line, "%u %u %u", &rule, &ms, &count) == 3 && rule != 0 && count > 0)
+					{
+						SLevel& level = GetLevel(rule);
+						level.responses.Record(ms, count);
+						level.waits += count;
+						Fade(level);
+					}
+				}
+				fclose(file);
+				return true;
+			}
+
+			//! \brief Writes all samples to file.
+			//! \return Returns false if file can't be written.
+			bool Save(const std::string& fileName) const
+			{
+				FILE* file = fopen(fileName.c_str(), "wt");
+				if(file == NULL)
+				{
+					return false;
+				}
+
+				fprintf(file, "# rule ms count - listen response times of VC System\n");
+				for(levelMap_t::const_iterator itor = levels.begin() ; itor != levels.end() ; ++itor)
+				{
+					const SLevel& level = *(*itor).second;
+					for(uint32 i = 0 ; i < LATENCY_BUCKETS ; ++i)
+					{
+						uint32 count = level.responses.GetBucketCount(i);
+						if(count > 0)
+						{
+							fprintf(file, "%u %u %u\n", (*itor).first, CLatencyHistogram::BucketTop(i), count);
+						}
+					}
+					if(level.timeouts > 0)
+					{
+						fprintf(file, "%u timeouts %u\n", (*itor).first, level.timeouts);
+					}
+				}
+				bool bWritten = (ferror(file) == 0);
+				return (fclose(file) == 0) && bWritten;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LISTEN_TIMES_H__
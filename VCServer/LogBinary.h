@@ -0,0 +1,68 @@
+#ifndef __TRC_VCS_LOG_BINARY_H__
+#define __TRC_VCS_LOG_BINARY_H__
+
+/*!
+\file LogBinary.h
+\brief Layout of binary log files.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Written by CLogOutput_BinaryFile, read by LogDecoder. All numbers are stored
+	in native (x86, little-endian) byte order, without any padding.
+
+	File header:
+		char8[8]	magic - "VCSBLOG1"
+		sint64	wall-clock anchor [ns since 1.1.1970 UTC]...
+		uint64	...and the monotonic reading it corresponds to (see CLogClock)
+
+	Followed by chunks, each starting with a tag byte (E_LogBinaryChunks):
+		'F'	uint16 format id, uint16 length, format string (no terminator)
+		'R'	uint8 message type, uint64 monotonic timestamp, uint16 format id,
+			uint16 length, data
+
+	Record data holds arguments packed by CLogFormat::Pack(), or plain text if
+	format id is LOG_BINARY_TEXT_FORMAT. A format chunk always precedes the first
+	record using it.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Tags of binary log chunks.
+		enum E_LogBinaryChunks
+		{
+			LBC_Format = 'F',	//!< Format string definition.
+			LBC_Record = 'R'	//!< Log record.
+		};
+
+		enum
+		{
+			LOG_BINARY_MAGIC_SIZE = 8,	//!< Length of file magic.
+			LOG_BINARY_HEADER_SIZE = LOG_BINARY_MAGIC_SIZE + 16,	//!< Size of file header.
+			LOG_BINARY_FORMAT_HEADER_SIZE = 5,	//!< Size of format chunk, not counting the string.
+			LOG_BINARY_RECORD_HEADER_SIZE = 14,	//!< Size of record chunk, not counting data.
+			LOG_BINARY_TEXT_FORMAT = 0,	//!< Format id of records holding plain text.
+			LOG_BINARY_MAX_FORMAT = 0xFFFF	//!< Format ids are 1 ... LOG_BINARY_MAX_FORMAT.
+		};
+
+		//! Magic bytes starting every binary log; bump the digit when layout changes.
+		static const char8 LOG_BINARY_MAGIC[LOG_BINARY_MAGIC_SIZE + 1] = "VCSBLOG1";
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_BINARY_H__
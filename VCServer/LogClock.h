@@ -0,0 +1,182 @@
+#ifndef __TRC_VCS_LOG_CLOCK_H__
+#define __TRC_VCS_LOG_CLOCK_H__
+
+/*!
+\file LogClock.h
+\brief Timestamp source for log records.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Records are stamped with a raw monotonic clock reading (QueryPerformanceCounter
+	or CLOCK_MONOTONIC), which is cheap and thread-safe. Turning it into wall-clock
+	text is deferred to whoever writes the record out. The clock remembers which
+	wall-clock moment corresponds to which monotonic reading, so later wall-clock
+	adjustments don't make the log jump back and forth.
+
+	Breaking a time down into hours/minutes/seconds is the expensive part, so it's
+	done at most once per second per thread; only sub-second digits are formatted
+	for every record.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <time.h>
+
+#ifdef WIN32
+	#include <windows.h>
+#endif //WIN32
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Monotonic nanosecond clock, formattable as local wall-clock time.
+		class CLogClock
+		{
+		protected:
+			sint64 wallAnchor;	//!< Wall-clock time [ns since 1.1.1970 UTC]...
+			uint64 monotonicAnchor;	//!< ...at this monotonic reading.
+
+			//! \brief Reads wall-clock time.
+			//! \return Returns nanoseconds since 1.1.1970 UTC.
+			static sint64 WallNow()
+			{
+			#ifdef WIN32
+				FILETIME fileTime;	//100 ns units since 1.1.1601
+				GetSystemTimeAsFileTime(&fileTime);
+				sint64 ticks = ((sint64)fileTime.dwHighDateTime << 32) | fileTime.dwLowDateTime;
+				return (ticks - 116444736000000000LL) * 100;	//shift epoch to 1970
+			#else //WIN32
+				struct timespec now;
+				clock_gettime(CLOCK_REALTIME, &now);
+				return (sint64)now.tv_sec * 1000000000LL + now.tv_nsec;
+			#endif //WIN32
+			}
+
+		public:
+			enum
+			{
+				TEXT_SIZE = 16	//!< Buffer size needed by Format(): "hh:mm:ss.uuuuuu" + '\0'.
+			};
+
+			//! \brief Constructor; anchors the monotonic clock to the current wall-clock time.
+			CLogClock()
+			{
+				Anchor();
+			}
+
+			//! \brief Constructor; restores clock anchored elsewhere, eg. by the process that wrote a log.
+			//! \param _wallAnchor: Value of GetWallAnchor().
+			//! \param _monotonicAnchor: Value of GetMonotonicAnchor().
+			CLogClock(sint64 _wallAnchor, uint64 _monotonicAnchor):wallAnchor(_wallAnchor), monotonicAnchor(_monotonicAnchor){}
+
+			//! \brief Returns wall-clock time [ns since 1.1.1970 UTC] at GetMonotonicAnchor().
+			sint64 GetWallAnchor() const { return wallAnchor; }
+
+			//! \brief Returns monotonic reading taken when the clock was anchored.
+			uint64 GetMonotonicAnchor() const { return monotonicAnchor; }
+
+			//! \brief Re-reads wall-clock time, eg. after the system clock was adjusted.
+			void Anchor()
+			{
+				monotonicAnchor = Now();
+				wallAnchor = WallNow();
+			}
+
+			//! \brief Reads monotonic clock.
+			//! \return Returns nanoseconds since some unspecified moment.
+			static uint64 Now()
+			{
+			#ifdef WIN32
+				static LARGE_INTEGER frequency = { 0 };	//ticks per second; racing on it is harmless
+				if(frequency.QuadPart == 0)
+				{
+					QueryPerformanceFrequency(&frequency);
+				}
+
+				LARGE_INTEGER counter;
+				QueryPerformanceCounter(&counter);
+
+				//split to avoid overflowing 64 bits
+				uint64 seconds = counter.QuadPart / frequency.QuadPart;
+				uint64 remainder = counter.QuadPart % frequency.QuadPart;
+				return seconds * 1000000000ULL + (remainder * 1000000000ULL) / frequency.QuadPart;
+			#else //WIN32
+				struct timespec now;
+				clock_gettime(CLOCK_MONOTONIC, &now);
+				return (uint64)now.tv_sec * 1000000000ULL + now.tv_nsec;
+			#endif //WIN32
+			}
+
+			//! \brief Converts monotonic reading to wall-clock time.
+			//! \return Returns nanoseconds since 1.1.1970 UTC.
+			sint64 ToWallTime(uint64 timestamp) const
+			{
+				return wallAnchor + (sint64)(timestamp - monotonicAnchor);
+			}
+
+			//! \brief Formats monotonic reading as local time: "hh:mm:ss.uuuuuu".
+			//! \param timestamp: Value returned by Now().
+			//! \param text: Receives NUL-terminated text; at least TEXT_SIZE characters.
+			//! \return Returns length of the text.
+			//!
+			//! Thread-safe; every thread keeps its own per-second cache.
+			uint32 Format(uint64 timestamp, char8* text) const
+			{
+				static VCS_THREAD_LOCAL sint64 cachedSecond = -1;	//wall-clock second described by cachedPrefix
+				static VCS_THREAD_LOCAL char8 cachedPrefix[8];	//"hh:mm:ss"
+
+				sint64 wall = ToWallTime(timestamp);
+				sint64 second = wall / 1000000000LL;
+				uint32 micros = (uint32)((wall % 1000000000LL) / 1000);
+
+				if(second != cachedSecond)
+				{
+					time_t seconds = (time_t)second;
+					struct tm local;
+				#ifdef WIN32
+					localtime_s(&local, &seconds);
+				#else //WIN32
+					localtime_r(&seconds, &local);
+				#endif //WIN32
+					cachedPrefix[0] = (char8)('0' + local.tm_hour / 10);
+					cachedPrefix[1] = (char8)('0' + local.tm_hour % 10);
+					cachedPrefix[2] = ':';
+					cachedPrefix[3] = (char8)('0' + local.tm_min / 10);
+					cachedPrefix[4] = (char8)('0' + local.tm_min % 10);
+					cachedPrefix[5] = ':';
+					cachedPrefix[6] = (char8)('0' + local.tm_sec / 10);
+					cachedPrefix[7] = (char8)('0' + local.tm_sec % 10);
+					cachedSecond = second;
+				}
+
+				for(uint32 i = 0 ; i < 8 ; ++i)
+				{
+					text[i] = cachedPrefix[i];
+				}
+				text[8] = '.';
+				for(sint32 i = 14 ; i > 8 ; --i)
+				{
+					text[i] = (char8)('0' + micros % 10);
+					micros /= 10;
+				}
+				text[15] = '\0';
+				return 15;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_CLOCK_H__
@@ -0,0 +1,149 @@
+#ifndef __TRC_VCS_LOG_FILE_BUFFER_H__
+#define __TRC_VCS_LOG_FILE_BUFFER_H__
+
+/*!
+\file LogFileBuffer.h
+\brief Write buffer in front of a log file.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Shared by file log outputs. With a non-zero buffer size, data is coalesced in memory
+	and written out when the buffer fills up, when its oldest byte gets older than
+	the flush interval, or on Flush().
+
+	File I/O goes through CLogFile, picked at build time: LogFile_WinAPI.h on Windows,
+	LogFile_POSIX.h elsewhere.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <string.h>
+
+#include "Logger.h"
+#include "LogClock.h"
+
+#ifdef WIN32
+	#include "LogFile_WinAPI.h"
+#else //WIN32
+	#include "LogFile_POSIX.h"
+#endif //WIN32
+
+#include <boost/noncopyable.hpp>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Log file with an optional write buffer.
+		class CLogFileBuffer : private boost::noncopyable
+		{
+		protected:
+			CLogFile file;	//!< Output file.
+			char8* buffer;	//!< Data awaiting write; NULL if unbuffered.
+			uint32 bufferSize;	//!< Capacity of buffer.
+			uint32 bufferUsed;	//!< Count of bytes in buffer.
+			uint64 bufferedSince;	//!< CLogClock::Now() when the oldest buffered byte was added.
+			uint64 flushInterval;	//!< Max age of buffered data [ns].
+
+		public:
+			//! \brief Constructor.
+			//! \param _bufferSize: Size of write buffer; 0 writes everything immediately.
+			//! \param _flushInterval: Max time [ms] data may spend in the write buffer,
+			//!			as checked when next piece of data is written.
+			CLogFileBuffer(uint32 _bufferSize, uint32 _flushInterval)
+				:buffer(NULL), bufferSize(_bufferSize), bufferUsed(0),
+				bufferedSince(0), flushInterval((uint64)_flushInterval * 1000000)
+			{
+				if(bufferSize > 0)
+				{
+					buffer = new char8[bufferSize];
+				}
+			}
+			~CLogFileBuffer(){ delete [] buffer; }	//!< D-tor.
+
+			//! \brief Creates (or truncates) the file and opens it for writing.
+			//! \return Returns true if file is open; false otherwise.
+			bool Open(const std::string& name)
+			{
+				bufferUsed = 0;
+				return file.Open(name);
+			}
+
+			//! \brief Writes buffered data out and closes the file.
+			void Close()
+			{
+				Flush();
+				file.Close();
+			}
+
+			//! \brief Passes data to the file, through the write buffer if there's one.
+			void Output(const char8* text, uint32 length)
+			{
+				if(buffer == NULL)
+				{
+					SLogText piece(text, length);
+					file.Write(&piece, 1);
+					return;
+				}
+
+				if(bufferUsed + length > bufferSize)
+				{
+					if(length > bufferSize)
+					{
+						//won't fit at all - write it together with whatever is buffered
+						SLogText pieces[2] = { SLogText(buffer, bufferUsed), SLogText(text, length) };
+						file.Write(pieces, 2);
+						bufferUsed = 0;
+						return;
+					}
+					Flush();
+				}
+
+				uint64 now = CLogClock::Now();
+				if(bufferUsed == 0)
+				{
+					bufferedSince = now;
+				}
+				memcpy(buffer + bufferUsed, text, length);
+				bufferUsed += length;
+
+				if(now - bufferedSince >= flushInterval)
+				{
+					Flush();
+				}
+			}
+
+			//! \brief Writes buffered data out.
+			void Flush()
+			{
+				if(bufferUsed > 0)
+				{
+					SLogText piece(buffer, bufferUsed);
+					file.Write(&piece, 1);
+					bufferUsed = 0;
+				}
+			}
+
+			//! \brief Forces written data down to the disk.
+			void Sync()
+			{
+				file.Sync();
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_FILE_BUFFER_H__
@@ -0,0 +1,237 @@
+#ifndef __TRC_VCS_LOG_FILE_POSIX_H__
+#define __TRC_VCS_LOG_FILE_POSIX_H__
+
+/*!
+\file LogFile_POSIX.h
+\brief Log file backend using POSIX file I/O.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Don't include directly - LogFileBuffer.h picks the backend for the platform.
+	See LogFile_WinAPI.h for the other one; both provide the same CLogFile and CLogMappedFile interfaces.
+
+	The file is opened with O_APPEND, and batches of pieces go out in a single
+	writev() call.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Logger.h"
+
+#ifndef IOV_MAX
+	#define IOV_MAX 16	//minimum guaranteed by POSIX
+#endif //IOV_MAX
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Write-only log file, POSIX flavour.
+		class CLogFile
+		{
+		protected:
+			enum
+			{
+				MAX_PIECES = (IOV_MAX < 64) ? IOV_MAX : 64	//!< Max count of pieces per writev().
+			};
+
+			int fd;	//!< File descriptor.
+
+		public:
+			CLogFile():fd(-1){}	//!< Default c-tor.
+			~CLogFile(){ Close(); }	//!< D-tor.
+
+			//! \brief Creates (or truncates) the file and opens it for writing.
+			//! \return Returns true if file is open; false otherwise.
+			bool Open(const std::string& name)
+			{
+				Close();
+				fd = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+				return (fd != -1);
+			}
+
+			//! \brief Closes the file.
+			void Close()
+			{
+				if(fd != -1)
+				{
+					close(fd);
+					fd = -1;
+				}
+			}
+
+			//! \brief Writes pieces of text, one after another.
+			void Write(const SLogText* pieces, uint32 count)
+			{
+				while(count > 0)
+				{
+					struct iovec vectors[MAX_PIECES];
+					uint32 batch = (count < MAX_PIECES) ? count : MAX_PIECES;
+					size_t total = 0;
+					for(uint32 i = 0 ; i < batch ; ++i)
+					{
+						vectors[i].iov_base = (void*)pieces[i].text;
+						vectors[i].iov_len = pieces[i].length;
+						total += pieces[i].length;
+					}
+
+					ssize_t written = writev(fd, vectors, batch);
+					if(written < 0 && errno == EINTR)
+					{
+						continue;
+					}
+					if(written >= 0 && (size_t)written < total)
+					{
+						//short write - finish the batch piece by piece
+						FinishShortWrite(vectors, batch, written);
+					}
+
+					pieces += batch;
+					count -= batch;
+				}
+			}
+
+			//! \brief Forces written data down to the disk.
+			void Sync()
+			{
+			#if defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0
+				fdatasync(fd);
+			#else
+				fsync(fd);
+			#endif
+			}
+
+		protected:
+			//! \brief Writes whatever a short writev() has left.
+			void FinishShortWrite(struct iovec* vectors, uint32 count, ssize_t written)
+			{
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					const char8* text = (const char8*)vectors[i].iov_base;
+					size_t length = vectors[i].iov_len;
+					if((size_t)written >= length)
+					{
+						written -= length;	//this piece made it
+						continue;
+					}
+
+					text += written;
+					length -= written;
+					written = 0;
+					while(length > 0)
+					{
+						ssize_t result = write(fd, text, length);
+						if(result < 0)
+						{
+							if(errno == EINTR)
+							{
+								continue;
+							}
+							return;	//nothing sensible to do - a log can't log its own failure
+						}
+						text += result;
+						length -= result;
+					}
+				}
+			}
+		};
+
+		//! \brief Fixed-size file mapped into memory, POSIX flavour.
+		class CLogMappedFile
+		{
+		protected:
+			int fd;	//!< File descriptor.
+			char8* memory;	//!< Mapped view of the file.
+			uint32 size;	//!< Size of the file and the view.
+
+		public:
+			CLogMappedFile():fd(-1), memory(NULL), size(0){}	//!< Default c-tor.
+			~CLogMappedFile(){ Close(); }	//!< D-tor.
+
+			//! \brief Opens (or creates) the file, resizes it and maps it into memory.
+			//! \return Returns true if file is mapped; false otherwise.
+			//!
+			//! Existing contents are kept, as far as they fit.
+			bool Open(const std::string& name, uint32 _size)
+			{
+				Close();
+				fd = open(name.c_str(), O_RDWR | O_CREAT, 0644);
+				if(fd == -1)
+				{
+					return false;
+				}
+
+				struct stat info;
+				if( (fstat(fd, &info) != 0 || info.st_size != (off_t)_size) && ftruncate(fd, _size) != 0 )
+				{
+					Close();
+					return false;
+				}
+
+				void* view = mmap(NULL, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+				if(view == MAP_FAILED)
+				{
+					Close();
+					return false;
+				}
+				memory = (char8*)view;
+				size = _size;
+				return true;
+			}
+
+			//! \brief Unmaps and closes the file.
+			void Close()
+			{
+				if(memory)
+				{
+					munmap(memory, size);
+					memory = NULL;
+					size = 0;
+				}
+				if(fd != -1)
+				{
+					close(fd);
+					fd = -1;
+				}
+			}
+
+			//! \brief Returns mapped memory; NULL if file isn't open.
+			char8* GetMemory() const { return memory; }
+
+			//! \brief Returns size of mapped memory.
+			uint32 GetSize() const { return size; }
+
+			//! \brief Forces modified pages down to the disk.
+			void Sync()
+			{
+				if(memory)
+				{
+					msync(memory, size, MS_SYNC);
+				}
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_FILE_POSIX_H__
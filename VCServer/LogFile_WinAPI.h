@@ -0,0 +1,175 @@
+#ifndef __TRC_VCS_LOG_FILE_WINAPI_H__
+#define __TRC_VCS_LOG_FILE_WINAPI_H__
+
+/*!
+\file LogFile_WinAPI.h
+\brief Log file backend using WinAPI file I/O.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Don't include directly - LogFileBuffer.h picks the backend for the platform.
+	See LogFile_POSIX.h for the other one; both provide the same CLogFile and CLogMappedFile interfaces.
+
+	WriteFileGather() needs unbuffered, sector-aligned I/O, which doesn't fit a log,
+	so batches of pieces are written with consecutive WriteFile() calls.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <windows.h>
+
+#include "Logger.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Write-only log file, WinAPI flavour.
+		class CLogFile
+		{
+		protected:
+			HANDLE hFile;	//!< WinAPI handle to the file.
+
+		public:
+			CLogFile():hFile(INVALID_HANDLE_VALUE){}	//!< Default c-tor.
+			~CLogFile(){ Close(); }	//!< D-tor.
+
+			//! \brief Creates (or truncates) the file and opens it for writing.
+			//! \return Returns true if file is open; false otherwise.
+			bool Open(const std::string& name)
+			{
+				Close();
+				hFile = CreateFile(name.c_str(), GENERIC_WRITE, FILE_SHARE_READ , NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+				return (hFile != INVALID_HANDLE_VALUE);
+			}
+
+			//! \brief Closes the file.
+			void Close()
+			{
+				if(hFile != INVALID_HANDLE_VALUE)
+				{
+					CloseHandle(hFile);
+					hFile = INVALID_HANDLE_VALUE;
+				}
+			}
+
+			//! \brief Writes pieces of text, one after another.
+			void Write(const SLogText* pieces, uint32 count)
+			{
+				DWORD dwTemp;
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					WriteFile(hFile, pieces[i].text, pieces[i].length, &dwTemp, NULL);
+				}
+			}
+
+			//! \brief Forces written data down to the disk.
+			void Sync()
+			{
+				FlushFileBuffers(hFile);
+			}
+		};
+
+		//! \brief Fixed-size file mapped into memory, WinAPI flavour.
+		class CLogMappedFile
+		{
+		protected:
+			HANDLE hFile;	//!< WinAPI handle to the file.
+			HANDLE hMapping;	//!< File mapping object.
+			char8* memory;	//!< Mapped view of the file.
+			uint32 size;	//!< Size of the file and the view.
+
+		public:
+			CLogMappedFile():hFile(INVALID_HANDLE_VALUE), hMapping(NULL), memory(NULL), size(0){}	//!< Default c-tor.
+			~CLogMappedFile(){ Close(); }	//!< D-tor.
+
+			//! \brief Opens (or creates) the file, resizes it and maps it into memory.
+			//! \return Returns true if file is mapped; false otherwise.
+			//!
+			//! Existing contents are kept, as far as they fit.
+			bool Open(const std::string& name, uint32 _size)
+			{
+				Close();
+				hFile = CreateFile(name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+				if(hFile == INVALID_HANDLE_VALUE)
+				{
+					return false;
+				}
+
+				//CreateFileMapping() grows the file, but never shrinks it
+				if(GetFileSize(hFile, NULL) != _size)
+				{
+					SetFilePointer(hFile, _size, NULL, FILE_BEGIN);
+					SetEndOfFile(hFile);
+				}
+
+				hMapping = CreateFileMapping(hFile, NULL, PAGE_READWRITE, 0, _size, NULL);
+				if(hMapping == NULL)
+				{
+					Close();
+					return false;
+				}
+				memory = (char8*)MapViewOfFile(hMapping, FILE_MAP_WRITE, 0, 0, _size);
+				if(memory == NULL)
+				{
+					Close();
+					return false;
+				}
+				size = _size;
+				return true;
+			}
+
+			//! \brief Unmaps and closes the file.
+			void Close()
+			{
+				if(memory)
+				{
+					UnmapViewOfFile(memory);
+					memory = NULL;
+					size = 0;
+				}
+				if(hMapping)
+				{
+					CloseHandle(hMapping);
+					hMapping = NULL;
+				}
+				if(hFile != INVALID_HANDLE_VALUE)
+				{
+					CloseHandle(hFile);
+					hFile = INVALID_HANDLE_VALUE;
+				}
+			}
+
+			//! \brief Returns mapped memory; NULL if file isn't open.
+			char8* GetMemory() const { return memory; }
+
+			//! \brief Returns size of mapped memory.
+			uint32 GetSize() const { return size; }
+
+			//! \brief Forces modified pages down to the disk.
+			void Sync()
+			{
+				if(memory)
+				{
+					FlushViewOfFile(memory, size);
+					FlushFileBuffers(hFile);
+				}
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_FILE_WINAPI_H__
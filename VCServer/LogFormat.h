@@ -0,0 +1,494 @@
+#ifndef __TRC_VCS_LOG_FORMAT_H__
+#define __TRC_VCS_LOG_FORMAT_H__
+
+/*!
+\file LogFormat.h
+\brief Packing printf() arguments and rendering them later.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	CLogger::LogF() doesn't format its message - it only copies raw arguments into
+	the record, each prefixed with a one-byte tag (E_LogArgTags). Text is rendered
+	from the format string and packed arguments only if some output needs it; binary
+	outputs store the packed form as is, and LogDecoder renders it offline.
+
+	Supported: all C89 conversions with flags, width, precision ('*' too) and
+	h/hh/l/ll/L/j/z/t/I/I32/I64 length modifiers. Wide strings are packed as pointers.
+	%n is ignored.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Tags of packed printf() arguments.
+		enum E_LogArgTags
+		{
+			LAT_Int32 = 'i',	//!< 4-byte integer.
+			LAT_Int64 = 'l',	//!< 8-byte integer.
+			LAT_Double = 'd',	//!< 8-byte floating point.
+			LAT_String = 's',	//!< uint16 length, then characters; no terminator.
+			LAT_Pointer = 'p'	//!< 8-byte address.
+		};
+
+		//! \brief Single printf() conversion specification.
+		struct SLogFormatSpec
+		{
+			const char8* begin;	//!< '%' starting the spec.
+			const char8* modifier;	//!< First character of length modifier (or conversion, if there's none).
+			const char8* end;	//!< One past the conversion character.
+			char8 conversion;	//!< Conversion character, ie. 'd' or 's'; '%' for "%%".
+			uint32 stars;	//!< Count of '*' (width and precision taken from arguments).
+			uint32 intSize;	//!< Size of integer argument [bytes], as implied by length modifier.
+			bool bLongDouble;	//!< 'L' length modifier.
+			bool bWide;	//!< 'l' with 'c' / 's', or 'C' / 'S' conversion.
+		};
+
+		//! \brief printf() argument packing and rendering.
+		class CLogFormat
+		{
+		protected:
+			enum
+			{
+				MAX_SPEC_SIZE = 32	//!< Longest conversion spec we'll render.
+			};
+
+			//! \brief printf()s into text, truncating output if necessary.
+			//! \return Returns count of characters written, not counting the terminator.
+			static uint32 Print(char8* text, uint32 capacity, const char8* format, ...)
+			{
+				if(capacity == 0)
+				{
+					return 0;
+				}
+
+				va_list args;
+				va_start(args, format);
+			#ifdef _MSC_VER
+				sint32 length = _vsnprintf(text, capacity - 1, format, args);	//returns -1 on truncation...
+				text[capacity - 1] = '\0';	//...and doesn't terminate then
+				va_end(args);
+				return (length < 0) ? (uint32)strlen(text) : (uint32)length;
+			#else //_MSC_VER
+				sint32 length = vsnprintf(text, capacity, format, args);	//returns untruncated length
+				va_end(args);
+				if(length < 0)
+				{
+					text[0] = '\0';
+					return 0;
+				}
+				return ((uint32)length > capacity - 1) ? capacity - 1 : (uint32)length;
+			#endif //_MSC_VER
+			}
+
+			//! \brief Renders a single value, passing width / precision taken from arguments.
+			template <typename T>
+			static uint32 PrintValue(char8* text, uint32 capacity, const char8* spec, uint32 stars, const sint32* starValues, T value)
+			{
+				switch(stars)
+				{
+					case 0:
+						return Print(text, capacity, spec, value);
+					case 1:
+						return Print(text, capacity, spec, starValues[0], value);
+					default:
+						return Print(text, capacity, spec, starValues[0], starValues[1], value);
+				}
+			}
+
+			//! \brief Appends a packed value, if it fits.
+			static bool PutValue(char8* buffer, uint32 capacity, uint32& used, char8 tag, const void* value, uint32 size)
+			{
+				if(used + 1 + size > capacity)
+				{
+					return false;
+				}
+				buffer[used++] = tag;
+				memcpy(buffer + used, value, size);
+				used += size;
+				return true;
+			}
+
+			//! \brief Reads a packed value, if there's one with matching tag.
+			static bool GetValue(const char8* args, uint32 length, uint32& used, char8 tag, void* value, uint32 size)
+			{
+				if(used + 1 + size > length || args[used] != tag)
+				{
+					return false;
+				}
+				memcpy(value, args + used + 1, size);
+				used += 1 + size;
+				return true;
+			}
+
+		public:
+			//! \brief Finds next conversion spec.
+			//! \param cursor: Position in format string; moved past the spec found.
+			//! \param spec: Receives the spec.
+			//! \return Returns false if there are no more specs.
+			static bool NextSpec(const char8*& cursor, SLogFormatSpec& spec)
+			{
+				const char8* percent = strchr(cursor, '%');
+				if(percent == NULL)
+				{
+					cursor += strlen(cursor);
+					return false;
+				}
+
+				const char8* p = percent + 1;
+				spec.begin = percent;
+				spec.stars = 0;
+				spec.intSize = sizeof(int);
+				spec.bLongDouble = false;
+				spec.bWide = false;
+
+				//flags, width, precision
+				while(*p && strchr("-+ #0", *p))
+				{
+					++p;
+				}
+				for(uint32 field = 0 ; field < 2 ; ++field)
+				{
+					if(*p == '*')
+					{
+						++spec.stars;
+						++p;
+					}
+					while(*p >= '0' && *p <= '9')
+					{
+						++p;
+					}
+					if(field == 0 && *p == '.')
+					{
+						++p;
+					}
+					else
+					{
+						break;
+					}
+				}
+
+				//length modifier
+				spec.modifier = p;
+				if(p[0] == 'h')
+				{
+					p += (p[1] == 'h') ? 2 : 1;
+				}
+				else if(p[0] == 'l' && p[1] == 'l')
+				{
+					spec.intSize = 8;
+					p += 2;
+				}
+				else if(p[0] == 'l')
+				{
+					spec.intSize = sizeof(long);
+					spec.bWide = true;	//matters only for 'c' and 's'
+					++p;
+				}
+				else if(p[0] == 'I' && p[1] == '6' && p[2] == '4')
+				{
+					spec.intSize = 8;
+					p += 3;
+				}
+				else if(p[0] == 'I' && p[1] == '3' && p[2] == '2')
+				{
+					spec.intSize = 4;
+					p += 3;
+				}
+				else if(p[0] == 'I' || p[0] == 'z' || p[0] == 't')
+				{
+					spec.intSize = sizeof(size_t);
+					++p;
+				}
+				else if(p[0] == 'j' || p[0] == 'q')
+				{
+					spec.intSize = 8;
+					++p;
+				}
+				else if(p[0] == 'L')
+				{
+					spec.bLongDouble = true;
+					++p;
+				}
+
+				spec.conversion = *p;
+				if(*p)
+				{
+					++p;
+				}
+				spec.bWide = (spec.bWide && (spec.conversion == 'c' || spec.conversion == 's'))
+					|| spec.conversion == 'C' || spec.conversion == 'S';
+				spec.end = p;
+				cursor = p;
+				return true;
+			}
+
+			//! \brief Copies printf() arguments into a buffer.
+			//! \param buffer: Receives tagged arguments.
+			//! \param capacity: Size of buffer.
+			//! \param format: printf() format string.
+			//! \param args: Arguments matching format.
+			//! \return Returns count of bytes used.
+			//!
+			//! Strings are truncated to fit; arguments that don't fit at all are dropped
+			//! and rendered as "<?>".
+			static uint32 Pack(char8* buffer, uint32 capacity, const char8* format, va_list args)
+			{
+				uint32 used = 0;
+				bool bFull = false;
+				const char8* cursor = format;
+				SLogFormatSpec spec;
+				while(NextSpec(cursor, spec))
+				{
+					for(uint32 i = 0 ; i < spec.stars ; ++i)
+					{
+						sint32 value = va_arg(args, int);
+						bFull = bFull || !PutValue(buffer, capacity, used, LAT_Int32, &value, sizeof(value));
+					}
+
+					switch(spec.conversion)
+					{
+						case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+						{
+							if(spec.bWide && spec.conversion == 'c')
+							{
+								sint32 value = va_arg(args, int);	//wint_t is promoted to int
+								bFull = bFull || !PutValue(buffer, capacity, used, LAT_Int32, &value, sizeof(value));
+							}
+							else if(spec.intSize == 8)
+							{
+								sint64 value = va_arg(args, sint64);
+								bFull = bFull || !PutValue(buffer, capacity, used, LAT_Int64, &value, sizeof(value));
+							}
+							else
+							{
+								sint32 value = va_arg(args, int);
+								bFull = bFull || !PutValue(buffer, capacity, used, LAT_Int32, &value, sizeof(value));
+							}
+							break;
+						}
+						case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+						{
+							float64 value = spec.bLongDouble ? (float64)va_arg(args, long double) : va_arg(args, double);
+							bFull = bFull || !PutValue(buffer, capacity, used, LAT_Double, &value, sizeof(value));
+							break;
+						}
+						case 's': case 'S':
+						{
+							if(spec.bWide)
+							{
+								uint64 value = (uint64)(size_t)va_arg(args, void*);
+								bFull = bFull || !PutValue(buffer, capacity, used, LAT_Pointer, &value, sizeof(value));
+								break;
+							}
+
+							const char8* text = va_arg(args, const char8*);
+							if(text == NULL)
+							{
+								text = "(null)";
+							}
+							size_t length = strlen(text);
+							if(bFull || used + 3 > capacity)
+							{
+								bFull = true;
+								break;
+							}
+							if(length > capacity - used - 3)
+							{
+								length = capacity - used - 3;	//truncate rather than drop
+							}
+							uint16 length16 = (uint16)((length > 0xFFFF) ? 0xFFFF : length);
+							buffer[used++] = LAT_String;
+							memcpy(buffer + used, &length16, sizeof(length16));
+							memcpy(buffer + used + sizeof(length16), text, length16);
+							used += sizeof(length16) + length16;
+							break;
+						}
+						case 'p': case 'C':
+						{
+							uint64 value = (spec.conversion == 'C') ? (uint64)va_arg(args, int) : (uint64)(size_t)va_arg(args, void*);
+							bFull = bFull || !PutValue(buffer, capacity, used, (spec.conversion == 'C') ? LAT_Int32 : LAT_Pointer,
+								&value, (spec.conversion == 'C') ? 4 : sizeof(value));
+							break;
+						}
+						case 'n':
+						{
+							va_arg(args, void*);	//never write through it
+							break;
+						}
+						default:
+						{
+							break;	//"%%" or garbage - nothing to pack
+						}
+					}
+				}
+				return used;
+			}
+
+			//! \brief Renders message from format and packed arguments.
+			//! \param text: Receives NUL-terminated message.
+			//! \param capacity: Size of text.
+			//! \param format: printf() format string, as passed to Pack().
+			//! \param args: Packed arguments, as returned by Pack().
+			//! \param length: Count of bytes in args.
+			//! \return Returns length of the message.
+			static uint32 Render(char8* text, uint32 capacity, const char8* format, const char8* args, uint32 length)
+			{
+				if(capacity == 0)
+				{
+					return 0;
+				}
+
+				uint32 written = 0;
+				uint32 used = 0;
+				const char8* cursor = format;
+				const char8* literal = format;
+				SLogFormatSpec spec;
+				for(;;)
+				{
+					bool bSpec = NextSpec(cursor, spec);
+
+					//copy text preceding the spec
+					const char8* literalEnd = bSpec ? spec.begin : cursor;
+					uint32 literalLength = (uint32)(literalEnd - literal);
+					if(literalLength > capacity - 1 - written)
+					{
+						literalLength = capacity - 1 - written;
+					}
+					memcpy(text + written, literal, literalLength);
+					written += literalLength;
+					literal = cursor;
+
+					if(!bSpec)
+					{
+						break;
+					}
+
+					char8* out = text + written;
+					uint32 room = capacity - written;
+					if(spec.conversion == '%')
+					{
+						written += Print(out, room, "%%");
+						continue;
+					}
+					if(spec.conversion == 'n' || (uint32)(spec.end - spec.begin) > MAX_SPEC_SIZE - 4)
+					{
+						continue;
+					}
+
+					sint32 starValues[2] = { 0, 0 };
+					bool bOk = true;
+					for(uint32 i = 0 ; i < spec.stars && i < 2 ; ++i)
+					{
+						bOk = bOk && GetValue(args, length, used, LAT_Int32, &starValues[i], sizeof(sint32));
+					}
+
+					//rebuild the spec with a length modifier matching what was packed
+					char8 specText[MAX_SPEC_SIZE];
+					uint32 prefixLength = (uint32)(spec.modifier - spec.begin);
+					memcpy(specText, spec.begin, prefixLength);
+					char8* specEnd = specText + prefixLength;
+
+					sint32 int32Value;
+					sint64 int64Value;
+					float64 doubleValue;
+					uint64 pointerValue;
+					uint16 stringLength;
+					if(!bOk || used >= length)
+					{
+						written += Print(out, room, "<?>");
+					}
+					else if(args[used] == LAT_Int32 && GetValue(args, length, used, LAT_Int32, &int32Value, sizeof(int32Value)))
+					{
+						char8 conversion = (spec.conversion == 'C') ? 'c' : spec.conversion;
+						specEnd[0] = conversion;
+						specEnd[1] = '\0';
+						written += PrintValue(out, room, specText, spec.stars, starValues, (int)int32Value);
+					}
+					else if(args[used] == LAT_Int64 && GetValue(args, length, used, LAT_Int64, &int64Value, sizeof(int64Value)))
+					{
+						specEnd[0] = 'l';
+						specEnd[1] = 'l';
+						specEnd[2] = spec.conversion;
+						specEnd[3] = '\0';
+						written += PrintValue(out, room, specText, spec.stars, starValues, (long long)int64Value);
+					}
+					else if(args[used] == LAT_Double && GetValue(args, length, used, LAT_Double, &doubleValue, sizeof(doubleValue)))
+					{
+						specEnd[0] = spec.conversion;
+						specEnd[1] = '\0';
+						written += PrintValue(out, room, specText, spec.stars, starValues, doubleValue);
+					}
+					else if(args[used] == LAT_Pointer && GetValue(args, length, used, LAT_Pointer, &pointerValue, sizeof(pointerValue)))
+					{
+						specEnd[0] = 'p';
+						specEnd[1] = '\0';
+						written += PrintValue(out, room, specText, spec.stars, starValues, (void*)(size_t)pointerValue);
+					}
+					else if(args[used] == LAT_String && used + 1 + sizeof(stringLength) <= length)
+					{
+						memcpy(&stringLength, args + used + 1, sizeof(stringLength));
+						const char8* string = args + used + 1 + sizeof(stringLength);
+						if(used + 1 + sizeof(stringLength) + stringLength > length)
+						{
+							used = length;	//corrupt - give up on the rest
+							written += Print(out, room, "<?>");
+							continue;
+						}
+						used += 1 + sizeof(stringLength) + stringLength;
+
+						//render length-limited string; width pads it, precision caps it
+						if(prefixLength == 1)	//plain %s
+						{
+							written += Print(out, room, "%.*s", (int)stringLength, string);
+						}
+						else
+						{
+							specEnd[0] = 's';
+							specEnd[1] = '\0';
+
+							char8 copy[LOG_FORMAT_STRING_SIZE];
+							uint32 copyLength = (stringLength < LOG_FORMAT_STRING_SIZE - 1) ? stringLength : LOG_FORMAT_STRING_SIZE - 1;
+							memcpy(copy, string, copyLength);
+							copy[copyLength] = '\0';
+							written += PrintValue(out, room, specText, spec.stars, starValues, (const char8*)copy);
+						}
+					}
+					else
+					{
+						used = length;	//tag doesn't match the spec - give up on the rest
+						written += Print(out, room, "<?>");
+					}
+				}
+
+				text[written] = '\0';
+				return written;
+			}
+
+			enum
+			{
+				LOG_FORMAT_STRING_SIZE = 512	//!< Longest string argument rendered with width / precision.
+			};
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_FORMAT_H__
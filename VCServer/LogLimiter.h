@@ -0,0 +1,373 @@
+#ifndef __TRC_VCS_LOG_LIMITER_H__
+#define __TRC_VCS_LOG_LIMITER_H__
+
+/*!
+\file LogLimiter.h
+\brief Rate limiting and sampling of repetitive log messages.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Messages are grouped by key: the format string for printf-style messages
+	(so, in practice, the call site), the text itself for plain ones. Every key
+	may let a burst of records through per interval; past the burst only every
+	n-th record passes (or none). Whatever was held back is reported with a
+	"similar messages suppressed" summary once the interval is over.
+
+	Keys are tracked in a fixed table - no allocations while logging. If the table
+	is crowded, records of new keys simply pass. Admit() doesn't lock when the key
+	already has a slot and its interval is running (or the key isn't limited at
+	all): slot counters are atomic. The mutex is taken only to claim a slot, to
+	start a new interval and to change limits - about once per key per interval.
+	A record racing with SetLimit() or slot reuse may be judged by a stale limit;
+	that's harmless here.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+#include "Atomic.h"
+
+#include <map>
+#include <string.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Limit for records sharing a key.
+		struct SLogLimit
+		{
+			uint32 burst;	//!< Records let through per interval; 0 means no limit.
+			uint32 interval;	//!< Length of interval [ms].
+			uint32 sampleRate;	//!< Past the burst, every sampleRate-th record still passes; 0 lets none.
+
+			SLogLimit(uint32 _burst = 0, uint32 _interval = 1000, uint32 _sampleRate = 0)
+				:burst(_burst), interval(_interval), sampleRate(_sampleRate){}
+		};
+
+		enum
+		{
+			LOG_LIMIT_SAMPLE_SIZE = 64	//!< Max length of key text quoted in summaries.
+		};
+
+		//! \brief Summary of records held back for a key.
+		struct SLogSuppression
+		{
+			uint32 msgType;	//!< Type of the last suppressed record.
+			uint32 count;	//!< Count of suppressed records.
+			char8 sample[LOG_LIMIT_SAMPLE_SIZE];	//!< Beginning of key text, NUL-terminated.
+		};
+
+		//! \brief Per-key rate limiter for log records.
+		class CLogLimiter : private boost::noncopyable
+		{
+		protected:
+			enum
+			{
+				SLOT_COUNT = 256,	//!< Count of keys tracked at once; power of two.
+				MAX_PROBES = 8,	//!< Slots checked for a key before giving up.
+				STALE_INTERVALS = 4	//!< Slot idle for that many intervals may be reused.
+			};
+
+			//! \brief State of a single key.
+			struct SSlot
+			{
+				atomic32 ready;	//!< Are key, limit and sample set up? 0 marks an empty slot.
+				uint64 key;	//!< Hash of key text.
+				SLogLimit limit;	//!< Limit for this key.
+				atomic32 windowStart;	//!< When [ms, lower 32 bits] current interval began.
+				atomic32 passed;	//!< Records checked against the burst in current interval.
+				atomic32 seen;	//!< Records past the burst in current interval.
+				atomic32 suppressed;	//!< Records held back since last summary.
+				atomic32 msgType;	//!< Type of the last suppressed record.
+				char8 sample[LOG_LIMIT_SAMPLE_SIZE];	//!< Beginning of key text.
+			};
+
+			typedef std::map<uint64, SLogLimit> limitMap_t;	//!< Type of per-key limit map.
+
+			SSlot slots[SLOT_COUNT];	//!< Tracked keys.
+			limitMap_t limits;	//!< Limits set for particular keys.
+			SLogLimit defaultLimit;	//!< Limit for other keys.
+			atomic32 nextSweep;	//!< When [ms, lower 32 bits] the next CollectSummaries() sweep is due.
+			atomic32 active;	//!< Is any limit set?
+			atomic32 totalSuppressed;	//!< Records held back so far.
+			boost::mutex mutex;	//!< Serializes claiming slots, starting intervals and changing limits.
+
+			//! \brief Hashes key text (64-bit FNV-1a).
+			//! \return Returns hash; never 0.
+			static uint64 Hash(const char8* text, uint32 length)
+			{
+				uint64 hash = 14695981039346656037ULL;
+				for(uint32 i = 0 ; i < length ; ++i)
+				{
+					hash ^= (uint8)text[i];
+					hash *= 1099511628211ULL;
+				}
+				return hash ? hash : 1;
+			}
+
+			//! \brief Converts CLogClock::Now() to milliseconds, wrapping around.
+			static uint32 ToMs(uint64 now)
+			{
+				return (uint32)(now / 1000000);
+			}
+
+			//! \brief Returns milliseconds elapsed since slot's interval began.
+			static uint32 WindowAge(const SSlot& slot, uint64 now)
+			{
+				return ToMs(now) - (uint32)AtomicLoad(&slot.windowStart);
+			}
+
+			//! \brief Checks if slot's interval is over.
+			static bool WindowOver(const SSlot& slot, uint64 now)
+			{
+				return ( WindowAge(slot, now) >= slot.limit.interval );
+			}
+
+			//! \brief Moves slot's suppressed count into a summary.
+			static void TakeSummary(SSlot& slot, SLogSuppression& summary)
+			{
+				summary.msgType = AtomicLoad(&slot.msgType);
+				summary.count = AtomicExchange(&slot.suppressed, 0);
+				memcpy(summary.sample, slot.sample, LOG_LIMIT_SAMPLE_SIZE);
+			}
+
+			//! \brief Finds slot of a key without locking.
+			//! \return Returns NULL if the key has no slot yet.
+			SSlot* LookupSlot(uint64 key)
+			{
+				for(uint32 i = 0 ; i < MAX_PROBES ; ++i)
+				{
+					SSlot& slot = slots[(key + i) & (SLOT_COUNT - 1)];
+					if(AtomicLoad(&slot.ready) && slot.key == key)
+					{
+						return &slot;
+					}
+				}
+				return NULL;
+			}
+
+			//! \brief Finds limit for a key; call with mutex locked.
+			const SLogLimit& LimitFor(uint64 key) const
+			{
+				limitMap_t::const_iterator itor = limits.find(key);
+				return (itor != limits.end()) ? (*itor).second : defaultLimit;
+			}
+
+			//! \brief Finds slot of a key, claiming a free or stale one if needed; call with mutex locked.
+			//! \return Returns NULL if the table is too crowded.
+			SSlot* FindSlot(uint64 key, const char8* text, uint32 length, uint64 now)
+			{
+				SSlot* candidate = NULL;
+				for(uint32 i = 0 ; i < MAX_PROBES ; ++i)
+				{
+					SSlot& slot = slots[(key + i) & (SLOT_COUNT - 1)];
+					bool bReady = ( AtomicLoad(&slot.ready) != 0 );
+					if(bReady && slot.key == key)
+					{
+						return &slot;
+					}
+					if(candidate == NULL && ( !bReady
+						|| ( AtomicLoad(&slot.suppressed) == 0 && WindowAge(slot, now) >= STALE_INTERVALS * slot.limit.interval ) ))
+					{
+						candidate = &slot;
+					}
+				}
+
+				if(candidate)
+				{
+					AtomicStore(&candidate->ready, 0);	//hide the slot from LookupSlot() while it changes hands
+					candidate->key = key;
+					candidate->limit = LimitFor(key);
+					AtomicStore(&candidate->windowStart, (sint32)ToMs(now));
+					AtomicStore(&candidate->passed, 0);
+					AtomicStore(&candidate->seen, 0);
+					AtomicStore(&candidate->suppressed, 0);
+					AtomicStore(&candidate->msgType, 0);
+					uint32 sampleLength = (length < LOG_LIMIT_SAMPLE_SIZE) ? length : LOG_LIMIT_SAMPLE_SIZE - 1;
+					memcpy(candidate->sample, text, sampleLength);
+					candidate->sample[sampleLength] = '\0';
+					AtomicStore(&candidate->ready, 1);
+				}
+				return candidate;
+			}
+
+			//! \brief Recalculates active flag; call with mutex locked.
+			void UpdateActive()
+			{
+				bool bActive = (defaultLimit.burst > 0);
+				for(limitMap_t::const_iterator itor = limits.begin() ; itor != limits.end() && !bActive ; ++itor)
+				{
+					bActive = ( (*itor).second.burst > 0 );
+				}
+				AtomicStore(&active, bActive ? 1 : 0);
+			}
+
+		public:
+			enum
+			{
+				SWEEP_INTERVAL = 1000	//!< How often [ms] CollectSummaries() looks for finished intervals.
+			};
+
+			//! Default c-tor; nothing is limited.
+			CLogLimiter()
+			{
+				for(uint32 i = 0 ; i < SLOT_COUNT ; ++i)
+				{
+					AtomicStore(&slots[i].ready, 0);	//FindSlot() sets up the rest when the slot is claimed
+					AtomicStore(&slots[i].suppressed, 0);
+				}
+				AtomicStore(&nextSweep, 0);
+				AtomicStore(&active, 0);
+				AtomicStore(&totalSuppressed, 0);
+			}
+
+			//! \brief Checks if any limit is set; if not, Admit() needn't be called.
+			bool IsActive() const { return ( AtomicLoad(&active) != 0 ); }
+
+			//! \brief Checks, without locking, if CollectSummaries() would look for finished intervals.
+			bool IsSweepDue(uint64 now) const
+			{
+				return ( (sint32)(ToMs(now) - (uint32)AtomicLoad(&nextSweep)) >= 0 );
+			}
+
+			//! \brief Returns count of records held back so far.
+			uint32 GetSuppressedCount() const { return AtomicLoad(&totalSuppressed); }
+
+			//! \brief Sets limit for keys without a limit of their own.
+			void SetDefaultLimit(const SLogLimit& limit)
+			{
+				boost::mutex::scoped_lock lock(mutex);
+				defaultLimit = limit;
+				for(uint32 i = 0 ; i < SLOT_COUNT ; ++i)
+				{
+					if(AtomicLoad(&slots[i].ready))
+					{
+						slots[i].limit = LimitFor(slots[i].key);
+					}
+				}
+				UpdateActive();
+			}
+
+			//! \brief Sets limit for a key.
+			//! \param key: Format string of printf-style messages, or text of plain messages.
+			//! \param limit: The limit; SLogLimit() removes it.
+			void SetLimit(const char8* key, const SLogLimit& limit)
+			{
+				uint64 hash = Hash(key, (uint32)strlen(key));
+				boost::mutex::scoped_lock lock(mutex);
+				limits[hash] = limit;
+				for(uint32 i = 0 ; i < SLOT_COUNT ; ++i)
+				{
+					if(AtomicLoad(&slots[i].ready) && slots[i].key == hash)
+					{
+						slots[i].limit = limit;
+					}
+				}
+				UpdateActive();
+			}
+
+			//! \brief Decides if a record may pass.
+			//! \param msgType: Type of the record.
+			//! \param text: Key text - format string or plain message.
+			//! \param length: Length of text.
+			//! \param now: CLogClock::Now().
+			//! \param summary: Receives summary of the key's previous interval, if it held anything back.
+			//! \param bSummary: Set to true if summary was filled; left alone otherwise.
+			//! \return Returns true if record should be logged.
+			bool Admit(uint32 msgType, const char8* text, uint32 length, uint64 now, SLogSuppression& summary, bool& bSummary)
+			{
+				uint64 key = Hash(text, length);
+
+				SSlot* slot = LookupSlot(key);
+				if(slot && slot->limit.burst == 0)
+				{
+					return true;
+				}
+				if(slot == NULL || WindowOver(*slot, now))
+				{
+					boost::mutex::scoped_lock lock(mutex);
+					slot = FindSlot(key, text, length, now);
+					if(slot == NULL || slot->limit.burst == 0)
+					{
+						return true;
+					}
+					if(WindowOver(*slot, now))	//another thread may have started the interval meanwhile
+					{
+						if(AtomicLoad(&slot->suppressed) > 0)
+						{
+							TakeSummary(*slot, summary);
+							bSummary = true;
+						}
+						AtomicStore(&slot->passed, 0);
+						AtomicStore(&slot->seen, 0);
+						AtomicStore(&slot->windowStart, (sint32)ToMs(now));
+					}
+				}
+
+				SLogLimit limit = slot->limit;
+				if((uint32)AtomicIncrement(&slot->passed) <= limit.burst)
+				{
+					return true;
+				}
+				uint32 seen = (uint32)AtomicIncrement(&slot->seen);
+				if(limit.sampleRate > 0 && seen % limit.sampleRate == 0)
+				{
+					return true;
+				}
+
+				AtomicStore(&slot->msgType, (sint32)msgType);
+				AtomicIncrement(&slot->suppressed);
+				AtomicIncrement(&totalSuppressed);
+				return false;
+			}
+
+			//! \brief Collects summaries of keys whose interval is over.
+			//! \param now: CLogClock::Now().
+			//! \param bAll: Collect every pending summary, even if interval isn't over (ie. at shutdown).
+			//! \param summaries: Receives summaries.
+			//! \param capacity: Size of summaries.
+			//! \return Returns count of summaries collected; call again if it equals capacity.
+			//!
+			//! Unless bAll is set, does nothing if called sooner than SWEEP_INTERVAL after the last sweep.
+			uint32 CollectSummaries(uint64 now, bool bAll, SLogSuppression* summaries, uint32 capacity)
+			{
+				boost::mutex::scoped_lock lock(mutex);
+				if(!bAll && !IsSweepDue(now))
+				{
+					return 0;
+				}
+				AtomicStore(&nextSweep, (sint32)(ToMs(now) + SWEEP_INTERVAL));
+
+				uint32 count = 0;
+				for(uint32 i = 0 ; i < SLOT_COUNT && count < capacity ; ++i)
+				{
+					if(AtomicLoad(&slots[i].suppressed) > 0 && (bAll || WindowOver(slots[i], now)))
+					{
+						TakeSummary(slots[i], summaries[count++]);
+					}
+				}
+				if(count == capacity)
+				{
+					AtomicStore(&nextSweep, (sint32)ToMs(now));	//there may be more - don't wait with the next sweep
+				}
+				return count;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_LIMITER_H__
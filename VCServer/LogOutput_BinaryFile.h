@@ -0,0 +1,195 @@
+#ifndef __TRC_VCS_LOG_OUTPUT_BINARY_FILE_H__
+#define __TRC_VCS_LOG_OUTPUT_BINARY_FILE_H__
+
+/*!
+\file LogOutput_BinaryFile.h
+\brief Log output writing compact binary records.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Stores records the way CLogger keeps them: type, raw monotonic timestamp,
+	format string and packed arguments - nothing gets formatted. Format strings are
+	interned; each is written once and later referred to by id. Layout is described
+	in LogBinary.h; use LogDecoder to turn the file into a regular text log.
+
+	Formats are interned by address (see CLogger::LogF()). Once ids run out, records
+	are rendered and stored as plain text.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <map>
+#include <string>
+#include <string.h>
+
+#include "Logger.h"
+#include "LogBinary.h"
+#include "LogFileBuffer.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Binary file log output.
+		class CLogOutput_BinaryFile : public ILogOutput
+		{
+		protected:
+			typedef std::map<const char8*, uint16> formatMap_t;	//!< Type of format id map.
+
+			std::string fileName;	//!< Output file name.
+			bool bReady;	//!< Is the output ready to save data?
+			CLogFileBuffer file;	//!< Output file, with its write buffer.
+			formatMap_t formatIds;	//!< Ids of formats written so far.
+			uint32 nextFormatId;	//!< Id for the next new format.
+
+			//! \brief Finds id of a format, writing its definition out if it's new.
+			//! \return Returns format id; LOG_BINARY_TEXT_FORMAT if we ran out of ids.
+			uint16 InternFormat(const char8* format)
+			{
+				formatMap_t::iterator itor = formatIds.find(format);
+				if(itor != formatIds.end())
+				{
+					return (*itor).second;
+				}
+
+				size_t length = strlen(format);
+				if(nextFormatId > LOG_BINARY_MAX_FORMAT || length > 0xFFFF)
+				{
+					return LOG_BINARY_TEXT_FORMAT;
+				}
+
+				uint16 id = (uint16)nextFormatId++;
+				uint16 length16 = (uint16)length;
+				char8 header[LOG_BINARY_FORMAT_HEADER_SIZE];
+				header[0] = LBC_Format;
+				memcpy(header + 1, &id, sizeof(id));
+				memcpy(header + 3, &length16, sizeof(length16));
+				file.Output(header, sizeof(header));
+				file.Output(format, length16);
+
+				formatIds.insert(formatMap_t::value_type(format, id));
+				return id;
+			}
+
+			//! \brief Writes a record chunk.
+			void OutputRecord(uint32 msgType, uint64 timestamp, uint16 formatId, const char8* data, uint32 length)
+			{
+				uint16 length16 = (uint16)length;	//records are never longer than LOG_MESSAGE_SIZE
+				char8 header[LOG_BINARY_RECORD_HEADER_SIZE];
+				header[0] = LBC_Record;
+				header[1] = (char8)msgType;
+				memcpy(header + 2, &timestamp, sizeof(timestamp));
+				memcpy(header + 10, &formatId, sizeof(formatId));
+				memcpy(header + 12, &length16, sizeof(length16));
+				file.Output(header, sizeof(header));
+				file.Output(data, length16);
+			}
+
+		public:
+			//! \brief Constructor.
+			//! \param _fileName: Name of the log file to open.
+			//! \param _bufferSize: Size of write buffer; 0 writes every record immediately.
+			//! \param _flushInterval: Max time [ms] a record may spend in the write buffer,
+			//!			as checked when next record is written.
+			CLogOutput_BinaryFile(const std::string& _fileName, uint32 _bufferSize = 0, uint32 _flushInterval = 1000)
+				:fileName(_fileName), bReady(false), file(_bufferSize, _flushInterval), nextFormatId(1)
+			{
+			}
+			virtual ~CLogOutput_BinaryFile(){}	//!< Default d-tor.
+
+			virtual bool Init()
+			{
+				if(fileName.empty() || !file.Open(fileName))
+				{
+					return false;
+				}
+
+				formatIds.clear();
+				nextFormatId = 1;
+
+				CLogClock clock;	//anchors match timestamps CLogger uses - same monotonic source
+				sint64 wallAnchor = clock.GetWallAnchor();
+				uint64 monotonicAnchor = clock.GetMonotonicAnchor();
+				char8 header[LOG_BINARY_HEADER_SIZE];
+				memcpy(header, LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE);
+				memcpy(header + LOG_BINARY_MAGIC_SIZE, &wallAnchor, sizeof(wallAnchor));
+				memcpy(header + LOG_BINARY_MAGIC_SIZE + 8, &monotonicAnchor, sizeof(monotonicAnchor));
+				file.Output(header, sizeof(header));
+
+				bReady = true;
+				return true;
+			}
+			virtual bool DeInit()
+			{
+				if(bReady)
+				{
+					file.Close();
+					bReady = false;
+					return true;
+				}
+
+				//don't de-init twice
+				return false;
+			}
+
+			//! \brief Writes buffered records out.
+			virtual void Flush()
+			{
+				file.Flush();
+			}
+
+			virtual bool IsStructured() const { return true; }
+
+			virtual void WriteRecord(const SLogRecord& record)
+			{
+				if(!bReady)
+				{
+					return;
+				}
+
+				if(record.format == NULL)
+				{
+					OutputRecord(record.msgType, record.timestamp, LOG_BINARY_TEXT_FORMAT, record.message, record.messageLength);
+					return;
+				}
+
+				uint16 formatId = InternFormat(record.format);
+				if(formatId != LOG_BINARY_TEXT_FORMAT)
+				{
+					OutputRecord(record.msgType, record.timestamp, formatId, record.message, record.messageLength);
+					return;
+				}
+
+				char8 text[LOG_MESSAGE_SIZE];
+				uint32 length = CLogFormat::Render(text, LOG_MESSAGE_SIZE, record.format, record.message, record.messageLength);
+				OutputRecord(record.msgType, record.timestamp, LOG_BINARY_TEXT_FORMAT, text, length);
+			}
+
+			//! \brief Stores message as a plain text record, stamped now; time text is ignored.
+			virtual void Write(uint32 msgType, const SLogText& time, const SLogText& message)
+			{
+				if(!bReady)
+				{
+					return;
+				}
+
+				uint32 length = (message.length < LOG_MESSAGE_SIZE) ? message.length : LOG_MESSAGE_SIZE - 1;
+				OutputRecord(msgType, CLogClock::Now(), LOG_BINARY_TEXT_FORMAT, message.text, length);
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_OUTPUT_BINARY_FILE_H__
@@ -0,0 +1,182 @@
+#ifndef __TRC_VCS_LOG_OUTPUT_FLIGHT_RECORDER_H__
+#define __TRC_VCS_LOG_OUTPUT_FLIGHT_RECORDER_H__
+
+/*!
+\file LogOutput_FlightRecorder.h
+\brief Log output keeping the latest records in a memory-mapped ring file.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Meant for detail (ie. LMT_Debug) we want around after a failure, but can't afford
+	to write to disk all the time. Records are copied into a fixed-size file mapped into
+	memory (see LogRing.h) - no system calls, no formatting; the oldest records get
+	overwritten. Flush() does nothing; the system writes dirty pages back when it sees fit,
+	and they survive a crash of our process.
+
+	The ring is dumped into a regular text log when an LMT_Fatal record passes through,
+	and on Init() if the previous run didn't shut down cleanly. LogDecoder reads ring
+	files directly, too.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <string.h>
+
+#include "Logger.h"
+#include "LogRing.h"
+#include "LogFileBuffer.h"
+#include "LogOutput_TextFile.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Flight recorder log output.
+		class CLogOutput_FlightRecorder : public ILogOutput
+		{
+		protected:
+			enum
+			{
+				DUMP_BUFFER_SIZE = 64 * 1024	//!< Size of write buffer used when dumping.
+			};
+
+			std::string fileName;	//!< Ring file name.
+			std::string dumpFileName;	//!< Name of text log the ring is dumped into.
+			uint32 size;	//!< Size of ring file.
+			bool bReady;	//!< Is the output ready to save data?
+			CLogMappedFile file;	//!< Ring file.
+			CLogRing ring;	//!< Ring inside the file.
+
+		public:
+			//! \brief Constructor.
+			//! \param _fileName: Name of ring file; reused between runs.
+			//! \param _dumpFileName: Name of text log the ring is dumped into.
+			//! \param _size: Size of ring file; at least LOG_RING_MIN_SIZE.
+			CLogOutput_FlightRecorder(const std::string& _fileName, const std::string& _dumpFileName, uint32 _size = 4 * 1024 * 1024)
+				:fileName(_fileName), dumpFileName(_dumpFileName), size(_size), bReady(false)
+			{
+				if(size < LOG_RING_MIN_SIZE)
+				{
+					size = LOG_RING_MIN_SIZE;
+				}
+			}
+			virtual ~CLogOutput_FlightRecorder(){}	//!< Default d-tor.
+
+			virtual bool Init()
+			{
+				if(fileName.empty() || !file.Open(fileName, size))
+				{
+					return false;
+				}
+
+				if(ring.Attach(file.GetMemory(), size) && !ring.IsClean() && ring.GetCount() > 0)
+				{
+					Dump();	//previous run crashed - save what it left behind
+				}
+				ring.Reset(file.GetMemory(), size, CLogClock());
+
+				bReady = true;
+				return true;
+			}
+			virtual bool DeInit()
+			{
+				if(bReady)
+				{
+					ring.SetClean(true);
+					file.Close();
+					bReady = false;
+					return true;
+				}
+
+				//don't de-init twice
+				return false;
+			}
+
+			//! \brief Writes ring contents into dump file, oldest record first.
+			//! \return Returns true if ring was dumped; false otherwise.
+			bool Dump()
+			{
+				if(!ring.IsValid())
+				{
+					return false;
+				}
+
+				CLogOutput_TextFile dump(dumpFileName, DUMP_BUFFER_SIZE);
+				if(!dump.Init())
+				{
+					return false;
+				}
+
+				CLogClock clock = ring.GetClock();
+				SLogRingCursor cursor = ring.Begin();
+				SLogRingEntry entry;
+				char8 timeText[LOG_TIME_SIZE];
+				char8 messageText[LOG_MESSAGE_SIZE];
+				while(ring.Next(cursor, entry))
+				{
+					SLogText time(timeText, clock.Format(entry.timestamp, timeText));
+					SLogText message(messageText, CLogRing::RenderMessage(entry, messageText, LOG_MESSAGE_SIZE));
+					dump.Write(entry.msgType, time, message);
+				}
+				dump.DeInit();
+
+				file.Sync();
+				return true;
+			}
+
+			virtual bool IsStructured() const { return true; }
+
+			virtual void WriteRecord(const SLogRecord& record)
+			{
+				if(!bReady)
+				{
+					return;
+				}
+
+				uint32 formatLength = record.format ? (uint32)strlen(record.format) : 0;
+				if(formatLength <= LOG_RING_MAX_FORMAT)
+				{
+					ring.Append(record.msgType, record.timestamp, record.format, formatLength, record.message, record.messageLength);
+				}
+				else
+				{
+					char8 text[LOG_MESSAGE_SIZE];
+					uint32 length = CLogFormat::Render(text, LOG_MESSAGE_SIZE, record.format, record.message, record.messageLength);
+					ring.Append(record.msgType, record.timestamp, NULL, 0, text, length);
+				}
+
+				if(record.msgType == LMT_Fatal)
+				{
+					Dump();
+				}
+			}
+
+			//! \brief Stores message as a plain text record, stamped now; time text is ignored.
+			virtual void Write(uint32 msgType, const SLogText& time, const SLogText& message)
+			{
+				if(!bReady)
+				{
+					return;
+				}
+
+				uint32 length = (message.length < LOG_MESSAGE_SIZE) ? message.length : LOG_MESSAGE_SIZE - 1;
+				ring.Append(msgType, CLogClock::Now(), NULL, 0, message.text, length);
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_OUTPUT_FLIGHT_RECORDER_H__
@@ -1,169 +1,217 @@
-#ifndef __TRC_VCS_LOG_OUTPUT_TEXT_FILE_H__
-#define __TRC_VCS_LOG_OUTPUT_TEXT_FILE_H__
-
-/*!
-\file LogOutput_TextFile.h
-\brief Implementation of a simple text file log output.
-
-
-Project:	TRC Voice Control System
-
-Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
-
-Created: 29.11.2006
-Last Revised:	29.11.2006
-
-Implementation File: none.
-
-Notes:
-
-
-*/
-
-#include "Defines.h"
-#include "BaseTypes.h"
-
-#include <string>
-#include <sstream>
-#include <time.h>
-#include <windows.h>
-
-#include "Logger.h"
-
-namespace TRC
-{
-	namespace VCS
-	{
-		//! \brief Simple text file log output, that uses WinAPI for file I/O.
-		class CLogOutput_TextFile : public ILogOutput
-		{
-		protected:
-			std::string fileName;	//!< Output file name.
-			bool bReady;	//!< Is the output ready to save data?
-			HANDLE hFile;	//!< WinAPI handle to output file.
-
-		public:
-			//! \brief Constructor.
-			//! \param _fileName: Name of the log file to open.
-			CLogOutput_TextFile(const std::string& _fileName):fileName(_fileName), bReady(false){}
-			virtual ~CLogOutput_TextFile(){}	//!< Default d-tor.
-
-			virtual bool Init()
-			{
-				if(fileName.empty())
-				{
-					return false;
-				}
-				return OpenFile(fileName.c_str());
-			}
-			virtual bool DeInit()
-			{
-				if(bReady)
-				{
-					std::stringstream buffer;	//temporary buffer
-					char timesign [128];	//temporary buffer for holding date / time stuff
-					DWORD dwTemp;	//temporary dword
-
-					_strdate(timesign);	//load date
-
-					buffer <<"-[Log file closed at: " << timesign;	//first half of date/time info
-
-					_strtime(timesign);	//load current time
-
-					buffer <<" " << timesign <<"]\r\n";	//... and the second half of date/time stuff
-
-					WriteFile(hFile, buffer.str().c_str(), buffer.str().size(), &dwTemp, NULL);
-
-					CloseHandle(hFile);	//close log file handle
-
-					return true;
-				}
-
-				//don't de-init twice
-				return false;
-			}
-
-			//! \brief Opens output file.
-			//! \param name - File name.
-			//! \return Returns true if file is open and ready to receive data; false otherwise.
-			bool OpenFile(const std::string& name)
-			{
-				fileName = name;
-				hFile = CreateFile(fileName.c_str(), GENERIC_WRITE, FILE_SHARE_READ , NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
-
-				if(hFile == INVALID_HANDLE_VALUE)
-				{
-					bReady = false;
-					return false;
-				}
-
-				std::stringstream buffer;	//temporary buffer
-				char timesign [128];	//temporary buffer for holding date / time stuff
-				DWORD dwTemp;	//temporary dword
-
-				_strdate(timesign);	//load date
-
-				buffer <<"-[Log file opened at: " << timesign;	//first half of date/time info
-
-				_strtime(timesign);	//load current time
-
-				buffer <<" " << timesign <<"]-\r\n";	//... and the second half of date/time stuff
-
-				buffer <<"-[======================================================]-\r\n";
-				buffer <<"-[Logging unit created for Project: Anything            ]-\r\n";
-				buffer <<"-[By Jacek \"TeMPOraL\" Zlydach                           ]-\r\n";
-				buffer <<"-[======================================================]-\r\n";
-
-				WriteFile(hFile, buffer.str().c_str(), buffer.str().size(), &dwTemp, NULL);
-				bReady = true;
-				return true;
-			}
-
-			virtual void Write(uint32 msgType, const std::string& time, const std::string& message)
-			{
-				char8 typeChar;	//here we'll store character representing message type
-				if(msgType & LMT_Info)
-				{
-					typeChar = 'I';
-				}
-				else if(msgType & LMT_Success)
-				{
-					typeChar = 'S';
-				}
-				else if(msgType & LMT_Warning)
-				{
-					typeChar = 'W';
-				}
-				else if(msgType & LMT_Error)
-				{
-					typeChar = 'E';
-				}
-				else if(msgType & LMT_Debug)
-				{
-					typeChar = 'D';
-				}
-				else if(msgType == LMT_Fatal)
-				{
-					typeChar = 'F';
-				}
-				else
-				{
-					typeChar = '?';
-				}
-
-				//format message
-				std::stringstream buffer;
-				buffer << '[' << typeChar << "] [" << time << "] " << message << "\r\n";
-
-				//prepare to write
-				DWORD dwTemp;
-				std::string text(buffer.str());
-
-				//output message
-				WriteFile(hFile, text.c_str(), text.size(), &dwTemp, NULL);
-			}
-		};
-	} //end of namespace VCS
-} //end of namespace TRC
-
-#endif //__TRC_VCS_LOG_OUTPUT_TEXT_FILE_H__
+#ifndef __TRC_VCS_LOG_OUTPUT_TEXT_FILE_H__
+#define __TRC_VCS_LOG_OUTPUT_TEXT_FILE_H__
+
+/*!
+\file LogOutput_TextFile.h
+\brief Implementation of a simple text file log output.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 29.11.2006
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	With a non-zero buffer size, lines are coalesced in memory (see LogFileBuffer.h)
+	and written out when the buffer fills up, when its oldest line gets older than
+	the flush interval, or when CLogger calls Flush() - that is after errors, when its
+	writer thread goes idle and at shutdown. The log looks the same on every platform.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <sstream>
+#include <time.h>
+
+#include "Logger.h"
+#include "LogFileBuffer.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief When a text file log output forces its data down to the disk.
+		enum E_LogSyncPolicy
+		{
+			LSP_Never,	//!< Leave it to the operating system.
+			LSP_OnError,	//!< On the first flush after an error or fatal message.
+			LSP_Always	//!< On every flush.
+		};
+
+		//! \brief Simple text file log output, that uses platform's native file I/O.
+		class CLogOutput_TextFile : public ILogOutput
+		{
+		protected:
+			enum
+			{
+				LINE_BUFFER_SIZE = LOG_MESSAGE_SIZE + LOG_TIME_SIZE + 16	//!< Fits any line CLogger produces.
+			};
+
+			std::string fileName;	//!< Output file name.
+			bool bReady;	//!< Is the output ready to save data?
+			CLogFileBuffer file;	//!< Output file, with its write buffer.
+			E_LogSyncPolicy syncPolicy;	//!< When to force data down to the disk.
+			bool bSyncPending;	//!< Should next flush force data down to the disk?
+
+			//! \brief Checks current local date and time.
+			//! \return Returns text like "06/25/07 03:01:59".
+			static std::string DateTimeNow()
+			{
+				time_t now = time(NULL);
+				struct tm local;
+			#ifdef WIN32
+				localtime_s(&local, &now);
+			#else //WIN32
+				localtime_r(&now, &local);
+			#endif //WIN32
+
+				char8 timesign[32];	//temporary buffer for holding date / time stuff
+				strftime(timesign, sizeof(timesign), "%m/%d/%y %H:%M:%S", &local);
+				return std::string(timesign);
+			}
+
+		public:
+			//! \brief Constructor.
+			//! \param _fileName: Name of the log file to open.
+			//! \param _bufferSize: Size of write buffer; 0 writes every line immediately.
+			//! \param _flushInterval: Max time [ms] a line may spend in the write buffer,
+			//!			as checked when next line is written.
+			//! \param _syncPolicy: When to force data down to the disk.
+			CLogOutput_TextFile(const std::string& _fileName, uint32 _bufferSize = 0, uint32 _flushInterval = 1000,
+				E_LogSyncPolicy _syncPolicy = LSP_Never)
+				:fileName(_fileName), bReady(false), file(_bufferSize, _flushInterval),
+				syncPolicy(_syncPolicy), bSyncPending(false)
+			{
+			}
+			virtual ~CLogOutput_TextFile(){}	//!< Default d-tor.
+
+			virtual bool Init()
+			{
+				if(fileName.empty())
+				{
+					return false;
+				}
+				return OpenFile(fileName.c_str());
+			}
+			virtual bool DeInit()
+			{
+				if(bReady)
+				{
+					Flush();
+
+					std::stringstream buffer;	//temporary buffer
+					buffer <<"-[Log file closed at: " << DateTimeNow() <<"]\r\n";
+
+					std::string text(buffer.str());
+					file.Output(text.data(), (uint32)text.size());
+					file.Flush();
+					if(syncPolicy != LSP_Never)
+					{
+						file.Sync();
+					}
+
+					file.Close();	//close log file
+					bReady = false;
+
+					return true;
+				}
+
+				//don't de-init twice
+				return false;
+			}
+
+			//! \brief Writes buffered lines out.
+			virtual void Flush()
+			{
+				file.Flush();
+				if(bSyncPending || (syncPolicy == LSP_Always && bReady))
+				{
+					file.Sync();
+					bSyncPending = false;
+				}
+			}
+
+			//! \brief Copies text to buffer, as much as fits.
+			//! \return Returns count of copied characters.
+			static uint32 Append(char8* buffer, uint32 capacity, const SLogText& text)
+			{
+				uint32 length = (text.length < capacity) ? text.length : capacity;
+				memcpy(buffer, text.text, length);
+				return length;
+			}
+
+			//! \brief Opens output file.
+			//! \param name - File name.
+			//! \return Returns true if file is open and ready to receive data; false otherwise.
+			bool OpenFile(const std::string& name)
+			{
+				fileName = name;
+
+				if(!file.Open(fileName))
+				{
+					bReady = false;
+					return false;
+				}
+
+				std::stringstream buffer;	//temporary buffer
+				buffer <<"-[Log file opened at: " << DateTimeNow() <<"]-\r\n";
+
+				buffer <<"-[======================================================]-\r\n";
+				buffer <<"-[Logging unit created for Project: Anything            ]-\r\n";
+				buffer <<"-[By Jacek \"TeMPOraL\" Zlydach                           ]-\r\n";
+				buffer <<"-[======================================================]-\r\n";
+
+				std::string text(buffer.str());
+				file.Output(text.data(), (uint32)text.size());
+				bReady = true;
+				return true;
+			}
+
+			virtual void Write(uint32 msgType, const SLogText& time, const SLogText& message)
+			{
+				if(syncPolicy == LSP_OnError && (msgType == LMT_Fatal || (msgType & LMT_Error)))
+				{
+					bSyncPending = true;	//CLogger flushes errors right away
+				}
+
+				//format message
+				char8 line[LINE_BUFFER_SIZE];
+				uint32 length = 0;
+				line[length++] = '[';
+				line[length++] = LogTypeChar(msgType);
+				line[length++] = ']';
+				line[length++] = ' ';
+				line[length++] = '[';
+				length += Append(line + length, LINE_BUFFER_SIZE - length, time);
+				line[length++] = ']';
+				line[length++] = ' ';
+
+				if(length + message.length + 2 <= LINE_BUFFER_SIZE)
+				{
+					//whole line fits - output it at once
+					length += Append(line + length, LINE_BUFFER_SIZE - length, message);
+					line[length++] = '\r';
+					line[length++] = '\n';
+					file.Output(line, length);
+				}
+				else
+				{
+					//oversized message - output it piece by piece
+					file.Output(line, length);
+					file.Output(message.text, message.length);
+					file.Output("\r\n", 2);
+				}
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_OUTPUT_TEXT_FILE_H__
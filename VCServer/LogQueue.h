@@ -0,0 +1,156 @@
+#ifndef __TRC_VCS_LOG_QUEUE_H__
+#define __TRC_VCS_LOG_QUEUE_H__
+
+/*!
+\file LogQueue.h
+\brief Bounded, lock-free queue used by the asynchronous logger.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	This is Dmitry Vyukov's bounded MPMC queue. Every cell carries a sequence
+	number, which tells producers and consumers whose turn it is to touch the cell,
+	so neither side ever takes a lock. Logger uses it with many producers and a
+	single consumer (the writer thread), but popping from producer threads is
+	safe too - that's how the drop-oldest overflow policy makes room.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+#include "Atomic.h"
+
+#include <boost/noncopyable.hpp>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Bounded multi-producer / multi-consumer lock-free queue.
+		//! T must be default constructible and assignable.
+		template <typename T>
+		class CBoundedQueue : private boost::noncopyable
+		{
+		protected:
+			enum
+			{
+				CACHE_LINE_SIZE = 64	//!< Used to keep hot counters apart.
+			};
+
+			//! \brief Single queue slot.
+			struct SCell
+			{
+				atomic32 sequence;	//!< Position this cell is waiting for.
+				T data;	//!< Stored item.
+			};
+
+			SCell* cells;	//!< Ring of cells.
+			uint32 mask;	//!< Capacity - 1; capacity is always a power of two.
+
+			char8 padding0[CACHE_LINE_SIZE];
+			atomic32 enqueuePos;	//!< Next position to push into.
+			char8 padding1[CACHE_LINE_SIZE];
+			atomic32 dequeuePos;	//!< Next position to pop from.
+			char8 padding2[CACHE_LINE_SIZE];
+
+		public:
+			//! \brief Constructor.
+			//! \param capacity: Maximum count of queued items; rounded up to a power of two.
+			explicit CBoundedQueue(uint32 capacity)
+			{
+				uint32 size = 2;
+				while(size < capacity)
+				{
+					size <<= 1;
+				}
+
+				cells = new SCell[size];
+				mask = size - 1;
+				for(uint32 i = 0 ; i < size ; ++i)
+				{
+					AtomicStore(&cells[i].sequence, i);
+				}
+				AtomicStore(&enqueuePos, 0);
+				AtomicStore(&dequeuePos, 0);
+			}
+			~CBoundedQueue(){ delete [] cells; }	//!< Destructor.
+
+			//! \brief Returns maximum count of queued items.
+			uint32 Capacity() const { return mask + 1; }
+
+			//! \brief Tries to push an item.
+			//! \return Returns true if item was queued; false if queue is full.
+			bool TryPush(const T& item)
+			{
+				SCell* cell;
+				uint32 pos = AtomicLoad(&enqueuePos);
+				for(;;)
+				{
+					cell = &cells[pos & mask];
+					sint32 diff = (sint32)((uint32)AtomicLoad(&cell->sequence) - pos);
+					if(diff == 0)
+					{
+						//cell is free; try to claim it
+						if((uint32)AtomicCompareExchange(&enqueuePos, pos + 1, pos) == pos)
+						{
+							break;
+						}
+					}
+					else if(diff < 0)
+					{
+						//cell still holds an item from the previous lap - we're full
+						return false;
+					}
+					pos = AtomicLoad(&enqueuePos);
+				}
+
+				cell->data = item;
+				AtomicStore(&cell->sequence, pos + 1);	//hand the cell over to consumers
+				return true;
+			}
+
+			//! \brief Tries to pop an item.
+			//! \param item: Receives popped item.
+			//! \return Returns true if an item was popped; false if queue is empty.
+			bool TryPop(T& item)
+			{
+				SCell* cell;
+				uint32 pos = AtomicLoad(&dequeuePos);
+				for(;;)
+				{
+					cell = &cells[pos & mask];
+					sint32 diff = (sint32)((uint32)AtomicLoad(&cell->sequence) - (pos + 1));
+					if(diff == 0)
+					{
+						//cell is filled; try to claim it
+						if((uint32)AtomicCompareExchange(&dequeuePos, pos + 1, pos) == pos)
+						{
+							break;
+						}
+					}
+					else if(diff < 0)
+					{
+						//nothing was pushed here yet - we're empty
+						return false;
+					}
+					pos = AtomicLoad(&dequeuePos);
+				}
+
+				item = cell->data;
+				AtomicStore(&cell->sequence, pos + mask + 1);	//hand the cell back to producers
+				return true;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_QUEUE_H__
@@ -0,0 +1,329 @@
+#ifndef __TRC_VCS_LOG_RING_H__
+#define __TRC_VCS_LOG_RING_H__
+
+/*!
+\file LogRing.h
+\brief Ring of log records kept in a block of (mapped) memory.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Used by CLogOutput_FlightRecorder on a memory-mapped file, and by LogDecoder
+	to read such files back. Everything lives inside the memory block, so whatever
+	was appended survives a crash of the writing process.
+
+	Memory starts with SLogRingHeader; data area begins at LOG_RING_DATA_OFFSET.
+	Entries are never split: when one doesn't fit before the end of the data area,
+	the rest of it is skipped (marked with a LRE_Wrap entry if there's room for one)
+	and the entry goes to the beginning. The oldest entries are dropped to make room.
+	Numbers are stored in native (x86, little-endian) byte order.
+
+	Entry:
+		uint16	size of the whole entry
+		uint8	kind (E_LogRingEntries)
+		uint8	message type
+		uint64	monotonic timestamp
+		uint16	format length; 0 for plain text records
+		uint16	data length
+		format string (no terminator), then data - as in SLogRecord
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string.h>
+
+#include "LogClock.h"
+#include "LogFormat.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Kinds of ring entries.
+		enum E_LogRingEntries
+		{
+			LRE_Record = 'R',	//!< Log record.
+			LRE_Wrap = 'W'	//!< Rest of the data area is unused; continue from its beginning.
+		};
+
+		enum
+		{
+			LOG_RING_MAGIC_SIZE = 8,	//!< Length of ring magic.
+			LOG_RING_DATA_OFFSET = 64,	//!< Offset of data area from the beginning of ring memory.
+			LOG_RING_ENTRY_HEADER_SIZE = 16,	//!< Size of an entry, not counting format and data.
+			LOG_RING_MAX_FORMAT = 1024,	//!< Longer formats are stored rendered.
+			LOG_RING_MIN_SIZE = 16 * 1024	//!< Smallest usable ring memory.
+		};
+
+		//! Magic bytes starting every ring; bump the digit when layout changes.
+		static const char8 LOG_RING_MAGIC[LOG_RING_MAGIC_SIZE + 1] = "VCSRING1";
+
+		//! \brief Ring bookkeeping, stored at the beginning of ring memory.
+		struct SLogRingHeader
+		{
+			char8 magic[LOG_RING_MAGIC_SIZE];	//!< LOG_RING_MAGIC.
+			sint64 wallAnchor;	//!< CLogClock::GetWallAnchor() of the writer...
+			uint64 monotonicAnchor;	//!< ...and its CLogClock::GetMonotonicAnchor().
+			uint32 capacity;	//!< Size of data area.
+			uint32 head;	//!< Offset (in data area) for the next entry.
+			uint32 tail;	//!< Offset of the oldest entry.
+			uint32 used;	//!< Bytes from tail to head, skipped ones included.
+			uint32 clean;	//!< Non-zero if the writer shut down cleanly.
+			uint32 count;	//!< Count of entries.
+		};
+
+		//! \brief Single record read from a ring; points into ring memory.
+		struct SLogRingEntry
+		{
+			uint32 msgType;	//!< Type of log message.
+			uint64 timestamp;	//!< CLogClock::Now() when this message was generated.
+			const char8* format;	//!< printf() format (not NUL-terminated); NULL for plain text records.
+			uint32 formatLength;	//!< Length of format.
+			const char8* data;	//!< Packed arguments, or plain text.
+			uint32 dataLength;	//!< Count of bytes in data.
+		};
+
+		//! \brief Position in a ring, for walking it from the oldest entry to the newest.
+		struct SLogRingCursor
+		{
+			uint32 pos;	//!< Offset of next entry.
+			uint32 remaining;	//!< Bytes left to walk.
+			uint32 count;	//!< Entries left to walk.
+		};
+
+		//! \brief Log ring over a block of memory owned by someone else.
+		class CLogRing
+		{
+		protected:
+			SLogRingHeader* header;	//!< Ring bookkeeping; NULL if ring isn't set up.
+			char8* data;	//!< Data area.
+
+			//! \brief Reads a 16-bit number from data area.
+			uint16 Read16(uint32 pos) const
+			{
+				uint16 value;
+				memcpy(&value, data + pos, sizeof(value));
+				return value;
+			}
+
+			//! \brief Checks how many bytes the entry at pos takes, skipped space included.
+			uint32 SizeAt(uint32 pos) const
+			{
+				if(header->capacity - pos < LOG_RING_ENTRY_HEADER_SIZE || data[pos + 2] == LRE_Wrap)
+				{
+					return header->capacity - pos;
+				}
+				return Read16(pos);
+			}
+
+			//! \brief Drops oldest entries until size bytes are free.
+			void MakeRoom(uint32 size)
+			{
+				while(header->capacity - header->used < size)
+				{
+					uint32 dropped = SizeAt(header->tail);
+					if(header->capacity - header->tail >= LOG_RING_ENTRY_HEADER_SIZE && data[header->tail + 2] == LRE_Record)
+					{
+						--header->count;
+					}
+					header->tail = (header->tail + dropped) % header->capacity;
+					header->used -= dropped;
+				}
+			}
+
+		public:
+			CLogRing():header(NULL), data(NULL){}	//!< Default c-tor.
+
+			//! \brief Uses memory holding a ring written earlier.
+			//! \param memory: Ring memory.
+			//! \param size: Size of memory.
+			//! \return Returns true if memory holds a valid ring; false otherwise.
+			bool Attach(char8* memory, uint32 size)
+			{
+				header = NULL;
+				if(size < LOG_RING_MIN_SIZE)
+				{
+					return false;
+				}
+
+				SLogRingHeader* candidate = (SLogRingHeader*)memory;
+				if( memcmp(candidate->magic, LOG_RING_MAGIC, LOG_RING_MAGIC_SIZE) != 0
+					|| candidate->capacity != size - LOG_RING_DATA_OFFSET
+					|| candidate->head >= candidate->capacity || candidate->tail >= candidate->capacity
+					|| candidate->used > candidate->capacity
+					|| (candidate->tail + candidate->used) % candidate->capacity != candidate->head )
+				{
+					return false;
+				}
+
+				header = candidate;
+				data = memory + LOG_RING_DATA_OFFSET;
+				return true;
+			}
+
+			//! \brief Sets up an empty ring in memory.
+			//! \param memory: Ring memory; at least LOG_RING_MIN_SIZE bytes.
+			//! \param size: Size of memory.
+			//! \param clock: Clock whose timestamps will be appended.
+			void Reset(char8* memory, uint32 size, const CLogClock& clock)
+			{
+				header = (SLogRingHeader*)memory;
+				data = memory + LOG_RING_DATA_OFFSET;
+
+				memset(header, 0, LOG_RING_DATA_OFFSET);
+				header->wallAnchor = clock.GetWallAnchor();
+				header->monotonicAnchor = clock.GetMonotonicAnchor();
+				header->capacity = size - LOG_RING_DATA_OFFSET;
+				memcpy(header->magic, LOG_RING_MAGIC, LOG_RING_MAGIC_SIZE);	//last - marks the ring valid
+			}
+
+			//! \brief Checks if ring was set up.
+			bool IsValid() const { return (header != NULL); }
+
+			//! \brief Returns count of entries in the ring.
+			uint32 GetCount() const { return header->count; }
+
+			//! \brief Checks if ring's writer shut down cleanly.
+			bool IsClean() const { return (header->clean != 0); }
+
+			//! \brief Marks ring's writer as shut down cleanly, or not.
+			void SetClean(bool bClean) { header->clean = bClean ? 1 : 0; }
+
+			//! \brief Returns clock matching timestamps in the ring.
+			CLogClock GetClock() const { return CLogClock(header->wallAnchor, header->monotonicAnchor); }
+
+			//! \brief Appends a record, dropping the oldest ones if necessary.
+			//! \param msgType: Type of log message.
+			//! \param timestamp: CLogClock::Now() when this message was generated.
+			//! \param format: printf() format of the record; NULL for plain text.
+			//! \param formatLength: Length of format; at most LOG_RING_MAX_FORMAT.
+			//! \param text: Packed arguments, or plain text.
+			//! \param length: Count of bytes in text; at most LOG_MESSAGE_SIZE.
+			void Append(uint32 msgType, uint64 timestamp, const char8* format, uint32 formatLength, const char8* text, uint32 length)
+			{
+				uint32 size = LOG_RING_ENTRY_HEADER_SIZE + formatLength + length;
+
+				if(header->capacity - header->head < size)
+				{
+					//doesn't fit before the end - skip the rest of data area
+					uint32 skipped = header->capacity - header->head;
+					MakeRoom(skipped);
+					if(skipped >= LOG_RING_ENTRY_HEADER_SIZE)
+					{
+						data[header->head + 2] = LRE_Wrap;
+					}
+					header->used += skipped;
+					header->head = 0;
+				}
+				MakeRoom(size);
+
+				char8* entry = data + header->head;
+				uint16 size16 = (uint16)size;
+				uint16 formatLength16 = (uint16)formatLength;
+				uint16 length16 = (uint16)length;
+				memcpy(entry, &size16, sizeof(size16));
+				entry[2] = LRE_Record;
+				entry[3] = (char8)msgType;
+				memcpy(entry + 4, &timestamp, sizeof(timestamp));
+				memcpy(entry + 12, &formatLength16, sizeof(formatLength16));
+				memcpy(entry + 14, &length16, sizeof(length16));
+				if(formatLength > 0)
+				{
+					memcpy(entry + LOG_RING_ENTRY_HEADER_SIZE, format, formatLength);
+				}
+				memcpy(entry + LOG_RING_ENTRY_HEADER_SIZE + formatLength, text, length);
+
+				//bookkeeping goes last, so a crash mid-copy leaves the ring consistent
+				header->head = (header->head + size) % header->capacity;
+				header->used += size;
+				++header->count;
+			}
+
+			//! \brief Starts walking the ring from its oldest entry.
+			SLogRingCursor Begin() const
+			{
+				SLogRingCursor cursor;
+				cursor.pos = header->tail;
+				cursor.remaining = header->used;
+				cursor.count = header->count;
+				return cursor;
+			}
+
+			//! \brief Reads next entry.
+			//! \param cursor: Position returned by Begin(); moved past the entry.
+			//! \param entry: Receives the entry.
+			//! \return Returns false if there are no more entries (or the ring is corrupt).
+			bool Next(SLogRingCursor& cursor, SLogRingEntry& entry) const
+			{
+				while(cursor.remaining > 0 && cursor.count > 0)
+				{
+					uint32 size = SizeAt(cursor.pos);
+					if(size > cursor.remaining)
+					{
+						return false;
+					}
+
+					if(header->capacity - cursor.pos >= LOG_RING_ENTRY_HEADER_SIZE && data[cursor.pos + 2] == LRE_Record)
+					{
+						const char8* raw = data + cursor.pos;
+						entry.msgType = (uint8)raw[3];
+						memcpy(&entry.timestamp, raw + 4, sizeof(entry.timestamp));
+						entry.formatLength = Read16(cursor.pos + 12);
+						entry.dataLength = Read16(cursor.pos + 14);
+						if(size < LOG_RING_ENTRY_HEADER_SIZE || LOG_RING_ENTRY_HEADER_SIZE + entry.formatLength + entry.dataLength != size)
+						{
+							return false;
+						}
+						entry.format = (entry.formatLength > 0) ? raw + LOG_RING_ENTRY_HEADER_SIZE : NULL;
+						entry.data = raw + LOG_RING_ENTRY_HEADER_SIZE + entry.formatLength;
+
+						cursor.pos = (cursor.pos + size) % header->capacity;
+						cursor.remaining -= size;
+						--cursor.count;
+						return true;
+					}
+
+					//wrap
+					cursor.pos = (cursor.pos + size) % header->capacity;
+					cursor.remaining -= size;
+				}
+				return false;
+			}
+
+			//! \brief Renders message of an entry.
+			//! \param entry: Entry returned by Next().
+			//! \param text: Receives NUL-terminated message.
+			//! \param capacity: Size of text.
+			//! \return Returns length of the message.
+			static uint32 RenderMessage(const SLogRingEntry& entry, char8* text, uint32 capacity)
+			{
+				if(entry.format == NULL)
+				{
+					uint32 length = (entry.dataLength < capacity) ? entry.dataLength : capacity - 1;
+					memcpy(text, entry.data, length);
+					text[length] = '\0';
+					return length;
+				}
+
+				char8 format[LOG_RING_MAX_FORMAT + 1];	//ring formats aren't NUL-terminated
+				uint32 formatLength = (entry.formatLength < LOG_RING_MAX_FORMAT) ? entry.formatLength : LOG_RING_MAX_FORMAT;
+				memcpy(format, entry.format, formatLength);
+				format[formatLength] = '\0';
+				return CLogFormat::Render(text, capacity, format, entry.data, entry.dataLength);
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_LOG_RING_H__
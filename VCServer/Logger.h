@@ -1,172 +1,1074 @@
-#ifndef __TRC_VCS_LOGGER_H__
-#define __TRC_VCS_LOGGER_H__
-
-/*!
-\file Logger.h
-\brief The Logger Tool.
-
-
-Project:	TRC Voice Control System
-
-Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
-
-Created: 29.11.2006
-Last Revised:	29.11.2006
-
-Implementation File: none.
-
-Notes:
-
-*/
-
-#include "Defines.h"
-#include "BaseTypes.h"
-
-#include <boost/format.hpp>
-
-namespace TRC
-{
-	namespace VCS
-	{
-		//! \brief Log message types.
-		enum E_LogMessageTypes
-		{
-			LMT_Fatal = 0x00,	//!< Fatal error.
-
-			LMT_Info = 0x01,	//!< Basic information message.
-			LMT_Success = 0x02,	//!< Success message.
-			LMT_Warning = 0x04,	//!< Warning message.
-			LMT_Error = 0x08,	//!< Error message.
-
-			LMT_Debug = 0x40,	//!< Debug message.
-
-			LMT_TTS = 0x80,	//!< Text To Speech message.
-
-			//! Default filter for an output.
-			LMTF_Default = (LMT_Info | LMT_Success | LMT_Warning | LMT_Error | LMT_Debug),
-			LMTF_TTSDefault = (LMTF_Default | LMT_TTS)
-		};
-
-		class ILogOutput
-		{
-		public:
-			ILogOutput(){}	//!< Default c-tor.
-			virtual ~ILogOutput(){}	//!< Virtual d-tor.
-
-			//! \brief Initialize log output.
-			//! \return Returns true after successful init; false otherwise.
-			virtual bool Init() = 0;
-
-			//! \brief Deinitialize log output.
-			//! \return Returns true after successful deinit; false otherwise.
-			virtual bool DeInit() = 0;
-
-			//! \brief Write log message.
-			//! \param msgType: Type of log message, *should* be one of E_LogMessageType constants.
-			//! \param time: Text containing time when this message was generated.
-			//! \param message: Logged message.
-			//!
-			//! A log output may not always use all of those params; ie. some outputs may not need
-			//! to store time data. Also, an output may employ it's own internal filtering.
-			virtual void Write(uint32 msgType, const std::string& time, const std::string& message) = 0;
-
-		};
-
-		class CLogger
-		{
-		private:
-		protected:
-			typedef std::vector<std::pair<uint32, ILogOutput*> > outputList_t;	//!< Type of
-												//!< log output list.
-			outputList_t logOutputs;	//!< List of all log outputs.
-
-			//! \brief Checks current time using some external functions.
-			//! \return Returns text containing current time.
-			//! I know - it's not thread-safe ;)
-			std::string CurrentTime()
-			{
-				char8 temp[80];	//temporary array for storing the time
-				_strtime(temp);	//store time
-				return std::string(temp);
-			}
-		public:
-			CLogger(){}	//!< Default c-tor.
-			virtual ~CLogger(){}	//! Virtual d-tor.
-
-			virtual bool Init(){ return true; }
-			virtual bool DeInit(){ logOutputs.clear(); return true; }
-			virtual void SafeShutdown() throw() { try { DeInit(); } catch(...) {} };
-
-			//! \brief Adds an log output to the logger.
-			//! \param output: Pointer to log output.
-			//! \param filter: Describes output filter. Use | operator [binary OR] to
-			//!			specify which message types should be *passed* to the output.
-			//! \return Returns true after successful output registering; false otherwise.
-			//!
-			//! Pointer to log output should not be NULL - otherwise it will be ignored.
-			//! No checks for duplicates are made, the same output may be registered more than once.
-			virtual bool AddLogOutput(ILogOutput* output, uint32 filter)
-			{
-				if(output == NULL)	//ignore NULL log output
-				{
-					return false;
-				}
-
-				//add output
-				logOutputs.push_back(outputList_t::value_type(filter, output));
-				output->Write(LMT_Info, CurrentTime(), "CLogger::AddLogOutput() - Attached to Logger.");
-				return true;
-			}
-
-			//! \brief Removes an log output from the logger.
-			//! \param output: Pointer to log output.
-			//! \return Returns true if output was found and unregistered; false otherwise.
-			//!
-			//! This function does not destroy the log output; it's up to it's owner.
-			//! This function removes first output maching address, so if an output is registered
-			//! more than once, then more than one call of this function is needed.
-			virtual bool RemoveLogOutput(ILogOutput* output)
-			{
-				//try to find our output
-				for(outputList_t::iterator itor = logOutputs.begin() ; itor != logOutputs.end() ; ++itor)
-				{
-					//check pointer [second part of std::pair]
-					if( (*itor).second == output)
-					{
-						//we've found our output; remove it
-						if(output)	//make sure we won't try to write to a NULL pointer
-						{
-							output->Write(LMT_Info, CurrentTime(), "CLogger::RemoveLogOutput() - Detached from Logger.");
-						}
-						logOutputs.erase(itor);
-						return true;
-					}
-				}
-
-				//not found
-				return false;
-			}
-
-			//! \brief Log message.
-			//! \param msgType: Type of log message, *should* be one of E_LogMessageType constants.
-			//! \param message: Message to be logged.
-			void Log(uint32 msgType, const std::string& msg)
-			{
-				std::string currentTime(CurrentTime());	//output time
-				for(outputList_t::iterator itor = logOutputs.begin() ; itor != logOutputs.end() ; ++itor)
-				{
-					if( (*itor).second && ( ( (*itor).first & msgType ) || msgType == LMT_Fatal ) )
-					{
-						(*itor).second->Write(msgType, currentTime, msg);
-					}
-				}
-			}
-			void Log(uint32 msgType, const boost::format& msg)
-			{
-				Log(msgType, msg.str());
-			}
-		};
-	} //end of namespace VCS
-} //end of namespace TRC
-
-#endif //__TRC_VCS_LOGGER_H__
+#ifndef __TRC_VCS_LOGGER_H__
+#define __TRC_VCS_LOGGER_H__
+
+/*!
+\file Logger.h
+\brief The Logger Tool.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 29.11.2006
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Logger works either synchronously (outputs are written on the caller's thread)
+	or asynchronously - see CLogger::StartAsync(). In the latter mode callers only
+	stamp the record and push it into lock-free queues, one per output; every output
+	has a background writer thread draining its queue. A slow output fills only its
+	own queue, and its overflow policy decides if callers wait for it.
+
+	The output list is copy-on-write: adding or removing an output publishes a new list,
+	while threads logging at the moment keep using the one they took.
+
+	Prefer VCS_LOG_* macros over calling CLogger::Log() directly - they skip building
+	the message when no output wants it, and compile to nothing below VCS_LOG_MIN_LEVEL.
+
+	Messages are copied into a record living on the caller's stack, and outputs get views
+	into it - so VCS_LOGF_* macros (printf-style) and plain text messages don't touch
+	the heap at all. boost::format allocates on its own; avoid it on hot paths.
+	Messages longer than LOG_MESSAGE_SIZE - 1 characters are truncated.
+
+	LogF() doesn't format anything; it packs raw arguments next to the format string
+	pointer (see LogFormat.h). Text is rendered when the record is written out, and only
+	for text outputs. Structured outputs (ie. LogOutput_BinaryFile.h)
+	take the packed record as is.
+
+	Records carry a raw monotonic timestamp (see LogClock.h); it's turned into text
+	only when the record is written out, ie. on the writer threads in asynchronous mode.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+#include "Atomic.h"
+#include "LogQueue.h"
+#include "LogClock.h"
+#include "LogFormat.h"
+#include "LogLimiter.h"
+
+#include <string>
+#include <vector>
+#include <stdarg.h>
+#include <string.h>
+
+#include <boost/format.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Log message types.
+		enum E_LogMessageTypes
+		{
+			LMT_Fatal = 0x00,	//!< Fatal error.
+
+			LMT_Info = 0x01,	//!< Basic information message.
+			LMT_Success = 0x02,	//!< Success message.
+			LMT_Warning = 0x04,	//!< Warning message.
+			LMT_Error = 0x08,	//!< Error message.
+
+			LMT_Debug = 0x40,	//!< Debug message.
+
+			LMT_TTS = 0x80,	//!< Text To Speech message.
+
+			//! Default filter for an output.
+			LMTF_Default = (LMT_Info | LMT_Success | LMT_Warning | LMT_Error | LMT_Debug),
+			LMTF_TTSDefault = (LMTF_Default | LMT_TTS)
+		};
+
+		//! \brief What an asynchronous logger does when an output's queue is full.
+		enum E_LogOverflowPolicy
+		{
+			LOP_Block,	//!< Wait for the writer to make room; nothing gets lost.
+			LOP_DropOldest,	//!< Discard the oldest queued record to make room for the new one.
+			LOP_DropNewest,	//!< Discard the record being logged.
+			LOP_Sample	//!< Keep only some records once the queue is over half full; drop the rest
+						//!< when it's full. Errors are never sampled out, and wait for room if needed.
+		};
+
+		enum
+		{
+			LOG_TIME_SIZE = CLogClock::TEXT_SIZE,	//!< Capacity of time text passed to outputs.
+			LOG_MESSAGE_SIZE = 512	//!< Capacity of message text in a log record.
+		};
+
+		//! \brief Non-owning view of a piece of log text. It's *not* NUL-terminated.
+		struct SLogText
+		{
+			const char8* text;	//!< First character.
+			uint32 length;	//!< Count of characters.
+
+			SLogText(const char8* _text, uint32 _length):text(_text), length(_length){}
+			SLogText(const char8* _text):text(_text), length((uint32)strlen(_text)){}
+			SLogText(const std::string& _text):text(_text.data()), length((uint32)_text.size()){}
+		};
+
+		//! \brief Log record; holds a message without any heap storage.
+		struct SLogRecord
+		{
+			uint64 timestamp;	//!< CLogClock::Now() when this message was generated.
+			const char8* format;	//!< printf() format of message logged with LogF(); NULL otherwise.
+			uint32 msgType;	//!< Type of log message.
+			uint32 messageLength;	//!< Count of bytes in message.
+			char8 message[LOG_MESSAGE_SIZE];	//!< Logged message; arguments packed by CLogFormat if format isn't NULL.
+		};
+
+		//! \brief Picks character representing message type in text logs.
+		//! \return Returns one of 'I', 'S', 'W', 'E', 'D', 'F'; '?' for unknown types.
+		inline char8 LogTypeChar(uint32 msgType)
+		{
+			if(msgType & LMT_Info)
+			{
+				return 'I';
+			}
+			else if(msgType & LMT_Success)
+			{
+				return 'S';
+			}
+			else if(msgType & LMT_Warning)
+			{
+				return 'W';
+			}
+			else if(msgType & LMT_Error)
+			{
+				return 'E';
+			}
+			else if(msgType & LMT_Debug)
+			{
+				return 'D';
+			}
+			else if(msgType == LMT_Fatal)
+			{
+				return 'F';
+			}
+			return '?';
+		}
+
+		class ILogOutput
+		{
+		public:
+			ILogOutput(){}	//!< Default c-tor.
+			virtual ~ILogOutput(){}	//!< Virtual d-tor.
+
+			//! \brief Initialize log output.
+			//! \return Returns true after successful init; false otherwise.
+			virtual bool Init() = 0;
+
+			//! \brief Deinitialize log output.
+			//! \return Returns true after successful deinit; false otherwise.
+			virtual bool DeInit() = 0;
+
+			//! \brief Write log message.
+			//! \param msgType: Type of log message, *should* be one of E_LogMessageType constants.
+			//! \param time: Text containing time when this message was generated.
+			//! \param message: Logged message.
+			//!
+			//! A log output may not always use all of those params; ie. some outputs may not need
+			//! to store time data. Also, an output may employ it's own internal filtering.
+			//! Texts are valid only during this call - copy them if you need them later.
+			virtual void Write(uint32 msgType, const SLogText& time, const SLogText& message) = 0;
+
+			//! \brief Checks if this output wants whole records instead of text.
+			//! \return Returns true if CLogger should call WriteRecord() rather than Write().
+			virtual bool IsStructured() const { return false; }
+
+			//! \brief Write log record as is; called only if IsStructured() returns true.
+			//! \param record: Logged record; valid only during this call.
+			//!
+			//! Write() is still used for messages that don't come from CLogger's records.
+			virtual void WriteRecord(const SLogRecord& record){}
+
+			//! \brief Push everything written so far to the underlying medium.
+			//!
+			//! Called by CLogger after errors, when its writer thread runs out of work,
+			//! and on demand. Outputs that don't buffer needn't override it.
+			virtual void Flush(){}
+
+		};
+
+		//! \brief Per-output delivery statistics.
+		struct SLogOutputStats
+		{
+			uint32 written;	//!< Records passed to the output.
+			uint32 dropped;	//!< Records discarded because the output's queue was full.
+			uint32 sampled;	//!< Records skipped by LOP_Sample while the queue was filling up.
+			uint32 delayed;	//!< Records whose caller had to wait for room in the queue.
+		};
+
+		//! \brief Registered log output, with its own queue and writer thread in asynchronous mode.
+		//!
+		//! Outputs are isolated from each other: a slow one fills only its own queue,
+		//! and its overflow policy decides whether callers wait for it.
+		class CLogOutputChannel : private boost::noncopyable
+		{
+		protected:
+			typedef CBoundedQueue<SLogRecord> recordQueue_t;	//!< Type of asynchronous record queue.
+
+			enum
+			{
+				WRITER_IDLE_WAIT = 100	//!< Max time [ms] the writer sleeps without being woken.
+			};
+
+			ILogOutput* output;	//!< The output.
+			uint32 filter;	//!< Message types passed to the output.
+			E_LogOverflowPolicy policy;	//!< What to do when queue is full.
+			uint32 sampleRate;	//!< LOP_Sample keeps every sampleRate-th record.
+			bool bDefaultPolicy;	//!< Was policy left for CLogger::StartAsync() to pick?
+			const CLogClock& clock;	//!< Logger's clock, for formatting time.
+			boost::mutex outputMutex;	//!< Serializes calls to output.
+
+			//---vv counters
+			atomic32 written;	//!< See SLogOutputStats.
+			atomic32 dropped;	//!< See SLogOutputStats.
+			atomic32 sampled;	//!< See SLogOutputStats.
+			atomic32 delayed;	//!< See SLogOutputStats.
+			atomic32 sampleCounter;	//!< Records seen by LOP_Sample while sampling.
+			//---^^ counters
+
+			//---vv asynchronous mode
+			recordQueue_t* queue;	//!< Records awaiting the writer; NULL in synchronous mode.
+			boost::thread* writerThread;	//!< Thread draining queue.
+			boost::mutex writerMutex;	//!< Guards bStopWriter and both conditions below.
+			boost::condition writerWakeup;	//!< Signalled when writer has work or should quit.
+			boost::condition writerDrained;	//!< Signalled when writer has emptied the queue.
+			bool bStopWriter;	//!< Should the writer thread quit?
+			atomic32 pendingRecords;	//!< Records queued but not yet written (nor dropped).
+			atomic32 writerSleeping;	//!< Is the writer (about to be) waiting on writerWakeup?
+			//---^^ asynchronous mode
+
+			//! \brief Checks if record must not be sampled out.
+			static bool IsImportant(uint32 msgType)
+			{
+				return ( msgType == LMT_Fatal || (msgType & LMT_Error) );
+			}
+
+			//! \brief Passes record to the output, rendering text if the output needs it.
+			//! Errors are flushed right away, so they reach the disk even if we crash soon after.
+			void WriteOut(const SLogRecord& record)
+			{
+				boost::mutex::scoped_lock lock(outputMutex);
+				if(output->IsStructured())
+				{
+					output->WriteRecord(record);
+				}
+				else
+				{
+					char8 timeText[LOG_TIME_SIZE];
+					SLogText time(timeText, clock.Format(record.timestamp, timeText));
+					if(record.format)
+					{
+						char8 messageText[LOG_MESSAGE_SIZE];
+						SLogText message(messageText, CLogFormat::Render(messageText, LOG_MESSAGE_SIZE,
+							record.format, record.message, record.messageLength));
+						output->Write(record.msgType, time, message);
+					}
+					else
+					{
+						output->Write(record.msgType, time, SLogText(record.message, record.messageLength));
+					}
+				}
+				if(IsImportant(record.msgType))
+				{
+					output->Flush();
+				}
+				AtomicIncrement(&written);
+			}
+
+			//! \brief Queues record for the writer thread, obeying overflow policy.
+			void Enqueue(const SLogRecord& record)
+			{
+				bool bSample = ( policy == LOP_Sample && !IsImportant(record.msgType) );
+				if(bSample && (uint32)AtomicLoad(&pendingRecords) >= queue->Capacity() / 2)
+				{
+					//queue is filling up - let only every sampleRate-th record through
+					if((uint32)AtomicIncrement(&sampleCounter) % sampleRate != 0)
+					{
+						AtomicIncrement(&sampled);
+						return;
+					}
+				}
+
+				bool bDelayed = false;
+				while(!queue->TryPush(record))
+				{
+					if(policy == LOP_DropNewest || bSample)
+					{
+						AtomicIncrement(&dropped);
+						return;
+					}
+					else if(policy == LOP_DropOldest)
+					{
+						SLogRecord victim;
+						if(queue->TryPop(victim))
+						{
+							AtomicDecrement(&pendingRecords);
+							AtomicIncrement(&dropped);
+						}
+					}
+					else	//LOP_Block, or an important record under LOP_Sample
+					{
+						if(!bDelayed)
+						{
+							AtomicIncrement(&delayed);
+							bDelayed = true;
+						}
+						WakeWriter();
+						boost::thread::yield();
+					}
+				}
+
+				//counted only after the push, so a sleeping writer always gets woken below;
+				//the writer may decrement first, hence pendingRecords can briefly go negative
+				AtomicIncrement(&pendingRecords);
+				WakeWriter();
+			}
+
+			//! \brief Wakes writer thread up, if it's sleeping.
+			//! Only the thread that clears writerSleeping pays for the notification.
+			void WakeWriter()
+			{
+				if(AtomicCompareExchange(&writerSleeping, 0, 1) == 1)
+				{
+					boost::mutex::scoped_lock lock(writerMutex);
+					writerWakeup.notify_one();
+				}
+			}
+
+			//! \brief Body of the writer thread.
+			void WriterLoop()
+			{
+				SLogRecord record;
+				for(;;)
+				{
+					bool bWritten = false;
+					while(queue->TryPop(record))
+					{
+						WriteOut(record);
+						AtomicDecrement(&pendingRecords);
+						bWritten = true;
+					}
+					if(bWritten)
+					{
+						FlushOutput();	//we're out of work - a good moment to hit the disk
+					}
+
+					if(AtomicLoad(&pendingRecords) > 0)
+					{
+						//a record is being pushed or dropped right now; let that thread finish
+						boost::thread::yield();
+						continue;
+					}
+
+					boost::mutex::scoped_lock lock(writerMutex);
+					writerDrained.notify_all();
+					if(bStopWriter)
+					{
+						break;
+					}
+
+					//pendingRecords must be re-read *after* we announce we're going to sleep;
+					//Enqueue() does the same in reverse order, so one of us always notices the other
+					AtomicExchange(&writerSleeping, 1);
+					if(AtomicLoad(&pendingRecords) <= 0)
+					{
+						writerWakeup.timed_wait(lock, boost::posix_time::milliseconds((long)WRITER_IDLE_WAIT));
+					}
+					AtomicExchange(&writerSleeping, 0);
+				}
+			}
+
+			//! \brief Flushes the output.
+			void FlushOutput()
+			{
+				boost::mutex::scoped_lock lock(outputMutex);
+				output->Flush();
+			}
+
+		public:
+			//! \brief Constructor.
+			//! \param _output: The output.
+			//! \param _filter: Message types passed to the output.
+			//! \param _policy: What to do when queue is full.
+			//! \param _sampleRate: LOP_Sample keeps every _sampleRate-th record while the queue is over half full.
+			//! \param _bDefaultPolicy: Should CLogger::StartAsync() override _policy?
+			//! \param _clock: Logger's clock.
+			CLogOutputChannel(ILogOutput* _output, uint32 _filter, E_LogOverflowPolicy _policy, uint32 _sampleRate,
+				bool _bDefaultPolicy, const CLogClock& _clock)
+				:output(_output), filter(_filter), policy(_policy), sampleRate(_sampleRate > 0 ? _sampleRate : 1),
+				bDefaultPolicy(_bDefaultPolicy), clock(_clock), queue(NULL), writerThread(NULL), bStopWriter(false)
+			{
+				AtomicStore(&written, 0);
+				AtomicStore(&dropped, 0);
+				AtomicStore(&sampled, 0);
+				AtomicStore(&delayed, 0);
+				AtomicStore(&sampleCounter, 0);
+				AtomicStore(&pendingRecords, 0);
+				AtomicStore(&writerSleeping, 0);
+			}
+			~CLogOutputChannel(){ Stop(); }	//!< D-tor; writes out whatever is queued.
+
+			//! \brief Returns the output.
+			ILogOutput* GetOutput() const { return output; }
+
+			//! \brief Returns message types passed to the output.
+			uint32 GetFilter() const { return filter; }
+
+			//! \brief Checks if output wants given message type.
+			bool Accepts(uint32 msgType) const
+			{
+				return ( (filter & msgType) || msgType == LMT_Fatal );
+			}
+
+			//! \brief Fills stats with current counters.
+			void GetStats(SLogOutputStats& stats) const
+			{
+				stats.written = AtomicLoad(&written);
+				stats.dropped = AtomicLoad(&dropped);
+				stats.sampled = AtomicLoad(&sampled);
+				stats.delayed = AtomicLoad(&delayed);
+			}
+
+			//! \brief Writes record out or queues it, depending on the mode.
+			void Deliver(const SLogRecord& record)
+			{
+				if(queue)
+				{
+					Enqueue(record);
+					return;
+				}
+
+				WriteOut(record);
+			}
+
+			//! \brief Writes text directly to the output, bypassing the queue.
+			void WriteNow(uint32 msgType, const char8* message)
+			{
+				char8 time[LOG_TIME_SIZE];
+				boost::mutex::scoped_lock lock(outputMutex);
+				output->Write(msgType, SLogText(time, clock.Format(CLogClock::Now(), time)), message);
+			}
+
+			//! \brief Starts the writer thread.
+			//! \param queueSize: Maximum count of records awaiting the writer thread.
+			//! \param defaultPolicy: Policy to use, unless one was given explicitly.
+			void Start(uint32 queueSize, E_LogOverflowPolicy defaultPolicy)
+			{
+				if(queue)
+				{
+					return;
+				}
+
+				if(bDefaultPolicy)
+				{
+					policy = defaultPolicy;
+				}
+				bStopWriter = false;
+				AtomicStore(&pendingRecords, 0);
+				queue = new recordQueue_t(queueSize);
+				writerThread = new boost::thread(boost::bind(&CLogOutputChannel::WriterLoop, this));
+			}
+
+			//! \brief Writes all queued records and stops the writer thread.
+			//!
+			//! Must not race with Deliver() - unregister the channel first.
+			void Stop()
+			{
+				if(queue == NULL)
+				{
+					return;
+				}
+
+				{
+					boost::mutex::scoped_lock lock(writerMutex);
+					bStopWriter = true;
+					writerWakeup.notify_one();
+				}
+				writerThread->join();	//writer quits only with an empty queue
+
+				delete writerThread;
+				writerThread = NULL;
+				delete queue;
+				queue = NULL;
+			}
+
+			//! \brief Blocks until every record queued so far is written, then flushes the output.
+			void Flush()
+			{
+				if(queue)
+				{
+					boost::mutex::scoped_lock lock(writerMutex);
+					while(AtomicLoad(&pendingRecords) > 0)
+					{
+						writerWakeup.notify_one();
+						writerDrained.timed_wait(lock, boost::posix_time::milliseconds((long)WRITER_IDLE_WAIT));
+					}
+				}
+				FlushOutput();
+			}
+		};
+
+		class CLogger
+		{
+		private:
+		protected:
+			typedef boost::shared_ptr<CLogOutputChannel> channelPtr_t;	//!< Type of shared channel pointer.
+			typedef std::vector<channelPtr_t> channelList_t;	//!< Type of log output list.
+			typedef boost::shared_ptr<const channelList_t> channelListPtr_t;	//!< Type of output list snapshot.
+
+			CLogClock clock;	//!< Timestamp source.
+			channelListPtr_t channels;	//!< All log outputs; never modified, only replaced (copy-on-write).
+			boost::mutex channelsMutex;	//!< Guards channels pointer (but not the list).
+			boost::mutex changeMutex;	//!< Serializes output list changes and mode switches.
+			atomic32 acceptedTypes;	//!< Combined filter of all outputs.
+
+			//---vv asynchronous mode
+			bool bAsync;	//!< Do outputs have their own writer threads?
+			uint32 asyncQueueSize;	//!< Queue size for each output in asynchronous mode.
+			E_LogOverflowPolicy defaultPolicy;	//!< Policy for outputs added without one.
+			//---^^ asynchronous mode
+
+			CLogLimiter limiter;	//!< Rate limits for repetitive messages.
+
+			//! \brief Stamps record with message type and current time.
+			void Stamp(SLogRecord& record, uint32 msgType)
+			{
+				record.timestamp = CLogClock::Now();
+				record.msgType = msgType;
+			}
+
+			//! \brief Copies text into the record, truncating it if necessary.
+			static uint32 CopyMessage(SLogRecord& record, const char8* text, size_t length)
+			{
+				if(length > LOG_MESSAGE_SIZE - 1)
+				{
+					length = LOG_MESSAGE_SIZE - 1;
+				}
+				memcpy(record.message, text, length);
+				record.message[length] = '\0';
+				return (uint32)length;
+			}
+
+			//! \brief Takes a snapshot of output list; it stays valid however the list changes later.
+			channelListPtr_t GetChannels()
+			{
+				boost::mutex::scoped_lock lock(channelsMutex);
+				return channels;
+			}
+
+			//! \brief Replaces output list and recalculates acceptedTypes; call with changeMutex locked.
+			void SetChannels(const channelListPtr_t& newChannels)
+			{
+				uint32 filter = 0;
+				for(channelList_t::const_iterator itor = newChannels->begin() ; itor != newChannels->end() ; ++itor)
+				{
+					filter |= (*itor)->GetFilter();
+				}
+
+				{
+					boost::mutex::scoped_lock lock(channelsMutex);
+					channels = newChannels;
+				}
+				AtomicStore(&acceptedTypes, filter);
+			}
+
+			//! \brief Passes record to every output whose filter accepts it.
+			//! Fatal records are written out before we return, whatever the mode - we may not live long.
+			void Submit(const SLogRecord& record)
+			{
+				channelListPtr_t snapshot = GetChannels();
+				for(channelList_t::const_iterator itor = snapshot->begin() ; itor != snapshot->end() ; ++itor)
+				{
+					if( (*itor)->Accepts(record.msgType) )
+					{
+						(*itor)->Deliver(record);
+					}
+				}
+
+				if(record.msgType == LMT_Fatal && bAsync)
+				{
+					Flush();
+				}
+			}
+
+			//! \brief Packs printf-style message into a record and submits it.
+			void SubmitPacked(uint32 msgType, const char8* format, va_list args)
+			{
+				SLogRecord record;
+				Stamp(record, msgType);
+				record.format = format;
+				record.messageLength = CLogFormat::Pack(record.message, LOG_MESSAGE_SIZE, format, args);
+				Submit(record);
+			}
+
+			//! \brief Submits printf-style message, bypassing the limiter.
+			void SubmitF(uint32 msgType, const char8* format, ...)
+			{
+				va_list args;
+				va_start(args, format);
+				SubmitPacked(msgType, format, args);
+				va_end(args);
+			}
+
+			//! \brief Logs a "similar messages suppressed" summary.
+			void SubmitSummary(const SLogSuppression& summary)
+			{
+				SubmitF(summary.msgType, "CLogger - %u similar messages suppressed: %s", summary.count, summary.sample);
+			}
+
+			//! \brief Logs "similar messages suppressed" summaries.
+			//! \param now: CLogClock::Now().
+			//! \param bAll: Log every pending summary, not only those of finished intervals.
+			void SubmitSummaries(uint64 now, bool bAll)
+			{
+				const uint32 batchSize = 16;
+				SLogSuppression summaries[batchSize];
+				uint32 count;
+				do
+				{
+					count = limiter.CollectSummaries(now, bAll, summaries, batchSize);
+					for(uint32 i = 0 ; i < count ; ++i)
+					{
+						SubmitSummary(summaries[i]);
+					}
+				}
+				while(count == batchSize);
+			}
+
+			//! \brief Asks the limiter if a record may be logged.
+			//! \param msgType: Type of the record; fatal records always pass.
+			//! \param key: Format string of printf-style messages, text of plain ones.
+			//! \param length: Length of key.
+			//! \return Returns false if record should be dropped.
+			bool Admit(uint32 msgType, const char8* key, size_t length)
+			{
+				if(msgType == LMT_Fatal || !limiter.IsActive())
+				{
+					return true;
+				}
+
+				uint64 now = CLogClock::Now();
+				SLogSuppression summary;
+				bool bSummary = false;
+				bool bAdmitted = limiter.Admit(msgType, key, (uint32)length, now, summary, bSummary);
+				if(bSummary)
+				{
+					SubmitSummary(summary);
+				}
+				if(limiter.IsSweepDue(now))
+				{
+					SubmitSummaries(now, false);
+				}
+				return bAdmitted;
+			}
+
+		public:
+			//! Default c-tor.
+			CLogger():channels(new channelList_t), bAsync(false), asyncQueueSize(0), defaultPolicy(LOP_Block)
+			{
+				AtomicStore(&acceptedTypes, 0);
+			}
+			virtual ~CLogger(){ StopAsync(); }	//! Virtual d-tor.
+
+			virtual bool Init(){ return true; }
+			virtual bool DeInit()
+			{
+				StopAsync();
+				Flush();
+				boost::mutex::scoped_lock lock(changeMutex);
+				SetChannels(channelListPtr_t(new channelList_t));
+				return true;
+			}
+			virtual void SafeShutdown() throw() { try { DeInit(); } catch(...) {} };
+
+			//! \brief Switches logger to asynchronous mode.
+			//! \param queueSize: Maximum count of records awaiting each output.
+			//! \param policy: What to do when an output's queue is full; used for outputs
+			//!			registered without a policy of their own.
+			//! \return Returns true if writer threads were started; false if they're already running.
+			//!
+			//! From now on Log() only stamps records and pushes them into queues, one per output;
+			//! every output is written by its own background thread. Use Flush() to wait for
+			//! all queued records.
+			bool StartAsync(uint32 queueSize = 4096, E_LogOverflowPolicy policy = LOP_Block)
+			{
+				boost::mutex::scoped_lock lock(changeMutex);
+				if(bAsync)
+				{
+					return false;
+				}
+
+				asyncQueueSize = queueSize;
+				defaultPolicy = policy;
+				channelListPtr_t snapshot = GetChannels();
+				for(channelList_t::const_iterator itor = snapshot->begin() ; itor != snapshot->end() ; ++itor)
+				{
+					(*itor)->Start(asyncQueueSize, defaultPolicy);
+				}
+				bAsync = true;
+				return true;
+			}
+
+			//! \brief Writes all queued records and switches logger back to synchronous mode.
+			//!
+			//! Must not race with Log() calls from other threads - stop logging first.
+			void StopAsync()
+			{
+				boost::mutex::scoped_lock lock(changeMutex);
+				if(!bAsync)
+				{
+					return;
+				}
+
+				channelListPtr_t snapshot = GetChannels();
+				for(channelList_t::const_iterator itor = snapshot->begin() ; itor != snapshot->end() ; ++itor)
+				{
+					(*itor)->Stop();
+				}
+				bAsync = false;
+			}
+
+			//! \brief Blocks until every record logged so far is written and flushed.
+			//! Pending "similar messages suppressed" summaries are logged first.
+			void Flush()
+			{
+				if(limiter.IsActive())
+				{
+					SubmitSummaries(CLogClock::Now(), true);
+				}
+
+				channelListPtr_t snapshot = GetChannels();
+				for(channelList_t::const_iterator itor = snapshot->begin() ; itor != snapshot->end() ; ++itor)
+				{
+					(*itor)->Flush();
+				}
+			}
+
+			//! \brief Checks if any output would accept given message type.
+			//! \param msgType: Type of log message, *should* be one of E_LogMessageType constants.
+			//! \return Returns false if logging such message would be a waste of time.
+			bool Accepts(uint32 msgType) const
+			{
+				return ( ( (uint32)AtomicLoad(&acceptedTypes) & msgType ) || msgType == LMT_Fatal );
+			}
+
+			//! \brief Returns clock used to stamp log records.
+			const CLogClock& GetClock() const { return clock; }
+
+			//! \brief Returns count of records discarded by all outputs' overflow policies.
+			uint32 GetDroppedCount()
+			{
+				uint32 count = 0;
+				channelListPtr_t snapshot = GetChannels();
+				for(channelList_t::const_iterator itor = snapshot->begin() ; itor != snapshot->end() ; ++itor)
+				{
+					SLogOutputStats stats;
+					(*itor)->GetStats(stats);
+					count += stats.dropped + stats.sampled;
+				}
+				return count;
+			}
+
+			//! \brief Returns count of records held back by rate limits.
+			uint32 GetSuppressedCount() const { return limiter.GetSuppressedCount(); }
+
+			//! \brief Sets rate limit for messages without a limit of their own.
+			//! \param limit: The limit; SLogLimit() turns it off.
+			//!
+			//! Messages are told apart by format string (LogF()) or text (Log()). Fatal messages
+			//! are never limited. Records held back are counted, and reported with a
+			//! "similar messages suppressed" summary of the same type once the limit's interval
+			//! is over (or on Flush()).
+			void SetDefaultLimit(const SLogLimit& limit) { limiter.SetDefaultLimit(limit); }
+
+			//! \brief Sets rate limit for a single message.
+			//! \param key: Format string of the message if it's logged with LogF(); text otherwise.
+			//! \param limit: The limit; SLogLimit() turns it off.
+			void SetLimit(const char8* key, const SLogLimit& limit) { limiter.SetLimit(key, limit); }
+
+			//! \brief Reads delivery statistics of an output.
+			//! \param output: Pointer to log output.
+			//! \param stats: Receives statistics.
+			//! \return Returns true if output is registered; false otherwise.
+			bool GetOutputStats(ILogOutput* output, SLogOutputStats& stats)
+			{
+				channelListPtr_t snapshot = GetChannels();
+				for(channelList_t::const_iterator itor = snapshot->begin() ; itor != snapshot->end() ; ++itor)
+				{
+					if( (*itor)->GetOutput() == output )
+					{
+						(*itor)->GetStats(stats);
+						return true;
+					}
+				}
+				return false;
+			}
+
+			//! \brief Adds an log output to the logger.
+			//! \param output: Pointer to log output.
+			//! \param filter: Describes output filter. Use | operator [binary OR] to
+			//!			specify which message types should be *passed* to the output.
+			//! \return Returns true after successful output registering; false otherwise.
+			//!
+			//! Pointer to log output should not be NULL - otherwise it will be ignored.
+			//! No checks for duplicates are made, the same output may be registered more than once.
+			//! Safe to call while other threads are logging.
+			virtual bool AddLogOutput(ILogOutput* output, uint32 filter)
+			{
+				return AddOutputChannel(output, filter, LOP_Block, 1, true);
+			}
+
+			//! \brief Adds an log output with its own overflow policy.
+			//! \param output: Pointer to log output.
+			//! \param filter: Message types passed to the output; see above.
+			//! \param policy: What to do when output's queue is full, in asynchronous mode.
+			//! \param sampleRate: For LOP_Sample - once the queue is over half full, only every
+			//!			sampleRate-th record is kept. Errors are never sampled out.
+			//! \return Returns true after successful output registering; false otherwise.
+			virtual bool AddLogOutput(ILogOutput* output, uint32 filter, E_LogOverflowPolicy policy, uint32 sampleRate = 10)
+			{
+				return AddOutputChannel(output, filter, policy, sampleRate, false);
+			}
+
+			//! \brief Removes an log output from the logger.
+			//! \param output: Pointer to log output.
+			//! \return Returns true if output was found and unregistered; false otherwise.
+			//!
+			//! This function does not destroy the log output; it's up to it's owner.
+			//! This function removes first output maching address, so if an output is registered
+			//! more than once, then more than one call of this function is needed.
+			//! In asynchronous mode records queued so far are written before the output is removed.
+			//! Safe to call while other threads are logging; once it returns, the output won't be used.
+			virtual bool RemoveLogOutput(ILogOutput* output)
+			{
+				channelPtr_t removed;
+				{
+					boost::mutex::scoped_lock lock(changeMutex);
+
+					//try to find our output
+					channelListPtr_t snapshot = GetChannels();
+					channelList_t::const_iterator itor = snapshot->begin();
+					for( ; itor != snapshot->end() ; ++itor)
+					{
+						if( (*itor)->GetOutput() == output)
+						{
+							break;
+						}
+					}
+					if(itor == snapshot->end())
+					{
+						//not found
+						return false;
+					}
+
+					//we've found our output; publish a list without it
+					removed = *itor;
+					channelList_t* newChannels = new channelList_t(*snapshot);
+					newChannels->erase(newChannels->begin() + (itor - snapshot->begin()));
+					SetChannels(channelListPtr_t(newChannels));
+				}
+
+				//wait for threads still holding older snapshots, then drain the queue
+				while(!removed.unique())
+				{
+					boost::thread::yield();
+				}
+				removed->Stop();
+				removed->Flush();
+
+				removed->WriteNow(LMT_Info, "CLogger::RemoveLogOutput() - Detached from Logger.");
+				return true;
+			}
+
+		protected:
+			//! \brief Registers a new output channel; publishes a new output list.
+			bool AddOutputChannel(ILogOutput* output, uint32 filter, E_LogOverflowPolicy policy, uint32 sampleRate, bool bDefaultPolicy)
+			{
+				if(output == NULL)	//ignore NULL log output
+				{
+					return false;
+				}
+
+				channelPtr_t channel(new CLogOutputChannel(output, filter, policy, sampleRate, bDefaultPolicy, clock));
+				channel->WriteNow(LMT_Info, "CLogger::AddLogOutput() - Attached to Logger.");
+
+				boost::mutex::scoped_lock lock(changeMutex);
+				if(bAsync)
+				{
+					channel->Start(asyncQueueSize, defaultPolicy);
+				}
+				channelList_t* newChannels = new channelList_t(*GetChannels());
+				newChannels->push_back(channel);
+				SetChannels(channelListPtr_t(newChannels));
+				return true;
+			}
+
+		public:
+			//! \brief Log message.
+			//! \param msgType: Type of log message, *should* be one of E_LogMessageType constants.
+			//! \param message: Message to be logged.
+			void Log(uint32 msgType, const char8* msg)
+			{
+				size_t length = strlen(msg);
+				if(!Accepts(msgType) || !Admit(msgType, msg, length))
+				{
+					return;
+				}
+
+				SLogRecord record;
+				Stamp(record, msgType);
+				record.format = NULL;
+				record.messageLength = CopyMessage(record, msg, length);
+				Submit(record);
+			}
+			void Log(uint32 msgType, const std::string& msg)
+			{
+				if(!Accepts(msgType) || !Admit(msgType, msg.data(), msg.size()))
+				{
+					return;
+				}
+
+				SLogRecord record;
+				Stamp(record, msgType);
+				record.format = NULL;
+				record.messageLength = CopyMessage(record, msg.data(), msg.size());
+				Submit(record);
+			}
+			void Log(uint32 msgType, const boost::format& msg)
+			{
+				if(!Accepts(msgType))	//don't pay for str() if nobody listens
+				{
+					return;
+				}
+				Log(msgType, msg.str());
+			}
+
+			//! \brief Log printf-style formatted message.
+			//! \param msgType: Type of log message, *should* be one of E_LogMessageType constants.
+			//! \param format: printf() format string, followed by its arguments.
+			//!
+			//! Arguments are only copied into the record; message is rendered later, if some
+			//! text output accepts it. format must outlive the logger - use string literals;
+			//! structured outputs identify formats by address.
+			//! Rate limits apply per format string, whatever the arguments.
+			void LogF(uint32 msgType, const char8* format, ...)
+			{
+				if(!Accepts(msgType) || !Admit(msgType, format, strlen(format)))
+				{
+					return;
+				}
+
+				va_list args;
+				va_start(args, format);
+				SubmitPacked(msgType, format, args);
+				va_end(args);
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+//! \brief Logs message through logger, if any of its outputs accepts msgType.
+//! message (std::string, char8* or boost::format expression) is evaluated only then.
+#define VCS_LOG_MESSAGE(logger, msgType, message) \
+	do \
+	{ \
+		if((logger).Accepts(msgType)) \
+		{ \
+			(logger).Log((msgType), (message)); \
+		} \
+	} \
+	while(0)
+
+//Per-type logging macros; those below VCS_LOG_MIN_LEVEL expand to nothing.
+#if VCS_LOG_MIN_LEVEL <= 0
+	#define VCS_LOG_DEBUG(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_Debug, message)
+#else
+	#define VCS_LOG_DEBUG(logger, message) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 1
+	#define VCS_LOG_INFO(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_Info, message)
+	#define VCS_LOG_TTS(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_TTS, message)
+#else
+	#define VCS_LOG_INFO(logger, message) ((void)0)
+	#define VCS_LOG_TTS(logger, message) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 2
+	#define VCS_LOG_SUCCESS(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_Success, message)
+#else
+	#define VCS_LOG_SUCCESS(logger, message) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 3
+	#define VCS_LOG_WARNING(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_Warning, message)
+#else
+	#define VCS_LOG_WARNING(logger, message) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 4
+	#define VCS_LOG_ERROR(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_Error, message)
+#else
+	#define VCS_LOG_ERROR(logger, message) ((void)0)
+#endif
+
+#define VCS_LOG_FATAL(logger, message) VCS_LOG_MESSAGE(logger, ::TRC::VCS::LMT_Fatal, message)
+
+//! \brief Logs printf-style message through logger, if any of its outputs accepts msgType.
+//! Arguments are evaluated only then.
+#define VCS_LOGF_MESSAGE(logger, msgType, ...) \
+	do \
+	{ \
+		if((logger).Accepts(msgType)) \
+		{ \
+			(logger).LogF((msgType), __VA_ARGS__); \
+		} \
+	} \
+	while(0)
+
+//Per-type printf-style logging macros; those below VCS_LOG_MIN_LEVEL expand to nothing.
+#if VCS_LOG_MIN_LEVEL <= 0
+	#define VCS_LOGF_DEBUG(logger, ...) VCS_LOGF_MESSAGE(logger, ::TRC::VCS::LMT_Debug, __VA_ARGS__)
+#else
+	#define VCS_LOGF_DEBUG(logger, ...) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 1
+	#define VCS_LOGF_INFO(logger, ...) VCS_LOGF_MESSAGE(logger, ::TRC::VCS::LMT_Info, __VA_ARGS__)
+#else
+	#define VCS_LOGF_INFO(logger, ...) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 2
+	#define VCS_LOGF_SUCCESS(logger, ...) VCS_LOGF_MESSAGE(logger, ::TRC::VCS::LMT_Success, __VA_ARGS__)
+#else
+	#define VCS_LOGF_SUCCESS(logger, ...) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 3
+	#define VCS_LOGF_WARNING(logger, ...) VCS_LOGF_MESSAGE(logger, ::TRC::VCS::LMT_Warning, __VA_ARGS__)
+#else
+	#define VCS_LOGF_WARNING(logger, ...) ((void)0)
+#endif
+
+#if VCS_LOG_MIN_LEVEL <= 4
+	#define VCS_LOGF_ERROR(logger, ...) VCS_LOGF_MESSAGE(logger, ::TRC::VCS::LMT_Error, __VA_ARGS__)
+#else
+	#define VCS_LOGF_ERROR(logger, ...) ((void)0)
+#endif
+
+#define VCS_LOGF_FATAL(logger, ...) VCS_LOGF_MESSAGE(logger, ::TRC::VCS::LMT_Fatal, __VA_ARGS__)
+
+#endif //__TRC_VCS_LOGGER_H__
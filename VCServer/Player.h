@@ -0,0 +1,72 @@
+#ifndef __TRC_VCS_PLAYER_H__
+#define __TRC_VCS_PLAYER_H__
+
+/*!
+\file Player.h
+\brief Interface of music players controlled by CWinAMPController.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	CPlayer_WinAMP (Player_WinAMP.h) drives WinAMP through its window messages;
+	the replay harness uses a stub that only counts commands.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			PLAYER_MAX_VOLUME = 255	//!< Volume of IPlayer::SetVolume() at full blast.
+		};
+
+		//! \brief Music player.
+		class IPlayer
+		{
+		public:
+			virtual ~IPlayer(){}	//!< Virtual d-tor.
+
+			//! \brief Looks for the player.
+			//! \return Returns true if player is running and may be controlled.
+			virtual bool Find() = 0;
+
+			//! \brief Opens a file (song, playlist) with its default application.
+			virtual void Open(const std::string& fileName) = 0;
+
+			virtual void Play() = 0;	//!< Starts or resumes playback.
+			virtual void Pause() = 0;	//!< Pauses playback, or resumes paused one.
+			virtual void Stop() = 0;	//!< Stops playback.
+			virtual void Next() = 0;	//!< Skips to the next song.
+			virtual void Previous() = 0;	//!< Goes back to the previous song.
+			virtual void ToggleShuffle() = 0;	//!< Switches shuffle on or off.
+			virtual void ToggleRepeat() = 0;	//!< Switches repeat on or off.
+
+			//! \brief Sets volume, 0 - PLAYER_MAX_VOLUME.
+			virtual void SetVolume(uint32 volume) = 0;
+
+			//! \brief Returns volume, 0 - PLAYER_MAX_VOLUME.
+			virtual uint32 GetVolume() = 0;
+
+			virtual void VolumeUp() = 0;	//!< Turns volume up a little.
+			virtual void VolumeDown() = 0;	//!< Turns volume down a little.
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_PLAYER_H__
@@ -0,0 +1,95 @@
+#ifndef __TRC_VCS_PLAYER_WINAMP_H__
+#define __TRC_VCS_PLAYER_WINAMP_H__
+
+/*!
+\file Player_WinAMP.h
+\brief WinAMP, controlled through its window messages.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Windows only. Message codes come from wa_ipc.h of WinAMP SDK.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <windows.h>
+
+#include "Player.h"
+#include "wa_ipc.h"	//<-- from WinAMP SDK
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief WinAMP player.
+		class CPlayer_WinAMP : public IPlayer
+		{
+		protected:
+			HWND hWinAMP;	//!< WinAMP main window.
+
+			//! \brief Presses a WinAMP button.
+			void Command(WPARAM command)
+			{
+				SendMessage(hWinAMP, WM_COMMAND, command, 0);
+			}
+
+			//! \brief Sends WinAMP IPC message.
+			LRESULT IPC(WPARAM parameter, LPARAM message)
+			{
+				return SendMessage(hWinAMP, WM_WA_IPC, parameter, message);
+			}
+
+		public:
+			CPlayer_WinAMP():hWinAMP(NULL){}	//!< Default c-tor.
+
+			virtual bool Find()
+			{
+				hWinAMP = FindWindow("Winamp v1.x", NULL);	//i guess...
+				return (hWinAMP != NULL);
+			}
+
+			virtual void Open(const std::string& fileName)
+			{
+				ShellExecute(NULL, "open", fileName.c_str(), NULL, NULL, SW_SHOWNORMAL);
+			}
+
+			virtual void Play(){ Command(WINAMP_BUTTON2); }
+			virtual void Pause(){ Command(WINAMP_BUTTON3); }
+			virtual void Stop(){ Command(WINAMP_BUTTON4); }
+			virtual void Next(){ Command(WINAMP_BUTTON5); }
+			virtual void Previous(){ Command(WINAMP_BUTTON1); }
+
+			virtual void ToggleShuffle()
+			{
+				LRESULT res = IPC(1, IPC_GET_SHUFFLE);
+				IPC((res == 0) ? 1 : 0, IPC_SET_SHUFFLE);
+			}
+
+			virtual void ToggleRepeat()
+			{
+				LRESULT res = IPC(1, IPC_GET_REPEAT);
+				IPC((res == 0) ? 1 : 0, IPC_SET_REPEAT);
+			}
+
+			virtual void SetVolume(uint32 volume){ IPC(volume, IPC_SETVOLUME); }
+			virtual uint32 GetVolume(){ return (uint32)IPC((WPARAM)-666, IPC_SETVOLUME); }	//-666 asks instead (WinAMP 5+)
+			virtual void VolumeUp(){ Command(WINAMP_VOLUMEUP); }
+			virtual void VolumeDown(){ Command(WINAMP_VOLUMEDOWN); }
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_PLAYER_WINAMP_H__
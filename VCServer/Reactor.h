@@ -0,0 +1,179 @@
+#ifndef __TRC_VCS_REACTOR_H__
+#define __TRC_VCS_REACTOR_H__
+
+/*!
+\file Reactor.h
+\brief Single-threaded event loop over waitables and timers.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	CReactor waits for all its event sources at once and calls their handlers
+	on its own thread, one after another: a waitable (recognizer's result
+	event, a player's notification handle...) that became signaled, or a timer
+	that expired. Handlers must not block - whatever they'd wait for should be
+	another event source, with the rest of the work done in its handler.
+
+	Waiting is done by CWaitSet, picked at build time: Waitable_WinAPI.h
+	(WaitForMultipleObjects on handles) on Windows, Waitable_epoll.h (epoll on
+	file descriptors) elsewhere.
+
+	Timers are one-shot, on CLogClock time, with millisecond resolution; they
+	all live in one CTimingWheel, so starting and stopping one is O(1), however
+	many are pending.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <map>
+
+#include <boost/noncopyable.hpp>
+
+#include "LogClock.h"
+#include "TimingWheel.h"
+
+#ifdef WIN32
+	#include "Waitable_WinAPI.h"
+#else //WIN32
+	#include "Waitable_epoll.h"
+#endif //WIN32
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Receives events from CReactor.
+		class IEventHandler
+		{
+		public:
+			virtual ~IEventHandler(){}	//!< Virtual d-tor.
+
+			//! \brief Called when an event source of the handler fires.
+			//! \param id: ID given when the source was registered.
+			virtual void OnEvent(uint32 id) = 0;
+		};
+
+		//! \brief Event loop dispatching waitables and timers to handlers.
+		class CReactor : private boost::noncopyable
+		{
+		public:
+			enum
+			{
+				MAX_READY = 16	//!< Max count of waitables handled per RunOnce().
+			};
+
+		protected:
+			//! \brief Watched waitable.
+			struct SSource
+			{
+				IEventHandler* handler;	//!< Who's told about it.
+				uint32 id;	//!< What handler is told.
+				waitable_t waitable;	//!< The waitable.
+			};
+			typedef std::map<uint32, SSource> sourceMap_t;	//!< Type of sources, by key.
+
+			CWaitSet waitSet;	//!< Watched waitables.
+			sourceMap_t watches;	//!< Watched waitables, by key given to waitSet.
+			CTimingWheel<IEventHandler> timers;	//!< Running timers.
+			uint32 nextKey;	//!< Key of the next source; never 0.
+
+			//! \brief Returns current tick of timers [ms].
+			static uint64 NowMs(){ return CLogClock::Now() / 1000000; }
+
+			//! \brief Returns a fresh source key.
+			uint32 NewKey()
+			{
+				if(++nextKey == 0)
+				{
+					++nextKey;
+				}
+				return nextKey;
+			}
+
+		public:
+			CReactor():timers(NowMs()), nextKey(0){}	//!< Default c-tor.
+
+			//! \brief Starts watching a waitable.
+			//! \param waitable: Waitable; the handler is called for as long as it's signaled.
+			//! \param handler: Handler to call.
+			//! \param id: Passed to handler.
+			//! \return Returns false if waitable can't be watched.
+			bool Watch(waitable_t waitable, IEventHandler* handler, uint32 id)
+			{
+				if(waitable == INVALID_WAITABLE)
+				{
+					return false;
+				}
+				uint32 key = NewKey();
+				if(!waitSet.Add(waitable, key))
+				{
+					return false;
+				}
+				SSource source = { handler, id, waitable };
+				watches[key] = source;
+				return true;
+			}
+
+			//! \brief Stops watching a waitable.
+			void Unwatch(waitable_t waitable)
+			{
+				for(sourceMap_t::iterator itor = watches.begin() ; itor != watches.end() ; ++itor)
+				{
+					if((*itor).second.waitable == waitable)
+					{
+						waitSet.Remove(waitable);
+						watches.erase(itor);
+						return;
+					}
+				}
+			}
+
+			//! \brief Starts a one-shot timer.
+			//! \param ms: Time [ms] until handler is called.
+			//! \param handler: Handler to call.
+			//! \param id: Passed to handler.
+			//! \return Returns handle of the timer; never 0.
+			uint32 SetTimer(uint32 ms, IEventHandler* handler, uint32 id)
+			{
+				return timers.Schedule(NowMs() + ms, handler, id);
+			}
+
+			//! \brief Stops a timer, if it didn't fire yet.
+			//! \param timer: Handle from SetTimer(); 0 is ignored.
+			void CancelTimer(uint32 timer)
+			{
+				timers.Cancel(timer);
+			}
+
+			//! \brief Waits for the first event and calls handlers of everything that's ready.
+			void RunOnce()
+			{
+				uint32 ready[MAX_READY];
+				uint32 count = waitSet.Wait(timers.GetWaitTime(NowMs()), ready, MAX_READY);
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					sourceMap_t::iterator itor = watches.find(ready[i]);
+					if(itor != watches.end())	//an earlier handler may have unwatched it
+					{
+						(*itor).second.handler->OnEvent((*itor).second.id);
+					}
+				}
+
+				timers.Advance(NowMs());
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_REACTOR_H__
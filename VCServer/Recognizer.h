@@ -0,0 +1,157 @@
+#ifndef __TRC_VCS_RECOGNIZER_H__
+#define __TRC_VCS_RECOGNIZER_H__
+
+/*!
+\file Recognizer.h
+\brief Interface of speech recognition backends.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	VC System talks to speech recognition only through IRecognizer, so the
+	command pipeline doesn't care where results come from. Implementations:
+	CRecognizer_SAPI (Recognizer_SAPI.h) - Microsoft Speech API, Windows only;
+	CRecognizer_Replay (Recognizer_Replay.h) - plays back a transcript, anywhere.
+
+	Grammars are SAPI XML grammar files. A loaded grammar is enabled, with all
+	its rules inactive - whatever TOPLEVEL says; the caller activates the ones
+	it listens for. SetRuleStates() changes any number of rules in one go (see
+	RuleActivation.h), so the engine isn't resynced after each.
+
+	Results can be waited for (WaitForResult()), or polled (PollResult())
+	whenever GetWaitable() is signaled - that's how VC System's CReactor
+	listens, next to its other event sources. Polling may also deliver
+	hypotheses - what the engine makes of an utterance so far - so a command
+	can be acted on before the utterance is over (see EarlyExecution.h).
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <vector>
+
+#include "Reactor.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			RECO_INFINITE = 0xFFFFFFFF,	//!< Timeout of IRecognizer::WaitForResult() that never expires.
+			RECO_INVALID_GRAMMAR = 0xFFFFFFFF,	//!< Returned by IRecognizer::LoadGrammar() on failure.
+			RECO_ALL_RULES = 0,	//!< Rule ID for IRecognizer::SetRuleState() meaning every top-level rule of the grammar.
+			RECO_MAX_ALTERNATES = 4	//!< Max count of SRecoResult::alternates.
+		};
+
+		//! \brief Outcome of IRecognizer::WaitForResult().
+		enum E_RecoStatus
+		{
+			RS_Recognized = 0,	//!< A command was recognized.
+			RS_Timeout,	//!< Nothing recognized in time.
+			RS_Finished,	//!< Recognizer won't deliver anything more (ie. transcript is over).
+			RS_Failed,	//!< Recognizer error.
+			RS_Pending,	//!< Nothing recognized yet; PollResult() only.
+			RS_Hypothesis	//!< Guess at an utterance still being spoken; its RS_Recognized (or nothing) follows. PollResult() only, if SetHypotheses() is on.
+		};
+
+		//! \brief Something else the engine thought a recognized utterance might be.
+		struct SRecoAlternate
+		{
+			uint32 grammarId;	//!< ID the grammar was loaded with.
+			uint32 ruleId;	//!< ID of top-level rule matched.
+			uint32 value;	//!< Value of the rule's property; 0 if none.
+			float32 confidence;	//!< Engine's confidence, 0.0 - 1.0.
+			std::string text;	//!< Recognized text.
+
+			SRecoAlternate():grammarId(0), ruleId(0), value(0), confidence(0.0f){}
+		};
+
+		//! \brief Recognized command.
+		struct SRecoResult
+		{
+			uint32 grammarId;	//!< ID the grammar was loaded with.
+			uint32 ruleId;	//!< ID of top-level rule matched.
+			uint32 value;	//!< Value of the rule's property (VAL of the phrase matched); 0 if none.
+			float32 confidence;	//!< Engine's confidence, 0.0 - 1.0.
+			uint64 speechStart;	//!< CLogClock::Now() when utterance began.
+			uint64 speechEnd;	//!< CLogClock::Now() when utterance ended.
+			uint64 recognized;	//!< CLogClock::Now() when result was delivered.
+			uint64 decoded;	//!< CLogClock::Now() when phrase was decoded.
+			std::string text;	//!< Recognized text.
+			std::vector<SRecoAlternate> alternates;	//!< Runners-up (n-best), best first; up to RECO_MAX_ALTERNATES, and maybe none.
+
+			SRecoResult():grammarId(0), ruleId(0), value(0), confidence(0.0f), speechStart(0), speechEnd(0), recognized(0), decoded(0){}
+		};
+
+		//! \brief Change of a rule's state, for IRecognizer::SetRuleStates().
+		struct SRuleState
+		{
+			uint32 grammar;	//!< Grammar handle.
+			uint32 ruleId;	//!< ID of top-level rule, or RECO_ALL_RULES.
+			bool bActive;	//!< Activate, or deactivate it?
+		};
+
+		//! \brief Speech recognition backend.
+		class IRecognizer
+		{
+		public:
+			virtual ~IRecognizer(){}	//!< Virtual d-tor.
+
+			//! \brief Initializes recognizer.
+			//! \return Returns true on success; false otherwise.
+			virtual bool Init() = 0;
+
+			//! \brief Releases grammars and the engine.
+			virtual bool DeInit() = 0;
+
+			//! \brief Loads a SAPI XML grammar.
+			//! \param grammarId: ID reported in results of this grammar.
+			//! \param fileName: Name of grammar file.
+			//! \return Returns grammar handle for functions below, or RECO_INVALID_GRAMMAR on failure. Its rules are inactive.
+			virtual uint32 LoadGrammar(uint32 grammarId, const std::string& fileName) = 0;
+
+			//! \brief Enables or disables a whole grammar; rule states are kept.
+			virtual void SetGrammarState(uint32 grammar, bool bEnabled) = 0;
+
+			//! \brief Activates or deactivates a top-level rule of a grammar; RECO_ALL_RULES - all of them, in one call.
+			virtual void SetRuleState(uint32 grammar, uint32 ruleId, bool bActive) = 0;
+
+			//! \brief Activates and deactivates top-level rules, as one change.
+			//! \param states: Changes, count of them.
+			//! \return Returns count of calls into the engine it took.
+			virtual uint32 SetRuleStates(const SRuleState* states, uint32 count) = 0;
+
+			//! \brief Turns RS_Hypothesis results of PollResult() on or off; off after Init().
+			virtual void SetHypotheses(bool bEnabled) = 0;
+
+			//! \brief Waits for the next recognized command.
+			//! \param result: Receives the command.
+			//! \param timeout: Max time to wait [ms], or RECO_INFINITE.
+			//! \return Returns RS_Recognized if result was filled.
+			virtual E_RecoStatus WaitForResult(SRecoResult& result, uint32 timeout = RECO_INFINITE) = 0;
+
+			//! \brief Returns waitable signaled while a result may be waiting; valid after Init().
+			virtual waitable_t GetWaitable() = 0;
+
+			//! \brief Takes the next recognized command, if there is one; doesn't block.
+			//! \param result: Receives the command.
+			//! \param timeLeft: What's left of the caller's timeout [ms], or RECO_INFINITE; for recognizers keeping their own time.
+			//! \return Returns RS_Recognized if result was filled; RS_Pending if nothing's there yet.
+			virtual E_RecoStatus PollResult(SRecoResult& result, uint32 timeLeft = RECO_INFINITE) = 0;
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_RECOGNIZER_H__
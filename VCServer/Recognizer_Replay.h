@@ -0,0 +1,504 @@
+#ifndef __TRC_VCS_RECOGNIZER_REPLAY_H__
+#define __TRC_VCS_RECOGNIZER_REPLAY_H__
+
+/*!
+\file Recognizer_Replay.h
+\brief Recognizer playing back a transcript of utterances.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Transcript (like grammar/cmds.txt) has one utterance per line. Every utterance
+	comes the default interval after the previous one; a line may start with
+	"@<ms>" to give its own delay. A line with a delay only is just silence. Empty
+	lines and lines starting with '#' are skipped. "~<text>" (after the delay, if
+	any) is a hypothesis - delivered as RS_Hypothesis while SetHypotheses() is
+	on, and skipped otherwise; the line after it is what the utterance turned
+	out to be. "%<n>" at the end of text makes the engine n% confident of it
+	(100 if not given), and "| <text>" adds an alternate (n-best) reading, like
+	"@500 next %40 | previous %35".
+
+	An utterance is recognized if it matches, word for word (case doesn't matter),
+	a phrase of an active rule of an enabled grammar - the way SAPI command and
+	control works; other utterances are dropped, like SAPI would. Phrases of all
+	grammars are looked up in a CGrammarMatcher, compiled whenever one's loaded.
+	Grammars are expanded through CGrammarCache, so XML is parsed only when it
+	changed.
+	Timeouts are counted in transcript time, so runs are repeatable; with
+	bRealTime off, nobody actually waits and the transcript plays as fast as
+	it's consumed.
+
+	With SetFuzzy() on, an utterance that matches no phrase is taken as the
+	phrase of an active rule nearest to it (CFuzzyMatcher), if any is near
+	enough - the way text of a recognizer that doesn't know our grammars
+	would be; confidence is scaled by how near it is, and the runners-up are
+	its alternates.
+
+	GetWaitable() is a timer: with bRealTime on, it expires when the next
+	utterance is due, and the caller's own timers time listening out; with it
+	off, it's always expired and PollResult() counts timeouts in transcript
+	time, like WaitForResult().
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include "Logger.h"
+#include "Recognizer.h"
+#include "Reactor.h"
+#include "GrammarXML.h"
+#include "GrammarCache.h"
+#include "GrammarMatcher.h"
+#include "FuzzyMatcher.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Recognizer reading utterances from a transcript file.
+		class CRecognizer_Replay : public IRecognizer
+		{
+		protected:
+			//! \brief What the engine may make of an utterance.
+			struct SReading
+			{
+				std::vector<std::string> words;	//!< Lowercase words; none for silence.
+				std::string text;	//!< As written.
+				float32 confidence;	//!< Engine's confidence in it.
+			};
+
+			//! \brief Single utterance of the transcript.
+			struct SUtterance : public SReading
+			{
+				uint32 delay;	//!< Silence before it [ms].
+				bool bHypothesis;	//!< Is it a hypothesis?
+				std::vector<SReading> alternates;	//!< Runners-up, best first.
+			};
+
+			//! \brief Loaded grammar with its state.
+			struct SLoadedGrammar
+			{
+				uint32 id;	//!< ID given to LoadGrammar().
+				bool bEnabled;	//!< Is grammar enabled?
+				SGrammar grammar;	//!< Rules; SGrammarRule::bActive is the current state.
+			};
+
+			CLogger& logger;	//!< Where to report progress.
+			std::string fileName;	//!< Transcript file.
+			uint32 interval;	//!< Default delay between utterances [ms].
+			bool bRealTime;	//!< Really wait for delays?
+			bool bHypotheses;	//!< Deliver hypotheses?
+			bool bFuzzy;	//!< Take utterances matching no phrase as the nearest one?
+
+			CGrammarMatcher matcher;	//!< Phrases of all grammars.
+			CFuzzyMatcher fuzzy;	//!< Phrases of all grammars, for bFuzzy.
+
+			std::vector<SUtterance> utterances;	//!< The transcript.
+			size_t next;	//!< Index of the next utterance.
+			uint32 pending;	//!< Silence left before the next utterance [ms].
+			std::vector<SLoadedGrammar> grammars;	//!< Grammars, indexed by handle.
+			CWaitableTimer ready;	//!< Expires when the next utterance is due.
+
+			//! \brief Tells CFuzzyMatcher::Find() which rules are active.
+			struct SIsActive
+			{
+				const std::vector<SLoadedGrammar>& grammars;	//!< Grammars of the recognizer.
+
+				SIsActive(const std::vector<SLoadedGrammar>& _grammars):grammars(_grammars){}	//!< C-tor.
+
+				bool operator()(uint32 grammar, uint32 rule) const
+				{
+					return grammars[grammar].bEnabled && grammars[grammar].grammar.rules[rule].bActive;
+				}
+			};
+
+			//! \brief Waits, if in real time mode.
+			void Idle(uint32 ms)
+			{
+				if(bRealTime && ms > 0)
+				{
+					boost::this_thread::sleep(boost::posix_time::milliseconds((long)ms));
+				}
+			}
+
+			//! \brief Arms ready for the next utterance.
+			void ArmReady()
+			{
+				ready.Arm((bRealTime) ? pending : 0);
+			}
+
+			//! \brief Takes the next utterance; it's due.
+			//! \param bHypothesis: Receives true if it's a hypothesis.
+			//! \return Returns true and fills result if it's recognized.
+			bool Take(SRecoResult& result, bool& bHypothesis)
+			{
+				const SUtterance& utterance = utterances[next];
+				++next;
+				pending = (next < utterances.size()) ? utterances[next].delay : 0;
+
+				bHypothesis = utterance.bHypothesis;
+				if(bHypothesis && !bHypotheses)
+				{
+					return false;
+				}
+				uint64 now = CLogClock::Now();
+				SRecoAlternate match;
+				if(Match(utterance.words, match))
+				{
+					result.grammarId = match.grammarId;
+					result.ruleId = match.ruleId;
+					result.value = match.value;
+					result.confidence = utterance.confidence;
+					result.speechStart = result.speechEnd = result.recognized = result.decoded = now;
+					result.text = utterance.text;
+					result.alternates.clear();
+					for(std::vector<SReading>::const_iterator alternate = utterance.alternates.begin() ; alternate != utterance.alternates.end() && !bHypothesis ; ++alternate)
+					{
+						if(Match((*alternate).words, match) && result.alternates.size() < RECO_MAX_ALTERNATES)
+						{
+							match.confidence = (*alternate).confidence;
+							match.text = (*alternate).text;
+							result.alternates.push_back(match);
+						}
+					}
+					return true;
+				}
+				if(bFuzzy && !bHypothesis && MatchFuzzy(utterance, result))
+				{
+					result.speechStart = result.speechEnd = result.recognized = result.decoded = now;
+					return true;
+				}
+				if(!utterance.words.empty())
+				{
+					VCS_LOGF_DEBUG(logger, "CRecognizer_Replay - Not recognized: %s", utterance.text.c_str());
+				}
+				return false;
+			}
+
+			//! \brief Waits for the next result, in transcript time.
+			//! \param bTakeHypotheses: Return hypotheses too; they're skipped otherwise.
+			//! \return Returns RS_Recognized or RS_Hypothesis if result was filled.
+			E_RecoStatus TakeResult(SRecoResult& result, uint32 timeout, bool bTakeHypotheses)
+			{
+				uint32 waited = 0;
+				while(next < utterances.size())
+				{
+					if(timeout != RECO_INFINITE && pending > timeout - waited)
+					{
+						Idle(timeout - waited);
+						pending -= timeout - waited;
+						return RS_Timeout;
+					}
+					Idle(pending);
+					waited += pending;
+					bool bHypothesis;
+					if(Take(result, bHypothesis) && (bTakeHypotheses || !bHypothesis))
+					{
+						return (bHypothesis) ? RS_Hypothesis : RS_Recognized;
+					}
+				}
+				return RS_Finished;
+			}
+
+			//! \brief Reads the transcript.
+			bool ReadTranscript()
+			{
+				FILE* file = fopen(fileName.c_str(), "rt");
+				if(file == NULL)
+				{
+					return false;
+				}
+
+				char8 line[1024];
+				while(fgets(line, sizeof(line), file))
+				{
+					std::string text(line);
+					text.erase(text.find_last_not_of(" \t\r\n") + 1);
+					text.erase(0, text.find_first_not_of(" \t"));
+					if(text.empty() || text[0] == '#')
+					{
+						continue;
+					}
+
+					SUtterance utterance;
+					utterance.delay = interval;
+					utterance.bHypothesis = false;
+					if(text[0] == '@')
+					{
+						char8* end;
+						utterance.delay = (uint32)strtoul(text.c_str() + 1, &end, 10);
+						text.erase(0, end - text.c_str());
+						text.erase(0, text.find_first_not_of(" \t"));
+					}
+					if(!text.empty() && text[0] == '~')
+					{
+						utterance.bHypothesis = true;
+						text.erase(0, text.find_first_not_of(" \t", 1));
+					}
+
+					size_t bar = text.find('|');
+					ParseReading(text.substr(0, bar), utterance);
+					while(bar != std::string::npos)
+					{
+						size_t next = text.find('|', bar + 1);
+						SReading alternate;
+						ParseReading(text.substr(bar + 1, (next == std::string::npos) ? std::string::npos : next - bar - 1), alternate);
+						utterance.alternates.push_back(alternate);
+						bar = next;
+					}
+					utterances.push_back(utterance);
+				}
+				fclose(file);
+				return true;
+			}
+
+			//! \brief Reads a reading of a transcript line: text, with "%<confidence>" at the end, maybe.
+			static void ParseReading(const std::string& line, SReading& reading)
+			{
+				std::string text(line);
+				text.erase(text.find_last_not_of(" \t") + 1);
+				text.erase(0, text.find_first_not_of(" \t"));
+				reading.confidence = 1.0f;
+				size_t percent = text.rfind('%');
+				if(percent != std::string::npos)
+				{
+					reading.confidence = (float32)atoi(text.c_str() + percent + 1) / 100.0f;
+					text.erase(percent);
+					text.erase(text.find_last_not_of(" \t") + 1);
+				}
+				reading.text = text;
+
+				reading.words.clear();
+				std::string word;
+				for(size_t i = 0 ; i <= text.size() ; ++i)
+				{
+					if(i == text.size() || isspace((uint8)text[i]))
+					{
+						if(!word.empty())
+						{
+							reading.words.push_back(word);
+							word.clear();
+						}
+					}
+					else
+					{
+						word += (char8)tolower((uint8)text[i]);
+					}
+				}
+			}
+
+			//! \brief Looks for a phrase of an active rule matching words.
+			//! \param match: Receives grammar, rule and value of the phrase.
+			//! \return Returns true if one was found.
+			bool Match(const std::vector<std::string>& words, SRecoAlternate& match) const
+			{
+				const SGrammarMatch* found = NULL;
+				uint32 count = matcher.Find(words, found);
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					const SLoadedGrammar& grammar = grammars[found[i].grammar];
+					if(grammar.bEnabled && grammar.grammar.rules[found[i].rule].bActive)
+					{
+						match.grammarId = grammar.id;
+						match.ruleId = found[i].ruleId;
+						match.value = found[i].value;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			//! \brief Takes utterance as the phrases of active rules nearest to it.
+			//! \param result: Receives the nearest one, with the rest as alternates; timestamps aren't set.
+			//! \return Returns false if no phrase is near enough.
+			bool MatchFuzzy(const SUtterance& utterance, SRecoResult& result)
+			{
+				SFuzzyMatch found[RECO_MAX_ALTERNATES + 1];
+				uint32 count = fuzzy.Find(utterance.text, SIsActive(grammars), found, RECO_MAX_ALTERNATES + 1);
+				if(count == 0)
+				{
+					return false;
+				}
+				VCS_LOGF_DEBUG(logger, "CRecognizer_Replay - \"%s\" taken as \"%s\", %u letters off", utterance.text.c_str(), found[0].text.c_str(), found[0].distance);
+				result.grammarId = grammars[found[0].grammar].id;
+				result.ruleId = found[0].ruleId;
+				result.value = found[0].value;
+				result.confidence = utterance.confidence * found[0].similarity;
+				result.text = found[0].text;
+				result.alternates.clear();
+				for(uint32 i = 1 ; i < count ; ++i)
+				{
+					if(found[i].ruleId == result.ruleId && found[i].value == result.value)
+					{
+						continue;	//another phrase of the same command
+					}
+					SRecoAlternate alternate;
+					alternate.grammarId = grammars[found[i].grammar].id;
+					alternate.ruleId = found[i].ruleId;
+					alternate.value = found[i].value;
+					alternate.confidence = utterance.confidence * found[i].similarity;
+					alternate.text = found[i].text;
+					result.alternates.push_back(alternate);
+				}
+				return true;
+			}
+
+		public:
+			//! \brief C-tor.
+			//! \param _logger: Logger to report to.
+			//! \param _fileName: Transcript file.
+			//! \param _interval: Default delay between utterances [ms].
+			//! \param _bRealTime: Really wait for delays; otherwise play as fast as possible.
+			CRecognizer_Replay(CLogger& _logger, const std::string& _fileName, uint32 _interval = 0, bool _bRealTime = true)
+				:logger(_logger), fileName(_fileName), interval(_interval), bRealTime(_bRealTime), bHypotheses(false), bFuzzy(false), next(0), pending(0){}
+
+			virtual bool Init()
+			{
+				utterances.clear();
+				bHypotheses = false;
+				if(!ReadTranscript())
+				{
+					VCS_LOGF_ERROR(logger, "CRecognizer_Replay::Init() - Can't read transcript %s", fileName.c_str());
+					return false;
+				}
+				Rewind();
+				VCS_LOGF_SUCCESS(logger, "CRecognizer_Replay::Init() - %u utterances to replay from %s", (uint32)utterances.size(), fileName.c_str());
+				return true;
+			}
+
+			//! \brief Starts the transcript over; grammar and rule states stay as they are.
+			void Rewind()
+			{
+				next = 0;
+				pending = utterances.empty() ? 0 : utterances[0].delay;
+				ArmReady();
+			}
+
+			virtual bool DeInit()
+			{
+				grammars.clear();
+				matcher.Clear();
+				fuzzy.Clear();
+				return true;
+			}
+
+			virtual uint32 LoadGrammar(uint32 grammarId, const std::string& grammarFile)
+			{
+				SLoadedGrammar loaded;
+				loaded.id = grammarId;
+				loaded.bEnabled = true;
+				std::string error;
+				bool bCached, bStored;
+				if(!CGrammarCache::LoadGrammar(grammarFile, loaded.grammar, error, bCached, bStored))
+				{
+					VCS_LOGF_ERROR(logger, "CRecognizer_Replay::LoadGrammar() - %s: %s", grammarFile.c_str(), error.c_str());
+					return RECO_INVALID_GRAMMAR;
+				}
+				if(!bStored)
+				{
+					VCS_LOGF_WARNING(logger, "CRecognizer_Replay::LoadGrammar() - %s: can't write cache", grammarFile.c_str());
+				}
+				VCS_LOGF_INFO(logger, "CRecognizer_Replay::LoadGrammar() - %s %s", grammarFile.c_str(), (bCached) ? "from cache" : "compiled");
+				for(std::vector<SGrammarRule>::iterator rule = loaded.grammar.rules.begin() ; rule != loaded.grammar.rules.end() ; ++rule)
+				{
+					(*rule).bActive = false;	//SAPI's loaded inactive too
+				}
+				grammars.push_back(loaded);
+
+				matcher.Clear();
+				fuzzy.Clear();
+				for(size_t i = 0 ; i < grammars.size() ; ++i)
+				{
+					matcher.Add((uint32)i, grammars[i].grammar);
+					fuzzy.Add((uint32)i, grammars[i].grammar);
+				}
+				matcher.Compile();
+				fuzzy.Compile();
+				return (uint32)grammars.size() - 1;
+			}
+
+			virtual void SetGrammarState(uint32 grammar, bool bEnabled)
+			{
+				if(grammar < grammars.size())
+				{
+					grammars[grammar].bEnabled = bEnabled;
+				}
+			}
+
+			virtual void SetRuleState(uint32 grammar, uint32 ruleId, bool bActive)
+			{
+				if(grammar >= grammars.size())
+				{
+					return;
+				}
+				std::vector<SGrammarRule>& rules = grammars[grammar].grammar.rules;
+				for(std::vector<SGrammarRule>::iterator rule = rules.begin() ; rule != rules.end() ; ++rule)
+				{
+					if(((*rule).id == ruleId || ruleId == RECO_ALL_RULES) && (*rule).bTopLevel)
+					{
+						(*rule).bActive = bActive;
+					}
+				}
+			}
+
+			virtual uint32 SetRuleStates(const SRuleState* states, uint32 count)
+			{
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					SetRuleState(states[i].grammar, states[i].ruleId, states[i].bActive);
+				}
+				return count;
+			}
+
+			virtual void SetHypotheses(bool bEnabled){ bHypotheses = bEnabled; }
+
+			//! \brief Turns taking utterances that match no phrase as the nearest one on or off; off by default.
+			void SetFuzzy(bool bEnabled){ bFuzzy = bEnabled; }
+
+			virtual E_RecoStatus WaitForResult(SRecoResult& result, uint32 timeout = RECO_INFINITE)
+			{
+				return TakeResult(result, timeout, false);
+			}
+
+			virtual waitable_t GetWaitable(){ return ready.GetWaitable(); }
+
+			virtual E_RecoStatus PollResult(SRecoResult& result, uint32 timeLeft = RECO_INFINITE)
+			{
+				ready.Clear();
+				E_RecoStatus status = RS_Finished;
+				if(bRealTime && next < utterances.size())
+				{
+					bool bHypothesis;
+					status = (Take(result, bHypothesis)) ? ((bHypothesis) ? RS_Hypothesis : RS_Recognized) : RS_Pending;	//ready expired, so it's due
+				}
+				else if(!bRealTime)
+				{
+					status = TakeResult(result, timeLeft, bHypotheses);	//nobody waits anyway
+				}
+				ArmReady();
+				return status;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_RECOGNIZER_REPLAY_H__
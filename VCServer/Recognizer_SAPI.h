@@ -0,0 +1,442 @@
+#ifndef __TRC_VCS_RECOGNIZER_SAPI_H__
+#define __TRC_VCS_RECOGNIZER_SAPI_H__
+
+/*!
+\file Recognizer_SAPI.h
+\brief Recognizer using Microsoft Speech API.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Uses the shared recognizer, with one recognition context for all grammars.
+	COM must be initialized by the caller.
+
+	GetWaitable() is the context's notify event. It's set once for however many
+	events got queued, so PollResult() sets it again after taking one - the
+	next poll finds out if there was anything else.
+
+	Timestamps of results come from SPRECORESULTTIMES: the utterance's start tick
+	and length are moved onto CLogClock's time line.
+
+	Alternates come from ISpRecoResult::GetAlternates(), if the engine keeps
+	any for command and control grammars.
+
+	SetRuleStates() pauses the context around batches of PAUSE_MIN_CHANGES
+	changes or more: the engine takes them in at once on Resume(), instead of
+	syncing to every one. Pause() and Resume() are two more calls into the
+	engine's process, so menu transitions - up to four rule changes - go
+	without.
+	SetRuleState(grammar, RECO_ALL_RULES, ...) is one ISpRecoGrammar::SetRuleState()
+	for the whole grammar.
+
+	Hypotheses are SPEI_HYPOTHESIS events; the context is only interested in
+	them while SetHypotheses() is on. WaitForResult() passes them over.
+
+	LoadGrammar() doesn't have SAPI compile the XML on every start: it compiles
+	it with ISpGrammarCompiler once, caches the binary grammar next to the XML
+	(CGrammarCache, "cfg"), and loads it with LoadCmdFromMemory() while the XML
+	stays the same. If anything about that fails, it's LoadCmdFromFile() as
+	before.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <string>
+#include <vector>
+
+#include <sapi.h>
+#include <sphelper.h>
+
+#include "GrammarCache.h"
+#include "Logger.h"
+#include "Recognizer.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief SAPI speech recognizer.
+		class CRecognizer_SAPI : public IRecognizer
+		{
+		public:
+			enum
+			{
+				WAIT_LOG_INTERVAL = 10000,	//!< "Awaiting for event" is logged at most once per that many [ms].
+				PAUSE_MIN_CHANGES = 8	//!< SetRuleStates() pauses the context for batches of that many changes or more.
+			};
+
+		protected:
+			CLogger& logger;	//!< Where to report progress.
+			CComPtr<ISpRecognizer> recoEngine;	//!< Recognition engine.
+			CComPtr<ISpRecoContext> recoContext;	//!< Recognition context.
+			std::vector< CComPtr<ISpRecoGrammar> > grammars;	//!< Grammars, indexed by handle.
+			bool bHypotheses;	//!< Deliver hypotheses?
+
+			//! \brief Compiles XML grammar into a binary one.
+			//! \param source: Contents of the XML file.
+			//! \param binary: Receives the SPBINARYGRAMMAR.
+			//! \return Returns false if it can't be compiled.
+			static bool Compile(const std::string& source, std::string& binary)
+			{
+				CComPtr<ISpGrammarCompiler> compiler;
+				CComPtr<IStream> input;
+				CComPtr<IStream> output;
+				if(source.empty() || FAILED(compiler.CoCreateInstance(CLSID_SpGrammarCompiler))
+					|| FAILED(CreateStreamOnHGlobal(NULL, TRUE, &input)) || FAILED(CreateStreamOnHGlobal(NULL, TRUE, &output)))
+				{
+					return false;
+				}
+				ULONG written = 0;
+				LARGE_INTEGER zero;
+				zero.QuadPart = 0;
+				if(FAILED(input->Write(source.data(), (ULONG)source.size(), &written)) || written != source.size()
+					|| FAILED(input->Seek(zero, STREAM_SEEK_SET, NULL)))
+				{
+					return false;
+				}
+				if(FAILED(compiler->CompileStream(input, output, NULL, NULL, NULL, 0)))
+				{
+					return false;
+				}
+
+				ULARGE_INTEGER size;
+				if(FAILED(output->Seek(zero, STREAM_SEEK_CUR, &size)) || size.QuadPart < sizeof(SPBINARYGRAMMAR)
+					|| FAILED(output->Seek(zero, STREAM_SEEK_SET, NULL)))
+				{
+					return false;
+				}
+				binary.resize((size_t)size.QuadPart);
+				ULONG read = 0;
+				return SUCCEEDED(output->Read(&binary[0], (ULONG)binary.size(), &read)) && read == binary.size();
+			}
+
+			//! \brief Checks if data holds a whole binary grammar.
+			static bool IsBinaryGrammar(const std::string& binary)
+			{
+				return binary.size() >= sizeof(SPBINARYGRAMMAR)
+					&& ((const SPBINARYGRAMMAR*)binary.data())->ulTotalSerializedSize == binary.size();
+			}
+
+			//! \brief Loads binary grammar of an XML file, from its cache if it's fresh; compiles and caches it otherwise.
+			//! \param binary: Receives the SPBINARYGRAMMAR; empty if there's none.
+			void LoadBinary(const std::string& fileName, std::string& binary)
+			{
+				binary.clear();
+				std::string source;
+				if(!CGrammarCache::ReadFile(fileName, source))
+				{
+					return;
+				}
+				uint64 sourceHash = CGrammarCache::Hash(source);
+				std::string cacheFile = CGrammarCache::GetFileName(fileName, "cfg");
+				if(CGrammarCache::Load(cacheFile, sourceHash, binary) && IsBinaryGrammar(binary))
+				{
+					VCS_LOGF_INFO(logger, "CRecognizer_SAPI::LoadGrammar() - %s from cache", fileName.c_str());
+					return;
+				}
+				if(!Compile(source, binary) || !IsBinaryGrammar(binary))
+				{
+					binary.clear();
+					return;
+				}
+				if(!CGrammarCache::Store(cacheFile, sourceHash, binary))
+				{
+					VCS_LOGF_WARNING(logger, "CRecognizer_SAPI::LoadGrammar() - %s: can't write cache", fileName.c_str());
+				}
+				VCS_LOGF_INFO(logger, "CRecognizer_SAPI::LoadGrammar() - %s compiled", fileName.c_str());
+			}
+
+			//! \brief Logged whenever waiting wakes up empty-handed.
+			static const char8* AwaitingEventFormat(){ return "Awaiting for event...[%lx]"; }
+
+			//! \brief Waits for a recognition event.
+			//! \param bHypothesis: Receives true if it's a hypothesis.
+			//! \return Returns S_OK if ppResult was filled; failure code on timeout or error.
+			HRESULT BlockForResult(ISpRecoResult** ppResult, DWORD dwHowLong, bool& bHypothesis)
+			{
+				HRESULT hr = S_OK;
+				CSpEvent event;
+
+				while (SUCCEEDED(hr) && SUCCEEDED(hr = event.GetFrom(recoContext)) && hr == S_FALSE)
+				{
+					VCS_LOGF_DEBUG(logger, AwaitingEventFormat(), dwHowLong);
+					hr = recoContext->WaitForNotifyEvent(dwHowLong);
+					if((hr == S_FALSE) && dwHowLong != INFINITE)
+					{
+						return E_FAIL;
+					}
+				}
+
+				VCS_LOG_DEBUG(logger, "Event received");
+
+				bHypothesis = (event.eEventId == SPEI_HYPOTHESIS);
+
+				(*ppResult) = event.RecoResult();
+				if (*ppResult)
+				{
+					(*ppResult)->AddRef();
+				}
+				VCS_LOG_DEBUG(logger, "Event processed");
+
+				return hr;
+			}
+
+			//! \brief Fills alternates of result - the engine's n-best list, without result itself.
+			static void ReadAlternates(ISpRecoResult* recoResult, SRecoResult& result)
+			{
+				USES_CONVERSION;	//something COM-specific
+				result.alternates.clear();
+				ISpPhraseAlt* alternates[RECO_MAX_ALTERNATES + 1];	//the best one is result, usually
+				ULONG count = 0;
+				if(FAILED(recoResult->GetAlternates(0, SPPR_ALL_ELEMENTS, RECO_MAX_ALTERNATES + 1, alternates, &count)))
+				{
+					return;	//engines don't have to keep any
+				}
+				for(ULONG i = 0 ; i < count ; ++i)
+				{
+					SPPHRASE* pElements;
+					if(result.alternates.size() < RECO_MAX_ALTERNATES && SUCCEEDED(alternates[i]->GetPhrase(&pElements)))
+					{
+						SRecoAlternate alternate;
+						alternate.grammarId = (uint32)pElements->ullGrammarID;
+						alternate.ruleId = pElements->Rule.ulId;
+						alternate.value = (pElements->pProperties) ? pElements->pProperties->vValue.ulVal : 0;
+						alternate.confidence = pElements->Rule.SREngineConfidence;
+						::CoTaskMemFree(pElements);
+
+						CSpDynamicString dstrText;
+						if(SUCCEEDED(alternates[i]->GetText(SP_GETWHOLEPHRASE, SP_GETWHOLEPHRASE, TRUE, &dstrText, NULL)) && dstrText)
+						{
+							alternate.text = W2A(dstrText);
+						}
+						if(alternate.ruleId != result.ruleId || alternate.value != result.value)
+						{
+							result.alternates.push_back(alternate);
+						}
+					}
+					alternates[i]->Release();
+				}
+			}
+
+			//! \brief Waits for the next result.
+			//! \param bTakeHypotheses: Return hypotheses too; they're skipped otherwise.
+			//! \return Returns RS_Recognized or RS_Hypothesis if result was filled.
+			E_RecoStatus TakeResult(SRecoResult& result, uint32 timeout, bool bTakeHypotheses)
+			{
+				USES_CONVERSION;	//something COM-specific
+				CComPtr<ISpRecoResult> recoResult;
+				bool bHypothesis = true;
+				while(bHypothesis)
+				{
+					recoResult.Release();
+					if(FAILED(BlockForResult(&recoResult, (timeout == RECO_INFINITE) ? INFINITE : timeout, bHypothesis)) || !recoResult)
+					{
+						return (timeout == RECO_INFINITE) ? RS_Failed : RS_Timeout;
+					}
+					if(bTakeHypotheses)
+					{
+						break;
+					}
+				}
+				result.recognized = CLogClock::Now();
+
+				SPPHRASE* pElements;
+				if(FAILED(recoResult->GetPhrase(&pElements)))
+				{
+					return RS_Failed;
+				}
+				result.decoded = CLogClock::Now();
+				result.grammarId = (uint32)pElements->ullGrammarID;
+				result.ruleId = pElements->Rule.ulId;
+				result.value = (pElements->pProperties) ? pElements->pProperties->vValue.ulVal : 0;
+				result.confidence = pElements->Rule.SREngineConfidence;
+				::CoTaskMemFree(pElements);
+
+				CSpDynamicString dstrText;
+				result.text.clear();
+				if(SUCCEEDED(recoResult->GetText(SP_GETWHOLEPHRASE, SP_GETWHOLEPHRASE, TRUE, &dstrText, NULL)) && dstrText)
+				{
+					result.text = W2A(dstrText);
+				}
+				if(bHypothesis)
+				{
+					result.alternates.clear();	//they're for settled results
+				}
+				else
+				{
+					ReadAlternates(recoResult, result);
+				}
+
+				SPRECORESULTTIMES times;
+				result.speechStart = result.speechEnd = result.recognized;
+				if(SUCCEEDED(recoResult->GetResultTimes(&times)))
+				{
+					uint64 sinceStart = (uint64)(GetTickCount() - times.dwTickCount) * 1000000;	//wraps nicely
+					uint64 length = times.ullLength * 100;	//100ns units
+					if(sinceStart <= result.recognized)
+					{
+						result.speechStart = result.recognized - sinceStart;
+						result.speechEnd = result.speechStart + length;
+					}
+				}
+				return (bHypothesis) ? RS_Hypothesis : RS_Recognized;
+			}
+
+		public:
+			//! \brief C-tor.
+			//! \param _logger: Logger to report to.
+			CRecognizer_SAPI(CLogger& _logger):logger(_logger), bHypotheses(false){}
+
+			virtual bool Init()
+			{
+				HRESULT hRes = recoEngine.CoCreateInstance(CLSID_SpSharedRecognizer);
+				if(FAILED(hRes))
+				{
+					VCS_LOG_ERROR(logger, "CRecognizer_SAPI::Init() - Failed to initialize Recognition Engine");
+					return false;
+				}
+				VCS_LOG_SUCCESS(logger, "CRecognizer_SAPI::Init() - Recognition Engine initialized!");
+
+				hRes = recoEngine->CreateRecoContext(&recoContext);
+				if(FAILED(hRes))
+				{
+					VCS_LOG_ERROR(logger, "CRecognizer_SAPI::Init() - Failed to create Recognition Context");
+					return false;
+				}
+				recoContext->SetNotifyWin32Event();
+				SetHypotheses(false);
+				VCS_LOG_SUCCESS(logger, "CRecognizer_SAPI::Init() - Recognition Context initialized!");
+
+				logger.SetLimit(AwaitingEventFormat(), SLogLimit(1, WAIT_LOG_INTERVAL));
+				return true;
+			}
+
+			virtual bool DeInit()
+			{
+				grammars.clear();
+				if(recoContext)
+				{
+					recoContext->SetNotifySink(NULL);
+					recoContext = NULL;
+					VCS_LOG_SUCCESS(logger, "CRecognizer_SAPI::DeInit() - Recognition Context deinitialized!");
+				}
+				if(recoEngine)
+				{
+					recoEngine = NULL;
+					VCS_LOG_SUCCESS(logger, "CRecognizer_SAPI::DeInit() - Recognition Engine deinitialized!");
+				}
+				return true;
+			}
+
+			virtual uint32 LoadGrammar(uint32 grammarId, const std::string& fileName)
+			{
+				USES_CONVERSION;	//something COM-specific
+				CComPtr<ISpRecoGrammar> grammar;
+				HRESULT hRes = recoContext->CreateGrammar(grammarId, &grammar);
+				if(FAILED(hRes))
+				{
+					VCS_LOGF_ERROR(logger, "CRecognizer_SAPI::LoadGrammar() - Failed to create grammar for %s", fileName.c_str());
+					return RECO_INVALID_GRAMMAR;
+				}
+				std::string binary;
+				LoadBinary(fileName, binary);
+				hRes = (binary.empty()) ? E_FAIL : grammar->LoadCmdFromMemory((const SPBINARYGRAMMAR*)binary.data(), SPLO_STATIC);
+				if(FAILED(hRes))
+				{
+					hRes = grammar->LoadCmdFromFile(A2W(fileName.c_str()), SPLO_STATIC);
+				}
+				if(FAILED(hRes))
+				{
+					VCS_LOGF_ERROR(logger, "CRecognizer_SAPI::LoadGrammar() - Failed to load grammar from %s", fileName.c_str());
+					return RECO_INVALID_GRAMMAR;
+				}
+				grammar->SetRuleState( NULL, NULL, SPRS_INACTIVE );
+				grammars.push_back(grammar);
+				return (uint32)grammars.size() - 1;
+			}
+
+			virtual void SetGrammarState(uint32 grammar, bool bEnabled)
+			{
+				if(grammar < grammars.size())
+				{
+					grammars[grammar]->SetGrammarState(bEnabled ? SPGS_ENABLED : SPGS_DISABLED);
+				}
+			}
+
+			virtual void SetRuleState(uint32 grammar, uint32 ruleId, bool bActive)
+			{
+				if(grammar < grammars.size() && ruleId == RECO_ALL_RULES)
+				{
+					grammars[grammar]->SetRuleState(NULL, NULL, bActive ? SPRS_ACTIVE : SPRS_INACTIVE);
+				}
+				else if(grammar < grammars.size())
+				{
+					grammars[grammar]->SetRuleIdState(ruleId, bActive ? SPRS_ACTIVE : SPRS_INACTIVE);
+				}
+			}
+
+			virtual uint32 SetRuleStates(const SRuleState* states, uint32 count)
+			{
+				uint32 engineCalls = count;
+				bool bPaused = false;
+				if(count >= PAUSE_MIN_CHANGES)
+				{
+					bPaused = SUCCEEDED(recoContext->Pause(0));
+					engineCalls += (bPaused) ? 2 : 1;
+				}
+				for(uint32 i = 0 ; i < count ; ++i)
+				{
+					SetRuleState(states[i].grammar, states[i].ruleId, states[i].bActive);
+				}
+				if(bPaused)
+				{
+					recoContext->Resume(0);
+				}
+				return engineCalls;
+			}
+
+			virtual void SetHypotheses(bool bEnabled)
+			{
+				bHypotheses = bEnabled;
+				if(recoContext)
+				{
+					ULONGLONG interest = SPFEI(SPEI_RECOGNITION) | ((bEnabled) ? SPFEI(SPEI_HYPOTHESIS) : 0);
+					recoContext->SetInterest(interest, interest);
+				}
+			}
+
+			virtual E_RecoStatus WaitForResult(SRecoResult& result, uint32 timeout = RECO_INFINITE)
+			{
+				return TakeResult(result, timeout, false);
+			}
+
+			virtual waitable_t GetWaitable()
+			{
+				return (recoContext) ? recoContext->GetNotifyEventHandle() : INVALID_WAITABLE;
+			}
+
+			virtual E_RecoStatus PollResult(SRecoResult& result, uint32 timeLeft = RECO_INFINITE)
+			{
+				E_RecoStatus status = TakeResult(result, 0, bHypotheses);
+				if(status == RS_Recognized || status == RS_Hypothesis)
+				{
+					SetEvent(recoContext->GetNotifyEventHandle());	//more may be queued
+				}
+				return (status == RS_Timeout) ? RS_Pending : status;
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_RECOGNIZER_SAPI_H__
@@ -0,0 +1,237 @@
+#ifndef __TRC_VCS_RESCORER_H__
+#define __TRC_VCS_RESCORER_H__
+
+/*!
+\file Rescorer.h
+\brief Confidence thresholds, and n-best rescoring of doubtful results.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	The engine matches whatever it hears to some phrase of an active rule -
+	music, a cough - and a wrong command made the user say it again. So every
+	rule has a confidence threshold (grammar headers list them; the rest get
+	RESCORE_DEFAULT_THRESHOLD), and a result less confident than its rule's
+	threshold isn't taken as it is:
+		- up to RESCORE_MARGIN below it, it's doubtful: it and its alternates
+		  (the engine's n-best list) are rescored - a reading's score is its
+		  confidence, plus RESCORE_HISTORY_BONUS for every time it's among the
+		  last RESCORE_HISTORY commands (up to RESCORE_HISTORY_MAX_BONUS), as
+		  users repeat themselves; the best reading of an active rule scoring
+		  over its own rule's threshold wins;
+		- below that, only an alternate may still win the same way;
+		- otherwise the result is noise, and is dropped - nothing runs, and
+		  nobody's told to repeat.
+
+	Confidences go as percents here; SAPI's may be off the 0.0 - 1.0 range
+	a bit, so they're clamped. Replayed results are sure (100%) unless the
+	transcript says otherwise (Recognizer_Replay.h).
+
+	Dump() logs how many results were taken as they were, how many rescored,
+	and of those how many were recovered - the recovery rate - and rejected.
+	The counts are atomic, as Dump() may run on another thread (Ctrl+Break).
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "Atomic.h"
+#include "CommandTable.h"
+#include "Logger.h"
+#include "Recognizer.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			RESCORE_DEFAULT_THRESHOLD = 30,	//!< Confidence [%] results of rules without a threshold of their own need.
+			RESCORE_MARGIN = 25,	//!< How far [%] below its rule's threshold a reading is still doubtful, not noise.
+			RESCORE_HISTORY = 16,	//!< Recent commands remembered.
+			RESCORE_HISTORY_BONUS = 5,	//!< Score [%] a reading gains per time it's among recent commands...
+			RESCORE_HISTORY_MAX_BONUS = 20	//!< ...up to that.
+		};
+
+		//! \brief What CRescorer::Resolve() made of a result.
+		enum E_RescoreVerdict
+		{
+			RV_Accepted = 0,	//!< Confident enough; taken as it was.
+			RV_Recovered,	//!< Doubtful, but a reading of it was good enough; result holds that one now.
+			RV_Rejected	//!< Noise; drop it.
+		};
+
+		//! \brief Checks results against their rules' confidence thresholds, and rescores doubtful ones.
+		class CRescorer : private boost::noncopyable
+		{
+		protected:
+			uint8 thresholds[COMMAND_MAX_ID];	//!< Confidence threshold [%], by rule.
+			uint32 history[RESCORE_HISTORY];	//!< Recent commands, rule << 16 | value; 0 if slot's unused.
+			uint32 historyNext;	//!< Slot of history overwritten next.
+			atomic32 accepted;	//!< Results taken as they were.
+			atomic32 recovered;	//!< Doubtful results that got a reading good enough.
+			atomic32 rejected;	//!< Results dropped as noise.
+
+			//! \brief Returns confidence as percent, 0 - 100.
+			static uint32 Percent(float32 confidence)
+			{
+				if(confidence <= 0.0f)
+				{
+					return 0;
+				}
+				return (confidence >= 1.0f) ? 100 : (uint32)(confidence * 100.0f + 0.5f);
+			}
+
+			//! \brief Returns score [%] recent commands add to a reading.
+			uint32 GetBonus(uint32 rule, uint32 value) const
+			{
+				uint32 key = (rule << 16) | value;
+				uint32 bonus = 0;
+				for(uint32 i = 0 ; i < RESCORE_HISTORY ; ++i)
+				{
+					if(history[i] == key)
+					{
+						bonus += RESCORE_HISTORY_BONUS;
+					}
+				}
+				return (bonus > RESCORE_HISTORY_MAX_BONUS) ? (uint32)RESCORE_HISTORY_MAX_BONUS : bonus;
+			}
+
+			//! \brief Scores a reading; 0 if it can't win.
+			//! \param bDoubtful: Is it the result itself, so it only needs to be doubtful, not noise?
+			uint32 Score(uint32 rule, uint32 value, float32 confidence, bool bDoubtful, const std::vector<uint32>& activeRules) const
+			{
+				if(std::find(activeRules.begin(), activeRules.end(), rule) == activeRules.end())
+				{
+					return 0;
+				}
+				uint32 percent = Percent(confidence);
+				uint32 threshold = GetThreshold(rule);
+				if(bDoubtful && percent + RESCORE_MARGIN < threshold)
+				{
+					return 0;
+				}
+				uint32 score = percent + GetBonus(rule, value);
+				return (score >= threshold && score > 0) ? score : 0;
+			}
+
+			//! \brief Adds command to recent ones.
+			void Remember(const SRecoResult& result)
+			{
+				history[historyNext] = (result.ruleId << 16) | result.value;
+				historyNext = (historyNext + 1) % RESCORE_HISTORY;
+			}
+
+		public:
+			//! \brief Default c-tor.
+			CRescorer():historyNext(0), accepted(0), recovered(0), rejected(0)
+			{
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					thresholds[i] = RESCORE_DEFAULT_THRESHOLD;
+				}
+				for(uint32 i = 0 ; i < RESCORE_HISTORY ; ++i)
+				{
+					history[i] = 0;
+				}
+			}
+
+			//! \brief Sets confidence threshold of rule.
+			//! \param percent: Confidence [%], 0 - 100; 0 takes everything.
+			void SetThreshold(uint32 rule, uint32 percent)
+			{
+				if(rule < COMMAND_MAX_ID)
+				{
+					thresholds[rule] = (uint8)((percent > 100) ? 100 : percent);
+				}
+			}
+
+			//! \brief Returns confidence threshold [%] of rule.
+			uint32 GetThreshold(uint32 rule) const
+			{
+				return (rule < COMMAND_MAX_ID) ? thresholds[rule] : (uint32)RESCORE_DEFAULT_THRESHOLD;
+			}
+
+			//! \brief Checks if result is confident enough to be taken as it is.
+			bool IsConfident(const SRecoResult& result) const
+			{
+				return Percent(result.confidence) >= GetThreshold(result.ruleId);
+			}
+
+			//! \brief Decides what to make of a result.
+			//! \param result: Result; receives the reading that won, if it's RV_Recovered.
+			//! \param activeRules: Rules anyone waits for now; readings of others can't win.
+			E_RescoreVerdict Resolve(SRecoResult& result, const std::vector<uint32>& activeRules)
+			{
+				if(IsConfident(result))
+				{
+					AtomicIncrement(&accepted);
+					Remember(result);
+					return RV_Accepted;
+				}
+
+				sint32 best = -1;	//-1 - result itself
+				uint32 bestScore = Score(result.ruleId, result.value, result.confidence, true, activeRules);
+				for(size_t i = 0 ; i < result.alternates.size() ; ++i)
+				{
+					const SRecoAlternate& alternate = result.alternates[i];
+					uint32 score = Score(alternate.ruleId, alternate.value, alternate.confidence, false, activeRules);
+					if(score > bestScore)
+					{
+						best = (sint32)i;
+						bestScore = score;
+					}
+				}
+				if(bestScore == 0)
+				{
+					AtomicIncrement(&rejected);
+					return RV_Rejected;
+				}
+
+				if(best >= 0)
+				{
+					SRecoAlternate alternate = result.alternates[best];
+					result.grammarId = alternate.grammarId;
+					result.ruleId = alternate.ruleId;
+					result.value = alternate.value;
+					result.confidence = alternate.confidence;
+					result.text = alternate.text;
+				}
+				AtomicIncrement(&recovered);
+				Remember(result);
+				return RV_Recovered;
+			}
+
+			//! \brief Logs counts of results, and the recovery rate; safe to call from any thread.
+			void Dump(CLogger& logger) const
+			{
+				uint32 taken = (uint32)AtomicLoad(&accepted);
+				uint32 good = (uint32)AtomicLoad(&recovered);
+				uint32 noise = (uint32)AtomicLoad(&rejected);
+				uint32 rescored = good + noise;
+				VCS_LOGF_INFO(logger, DumpFormat(), taken + rescored, taken, rescored, good, noise,
+					(rescored > 0) ? good * 100 / rescored : 0);
+			}
+
+			//! \brief Format of Dump() lines; exempt it from log rate limits.
+			static const char8* DumpFormat(){ return "Rescore results=%u accepted=%u rescored=%u recovered=%u rejected=%u recovery=%u%%"; }
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_RESCORER_H__
@@ -0,0 +1,225 @@
+#ifndef __TRC_VCS_RULE_ACTIVATION_H__
+#define __TRC_VCS_RULE_ACTIVATION_H__
+
+/*!
+\file RuleActivation.h
+\brief Rule activation in batches - only what changed, once per event.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Every rule state change is a call into the shared recognizer's process,
+	and makes the engine resync its grammars. A menu transition used to turn
+	its old rules off and its new ones on one call at a time - even the rules
+	it keeps - and an event may go through a few transitions (a dialogue ends,
+	another one goes on waiting).
+
+	CRuleActivation keeps the rule set that should be active, and the one that
+	is. A transition is Begin() and a Want() per rule; Commit() diffs the two
+	sets and hands only the rules that changed to the recognizer, in one
+	SetRuleStates() call. VC System commits once, after an event is handled,
+	however many transitions it went through. A grammar none of whose rules
+	stay active, with two or more to turn off, is turned off whole - one
+	RECO_ALL_RULES change instead of one per rule.
+
+	Dump() shows what that saves, in calls into the engine. Done one by one,
+	as before, a transition made a call per rule it changed - its old menu's
+	rule off, its new one's on - so that's counted per transition, against
+	the set the transition before it left. Against that go the engine calls
+	SetRuleStates() reports it took - its changes, and Pause()/Resume() around
+	them where the backend does that - so "saved" may go below zero. Rule
+	changes are counted apart from the calls - fewer than one-by-one ones when
+	an event's transitions undo each other. Counts are atomic, as Dump() may
+	run on another thread (Ctrl+Break).
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "Atomic.h"
+#include "CommandTable.h"
+#include "Logger.h"
+#include "Recognizer.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//! \brief Active rule set of a recognizer, changed in batches.
+		class CRuleActivation : private boost::noncopyable
+		{
+		protected:
+			uint32 grammars[COMMAND_MAX_ID];	//!< Grammar handle of rule, as last wanted.
+			bool desired[COMMAND_MAX_ID];	//!< Should rule be active?
+			bool applied[COMMAND_MAX_ID];	//!< Is it?
+			bool previous[COMMAND_MAX_ID];	//!< Desired set the transition before the current one left.
+			bool bTransition;	//!< Is a transition in progress - Begin() not followed by Commit() yet?
+			std::vector<SRuleState> batch;	//!< Changes of Commit(); kept to reuse its memory.
+
+			atomic32 transitions;	//!< Begin()s.
+			atomic32 oneByOne;	//!< Calls transitions would have made one rule at a time.
+			atomic32 batches;	//!< SetRuleStates() calls made.
+			atomic32 engineCalls;	//!< Calls into the engine those took, as they reported.
+			atomic32 changes;	//!< Rule state changes those made.
+
+			//! \brief Checks if a grammar goes off whole on commit: none of its rules stay desired, and two or more are active.
+			bool IsGrammarOff(uint32 grammar) const
+			{
+				uint32 off = 0;
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					if(grammars[i] != grammar)
+					{
+						continue;
+					}
+					if(desired[i])
+					{
+						return false;
+					}
+					if(applied[i])
+					{
+						++off;
+					}
+				}
+				return off >= 2;
+			}
+
+			//! \brief Counts calls the transition in progress would have made one rule at a time.
+			void EndTransition()
+			{
+				if(!bTransition)
+				{
+					return;
+				}
+				bTransition = false;
+				sint32 changed = 0;
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					if(desired[i] != previous[i])
+					{
+						++changed;
+						previous[i] = desired[i];
+					}
+				}
+				AtomicAdd(&oneByOne, changed);
+			}
+
+		public:
+			//! \brief Default c-tor; all rules are inactive.
+			CRuleActivation():bTransition(false), transitions(0), oneByOne(0), batches(0), engineCalls(0), changes(0)
+			{
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					grammars[i] = RECO_INVALID_GRAMMAR;
+					desired[i] = false;
+					applied[i] = false;
+					previous[i] = false;
+				}
+			}
+
+			//! \brief Starts a new desired rule set; it's empty till rules are Want()ed.
+			void Begin()
+			{
+				EndTransition();
+				AtomicIncrement(&transitions);
+				bTransition = true;
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					desired[i] = false;
+				}
+			}
+
+			//! \brief Adds rule to the desired set.
+			//! \param grammar: Grammar handle of rule.
+			void Want(uint32 grammar, uint32 rule)
+			{
+				if(rule >= COMMAND_MAX_ID || rule == RECO_ALL_RULES || desired[rule])
+				{
+					return;
+				}
+				grammars[rule] = grammar;
+				desired[rule] = true;
+			}
+
+			//! \brief Checks if rule is in the desired set.
+			bool IsWanted(uint32 rule) const { return rule < COMMAND_MAX_ID && desired[rule]; }
+
+			//! \brief Makes the recognizer's active rules the desired set, in one call.
+			//! \return Returns count of rules changed.
+			uint32 Commit(IRecognizer& recognizer)
+			{
+				EndTransition();
+				batch.clear();
+				sint32 changed = 0;
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					if(applied[i] && !desired[i] && IsGrammarOff(grammars[i]))
+					{
+						SRuleState state;
+						state.grammar = grammars[i];
+						state.ruleId = RECO_ALL_RULES;
+						state.bActive = false;
+						batch.push_back(state);
+						for(uint32 j = i ; j < COMMAND_MAX_ID ; ++j)
+						{
+							if(grammars[j] == state.grammar && applied[j])
+							{
+								applied[j] = false;
+								++changed;
+							}
+						}
+					}
+				}
+				for(uint32 i = 0 ; i < COMMAND_MAX_ID ; ++i)
+				{
+					if(desired[i] != applied[i])
+					{
+						SRuleState state;
+						state.grammar = grammars[i];
+						state.ruleId = i;
+						state.bActive = desired[i];
+						batch.push_back(state);
+						applied[i] = desired[i];
+						++changed;
+					}
+				}
+				if(!batch.empty())
+				{
+					uint32 called = recognizer.SetRuleStates(&batch[0], (uint32)batch.size());
+					AtomicIncrement(&batches);
+					AtomicAdd(&engineCalls, (sint32)called);
+					AtomicAdd(&changes, changed);
+				}
+				return (uint32)changed;
+			}
+
+			//! \brief Logs counts of transitions, engine calls and rule changes; safe to call from any thread.
+			void Dump(CLogger& logger) const
+			{
+				uint32 wouldCall = (uint32)AtomicLoad(&oneByOne);
+				uint32 called = (uint32)AtomicLoad(&engineCalls);
+				VCS_LOGF_INFO(logger, DumpFormat(), (uint32)AtomicLoad(&transitions), wouldCall, (uint32)AtomicLoad(&batches), called,
+					(uint32)AtomicLoad(&changes), (sint32)(wouldCall - called));
+			}
+
+			//! \brief Format of Dump() lines; exempt it from log rate limits.
+			static const char8* DumpFormat(){ return "Rules transitions=%u one-by-one calls=%u batches=%u engine calls=%u rule changes=%u saved calls=%d"; }
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_RULE_ACTIVATION_H__
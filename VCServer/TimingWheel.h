@@ -0,0 +1,303 @@
+#ifndef __TRC_VCS_TIMING_WHEEL_H__
+#define __TRC_VCS_TIMING_WHEEL_H__
+
+/*!
+\file TimingWheel.h
+\brief Hierarchical timing wheel - O(1) timers.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Time goes in 1 ms ticks. Level 0 has a slot per tick for the next
+	TIMER_WHEEL_SLOTS ticks; every level up has slots TIMER_WHEEL_SLOTS
+	times wider, so TIMER_WHEEL_LEVELS levels cover all of uint32 [ms]. A timer
+	goes in the slot of its expiry tick on the lowest level it fits in; when
+	a level's slot comes up, its timers cascade into lower levels, and level 0
+	slots fire. So Schedule() and Cancel() are O(1): a slot is a doubly-linked
+	list of nodes kept in a pool, and handles carry a generation, so a handle
+	of a timer that already fired (and whose node got reused) cancels nothing.
+
+	Advance() walks ticks one by one, but jumps over stretches where level 0
+	is empty, so an idle wheel costs a step per TIMER_WHEEL_SLOTS ms at most.
+	GetWaitTime() may name an earlier tick than the next expiry (a cascade
+	point); the caller just wakes up, advances and asks again.
+
+	Handlers are called from Advance(), and may schedule and cancel timers;
+	timers due by the wheel's current tick fire on the next one.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			TIMER_WHEEL_BITS = 8,
+			TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_BITS,	//!< Slots per level.
+			TIMER_WHEEL_LEVELS = 4	//!< Levels; TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS ticks covers uint32.
+		};
+
+		//! \brief Timing wheel calling H::OnEvent(uint32 id) of a handler H when its timer expires.
+		template<typename H>
+		class CTimingWheel : private boost::noncopyable
+		{
+		protected:
+			enum
+			{
+				NIL = 0xFFFFFFFF,	//!< No node.
+				INDEX_BITS = 24,	//!< Bits of handle taken by node index + 1; the rest is generation.
+				FREE_LEVEL = 0xFF	//!< level of a node that's not scheduled.
+			};
+
+			//! \brief Timer.
+			struct SNode
+			{
+				uint64 due;	//!< Expiry tick.
+				H* handler;	//!< Who's told.
+				uint32 id;	//!< What handler is told.
+				uint32 prev;	//!< Previous node in slot, or in free list; NIL if none.
+				uint32 next;	//!< Next node in slot; NIL if none.
+				uint8 level;	//!< Level node is in; FREE_LEVEL if it's free.
+				uint8 slot;	//!< Slot node is in.
+				uint8 generation;	//!< Bumped whenever node is freed.
+			};
+
+			std::vector<SNode> nodes;	//!< Node pool.
+			uint32 freeNodes;	//!< First free node; NIL if none.
+			uint32 slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];	//!< First node of slot; NIL if slot's empty.
+			uint32 levelCounts[TIMER_WHEEL_LEVELS];	//!< Count of timers on level.
+			uint64 current;	//!< Last tick advanced to.
+
+			//! \brief Puts node in the slot for its due tick.
+			void Link(uint32 index)
+			{
+				SNode& node = nodes[index];
+				uint64 delta = node.due - current;
+				uint32 level = 0;
+				while(level + 1 < TIMER_WHEEL_LEVELS && delta >= ((uint64)1 << (TIMER_WHEEL_BITS * (level + 1))))
+				{
+					++level;
+				}
+				uint32 slot = (uint32)(node.due >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1);
+
+				node.level = (uint8)level;
+				node.slot = (uint8)slot;
+				node.prev = NIL;
+				node.next = slots[level][slot];
+				if(node.next != NIL)
+				{
+					nodes[node.next].prev = index;
+				}
+				slots[level][slot] = index;
+				++levelCounts[level];
+			}
+
+			//! \brief Takes node out of its slot.
+			void Unlink(uint32 index)
+			{
+				SNode& node = nodes[index];
+				if(node.prev != NIL)
+				{
+					nodes[node.prev].next = node.next;
+				}
+				else
+				{
+					slots[node.level][node.slot] = node.next;
+				}
+				if(node.next != NIL)
+				{
+					nodes[node.next].prev = node.prev;
+				}
+				--levelCounts[node.level];
+			}
+
+			//! \brief Returns node to the pool.
+			void Free(uint32 index)
+			{
+				SNode& node = nodes[index];
+				node.level = FREE_LEVEL;
+				node.handler = NULL;
+				++node.generation;
+				node.next = freeNodes;
+				freeNodes = index;
+			}
+
+			//! \brief Moves timers of a slot of level down, now that it came up.
+			void Cascade(uint32 level, uint32 slot)
+			{
+				uint32 index = slots[level][slot];
+				slots[level][slot] = NIL;
+				while(index != NIL)
+				{
+					uint32 next = nodes[index].next;
+					--levelCounts[level];
+					Link(index);
+					index = next;
+				}
+			}
+
+			//! \brief Moves to the next tick and fires its timers.
+			void Tick()
+			{
+				++current;
+				for(uint32 level = 1 ; level < TIMER_WHEEL_LEVELS ; ++level)
+				{
+					if((current & (((uint64)1 << (TIMER_WHEEL_BITS * level)) - 1)) != 0)
+					{
+						break;	//not a boundary of this level, nor of the ones above
+					}
+					Cascade(level, (uint32)(current >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+				}
+
+				uint32 slot = (uint32)current & (TIMER_WHEEL_SLOTS - 1);
+				while(slots[0][slot] != NIL)
+				{
+					uint32 index = slots[0][slot];
+					Unlink(index);
+					H* handler = nodes[index].handler;
+					uint32 id = nodes[index].id;
+					Free(index);
+					handler->OnEvent(id);	//may (un)schedule timers, even in this slot
+				}
+			}
+
+		public:
+			//! \brief C-tor.
+			//! \param now: Current tick.
+			CTimingWheel(uint64 now):freeNodes(NIL), current(now)
+			{
+				for(uint32 level = 0 ; level < TIMER_WHEEL_LEVELS ; ++level)
+				{
+					for(uint32 slot = 0 ; slot < TIMER_WHEEL_SLOTS ; ++slot)
+					{
+						slots[level][slot] = NIL;
+					}
+					levelCounts[level] = 0;
+				}
+			}
+
+			//! \brief Starts a one-shot timer.
+			//! \param due: Tick it fires at; one that's gone by fires on the next tick.
+			//! \param handler: Handler to call.
+			//! \param id: Passed to handler.
+			//! \return Returns handle of the timer; never 0.
+			uint32 Schedule(uint64 due, H* handler, uint32 id)
+			{
+				uint32 index = freeNodes;
+				if(index != NIL)
+				{
+					freeNodes = nodes[index].next;
+				}
+				else
+				{
+					index = (uint32)nodes.size();
+					SNode node;
+					node.generation = 0;
+					nodes.push_back(node);
+				}
+
+				SNode& node = nodes[index];
+				node.due = (due > current) ? due : current + 1;
+				if(node.due - current > 0xFFFFFFFF)
+				{
+					node.due = current + 0xFFFFFFFF;	//as far as the wheel reaches
+				}
+				node.handler = handler;
+				node.id = id;
+				Link(index);
+				return ((uint32)node.generation << INDEX_BITS) | (index + 1);
+			}
+
+			//! \brief Stops a timer, if it didn't fire yet.
+			//! \param timer: Handle from Schedule(); 0 is ignored.
+			void Cancel(uint32 timer)
+			{
+				uint32 index = (timer & ((1 << INDEX_BITS) - 1)) - 1;
+				if(timer == 0 || index >= nodes.size())
+				{
+					return;
+				}
+				if(nodes[index].level == FREE_LEVEL || nodes[index].generation != (uint8)(timer >> INDEX_BITS))
+				{
+					return;	//fired already
+				}
+				Unlink(index);
+				Free(index);
+			}
+
+			//! \brief Returns count of running timers.
+			uint32 GetCount() const
+			{
+				uint32 count = 0;
+				for(uint32 level = 0 ; level < TIMER_WHEEL_LEVELS ; ++level)
+				{
+					count += levelCounts[level];
+				}
+				return count;
+			}
+
+			//! \brief Returns ticks from now until Advance() may have something to do; -1 if there are no timers.
+			//! \param now: Current tick.
+			sint32 GetWaitTime(uint64 now) const
+			{
+				if(GetCount() == 0)
+				{
+					return -1;
+				}
+				uint64 wake = (current | (TIMER_WHEEL_SLOTS - 1)) + 1;	//next cascade point
+				if(levelCounts[0] > 0)
+				{
+					//level 0 slots past the cascade point may be earlier than what cascades then
+					for(uint64 tick = current + 1 ; tick < wake ; ++tick)
+					{
+						if(slots[0][(uint32)tick & (TIMER_WHEEL_SLOTS - 1)] != NIL)
+						{
+							wake = tick;
+							break;
+						}
+					}
+				}
+				return (wake <= now) ? 0 : (sint32)(wake - now);
+			}
+
+			//! \brief Fires all timers due by now.
+			//! \param now: Current tick.
+			void Advance(uint64 now)
+			{
+				while(current < now)
+				{
+					if(levelCounts[0] == 0)
+					{
+						//nothing to fire until the next cascade point
+						uint64 boundary = current | (TIMER_WHEEL_SLOTS - 1);
+						current = (boundary < now) ? boundary : now;
+						if(current == now)
+						{
+							break;
+						}
+					}
+					Tick();
+				}
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_TIMING_WHEEL_H__
@@ -1,346 +1,867 @@
-/*!
-\file VCSystem.h
-\brief Header class for main VC System class.
-
-
-Project:	TRC Voice Control System
-
-Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
-
-Created: 29.11.2006
-Last Revised:	29.11.2006
-
-Implementation File: VCSystem.cpp
-
-Notes:
-
-*/
-
-/*
-   
-*/
-
-#include "Defines.h"
-
-#include "VCSystem.h"
-
-#include "LogOutput_TextFile.h"
-
-//SAPI
-#include <sphelper.h>
-
-#include "grammar/grammar.h"
-
-namespace TRC
-{
-	namespace VCS
-	{
-		//=====================================================
-		//Function: CVCSystem::Init()
-		//Last Revised: 29.11.2006
-		//	Initialize Voice Controll System.
-		//=====================================================
-		void CVCSystem::Init()
-		{
-			bShouldQuit = false;
-			TTSVoice = NULL;
-			logger.Init();
-
-			textOutput = new CLogOutput_TextFile("vcs.log");
-
-			if(textOutput)
-			{
-				textOutput->Init();
-			}
-
-			logger.AddLogOutput(textOutput, LMTF_Default);
-
-			try
-			{
-				//-------- vvv SAPI INITIALIZATION
-				HRESULT hRes;
-
-				logger.Log(LMT_Info, "CVCSystem::Init() - Initializing SAPI");
-				if(FAILED(CoInitialize(NULL)))
-				{
-					throw std::runtime_error("Failed initializing COM");
-				}
-				logger.Log(LMT_Success, "CVCSystem::Init() - COM initialized!");
-
-				hRes = CoCreateInstance(CLSID_SpVoice, NULL, CLSCTX_ALL, IID_ISpVoice, (void**)&TTSVoice);
-				if(FAILED(hRes))
-				{
-					TTSVoice = NULL;
-					throw std::runtime_error("Failed to initialize TTS Voice");
-				}
-				logger.Log(LMT_Success, "CVCSystem::Init() - TTS Voice initialized!");
-
-				hRes = recoEngine.CoCreateInstance(CLSID_SpSharedRecognizer);
-				if(FAILED(hRes))
-				{
-					throw std::runtime_error("Failed to initialize Recognition Engine");
-				}
-				logger.Log(LMT_Success, "CVCSystem::Init() - Recognition Engine initialized!");
-
-				hRes = recoEngine->CreateRecoContext(&recoContext);
-				if(FAILED(hRes))
-				{
-					throw std::runtime_error("Failed to create Core Recognition Context");
-				}
-				logger.Log(LMT_Success, "CVCSystem::Init() - Core Recognition Context initialized!");
-
-				hRes = recoContext->CreateGrammar(CORE_GRAMMAR_ID, &recoGrammar);
-				if(FAILED(hRes))
-				{
-					throw std::runtime_error("Failed to create Core Grammar!");
-				}
-				recoContext->SetNotifyWin32Event();
-				//recoContext->SetInterest( SPFEI(SPEI_RECOGNITION) | SPFEI(SPEI_HYPOTHESIS), SPFEI(SPEI_RECOGNITION) | SPFEI(SPEI_HYPOTHESIS) );
-				recoContext->SetInterest( SPFEI(SPEI_RECOGNITION) , SPFEI(SPEI_RECOGNITION) );
-				logger.Log(LMT_Success, "CVCSystem::Init() - Core Grammar created!");
-
-				hRes = recoGrammar->LoadCmdFromFile(L"grammar/core.xml", SPLO_STATIC);
-				if(FAILED(hRes))
-				{
-					throw std::runtime_error("Failed to load Core Grammar from file!");
-				}
-				recoGrammar->SetRuleState( NULL, NULL, SPRS_ACTIVE );
-				logger.Log(LMT_Success, "CVCSystem::Init() - Core Grammar loaded!");
-
-				logger.Log(LMT_Success, "CVCSystem::Init() - SAPI initialized!");
-				//-------- ^^^ SAPI INITIALIZED
-				soundList.resize(S_MaxSounds);
-				soundList[S_Exit] = "exit.wav";
-				soundList[S_Error] = "error.wav";
-				soundList[S_Accepted] = "accepted.wav";
-				soundList[S_Executing] = "executing.wav";
-				soundList[S_NotYetImplemented] = "nyi.wav";
-				soundList[S_RestateCommand] = "restate.wav";
-				soundList[S_Activate] = "activate.wav";
-				soundList[S_Deny] = "deny.wav";
-
-				winAmpController.Init();
-			}
-			catch(std::exception& ex)
-			{
-				logger.Log(LMT_Fatal, boost::format("CVCSystem::Init() - Failed to initialize VC System - %s") % ex.what());
-				bShouldQuit = true;
-			}
-			return;
-		}
-
-		//=====================================================
-		//Function: CVCSystem::DeInit()
-		//Last Revised: 29.11.2006
-		//	Deinitialize Voice Controll System.
-		//=====================================================
-		void CVCSystem::DeInit()
-		{
-			try
-			{
-				winAmpController.DeInit();
-				if(recoGrammar)
-				{
-					recoGrammar = NULL;
-					logger.Log(LMT_Success, "CVCSystem::DeInit() - Core Grammar deinitialized!");
-				}
-				if(recoContext)
-				{
-					recoContext->SetNotifySink(NULL);
-					recoContext = NULL;
-					logger.Log(LMT_Success, "CVCSystem::DeInit() - Core Recognition Context deinitialized!");
-				}
-				if(recoEngine)
-				{
-					recoEngine = NULL;
-					logger.Log(LMT_Success, "CVCSystem::DeInit() - Recognition Engine deinitialized!");
-				}
-				if(TTSVoice)
-				{
-					TTSVoice->Release();
-					TTSVoice = NULL;
-					logger.Log(LMT_Success, "CVCSystem::DeInit() - TTS Voice deinitialized!");
-				}
-				CoUninitialize();
-				logger.Log(LMT_Success, "CVCSystem::DeInit() - COM deinitialized!");
-			}
-			catch(std::exception& ex)
-			{
-				logger.Log(LMT_Fatal, boost::format("CVCSystem::DeInit() Failed to deinitialize VC System - %s") % ex.what());
-			}
-
-			logger.RemoveLogOutput(textOutput);
-			if(textOutput)
-			{
-				textOutput->DeInit();
-				delete textOutput;
-			}
-			logger.DeInit();
-			return;
-		}
-
-		//=====================================================
-		//Function: CVCSystem::Run()
-		//Last Revised: 29.11.2006
-		//	Run VC System.
-		//=====================================================
-		void CVCSystem::Run(uint32 argc, char8** argv)
-		{
-			if(!bShouldQuit)
-			{
-				logger.Log(LMT_Info, "ojej!");
-				TTSVoice->Speak(L"Good day, Commander!", SPF_ASYNC, NULL);
-			}
-
-			CComPtr<ISpRecoResult> result;
-			SPPHRASE *pElements;
-
-			//recoGrammar->SetRuleIdState(MODE_Select, SPRS_ACTIVE );
-			//recoGrammar->SetRuleIdState(MODE_SelectModule, SPRS_INACTIVE );
-
-			while(!bShouldQuit)
-			{
-				USES_CONVERSION;	//something COM-specific
-				logger.Log(LMT_Debug, "Before recognition!");
-				while(SUCCEEDED(CVCSystem::BlockForResult(recoContext, &result)))
-				{
-					CSpDynamicString dstrText;
-					if (SUCCEEDED(result->GetText(SP_GETWHOLEPHRASE, SP_GETWHOLEPHRASE, TRUE, &dstrText, NULL)))
-					{
-						//TTSVoice->Speak(dstrText, SPF_ASYNC, NULL);
-					}
-					logger.Log(LMT_Debug, boost::format("Reco! - %s") % W2A(dstrText));
-					//if (_wcsicmp(dstrText, L"exit") == 0)
-					//{
-						//logger.Log(LMT_Debug, "egzit");
-						//bShouldQuit = true;
-						//break;
-					//}
-
-					if (SUCCEEDED(result->GetPhrase(&pElements)))
-					{        
-						switch ( pElements->Rule.ulId )
-						{
-							case MODE_Select:
-							{
-								switch( pElements->pProperties->vValue.ulVal )
-								{
-									case CMD_ActivateVC:
-									{
-										PlayNotifySound(S_Activate);
-
-										//disable mode select rule
-										recoGrammar->SetRuleIdState(MODE_SelectModule, SPRS_ACTIVE );
-										recoGrammar->SetRuleIdState(MODE_Select, SPRS_INACTIVE );
-										SelectModule();
-
-										//switch back to mode select input
-										recoGrammar->SetRuleIdState(MODE_Select, SPRS_ACTIVE );
-										recoGrammar->SetRuleIdState(MODE_SelectModule, SPRS_INACTIVE );
-										//PlayNotifySound(S_RestateCommand);
-
-										break;
-									}
-								}
-							}
-							break;
-						}
-						::CoTaskMemFree(pElements);
-					}
-					if(bShouldQuit)
-					{
-						break;
-					}
-
-				}
-				logger.Log(LMT_Debug, "After successful recognition!");
-			}
-			return;
-		}
-
-//----
-
-		HRESULT CVCSystem::BlockForResult(CComPtr<ISpRecoContext> pRecoCtxt, ISpRecoResult ** ppResult, DWORD dwHowLong)
-		{
-			HRESULT hr = S_OK;
-			CSpEvent event;
-
-			while (SUCCEEDED(hr) && SUCCEEDED(hr = event.GetFrom(pRecoCtxt)) && hr == S_FALSE)
-			//if(SUCCEEDED(hr) && SUCCEEDED(hr = event.GetFrom(pRecoCtxt)) && hr == S_FALSE)
-			{
-				logger.Log(LMT_Debug, boost::format("Awaiting for event...[%x]") % dwHowLong);
-				hr = pRecoCtxt->WaitForNotifyEvent(dwHowLong);
-				if((hr == S_FALSE) && dwHowLong != INFINITE)
-				{
-					return E_FAIL;
-				}
-			}
-
-			logger.Log(LMT_Debug, "Event received");
-
-			(*ppResult) = event.RecoResult();
-			if (*ppResult)
-			{
-				(*ppResult)->AddRef();
-			}
-			logger.Log(LMT_Debug, "Event processed");
-
-			return hr;
-		}
-
-		//---
-		void CVCSystem::SelectModule()
-		{
-			USES_CONVERSION;	//something COM-specific
-			logger.Log(LMT_Debug, "module select!");
-
-			CComPtr<ISpRecoResult> result;
-			SPPHRASE *pElements;
-
-			//if(SUCCEEDED(CVCSystem::BlockForResult(recoContext, &result, MODULE_COMMAND_LISTEN_TIME)))
-			if(SUCCEEDED(CVCSystem::BlockForResult(recoContext, &result, MODULE_COMMAND_LISTEN_TIME)))
-			//if(0)
-			{
-				CSpDynamicString dstrText;
-				//logger.Log(LMT_Debug, boost::format("Reco module! - %s") % W2A(dstrText));
-
-				if (SUCCEEDED(result->GetPhrase(&pElements)))
-				{        
-					switch ( pElements->Rule.ulId )
-					{
-						case MODE_SelectModule:
-						{
-							switch( pElements->pProperties->vValue.ulVal )
-							{
-								case CMD_MusicControl:
-								{
-									//TTSVoice->Speak(L"exit exit exit", SPF_ASYNC, NULL);
-									PlayNotifySound(S_Accepted);
-									//pass control to WinAMP Controller
-									recoGrammar->SetGrammarState(SPGS_DISABLED);
-									winAmpController.TakeControll();
-									recoGrammar->SetGrammarState(SPGS_ENABLED);
-									break;
-								}
-								case CMD_ShutdownVC:
-								{
-									bShouldQuit = true;
-									//TTSVoice->Speak(L"exit exit exit", SPF_ASYNC, NULL);
-									PlayNotifySound(S_Exit, false);
-									break;
-								}
-							}
-						}
-						break;
-					}
-					::CoTaskMemFree(pElements);
-				}
-			}
-			else
-			{
-				PlayNotifySound(S_RestateCommand);
-				//PlayNotifySound(S_Exit);
-			}
-		}
-	} //end of namespace VCS
+/*!
+\file VCSystem.h
+\brief Header class for main VC System class.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 29.11.2006
+Last Revised:	29.11.2006
+
+Implementation File: VCSystem.cpp
+
+Notes:
+
+*/
+
+/*
+   
+*/
+
+#include "Defines.h"
+
+#include "VCSystem.h"
+
+#include "LogOutput_TextFile.h"
+#include "LogOutput_BinaryFile.h"
+#include "LogOutput_FlightRecorder.h"
+
+#include "Recognizer_Replay.h"
+
+#ifdef WIN32
+	#include "Recognizer_SAPI.h"
+
+	//SAPI
+	#include <sphelper.h>
+#endif //WIN32
+
+#include <stdlib.h>
+#include <algorithm>
+
+#include "Commands.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//=====================================================
+		//Function: CVCSystem::Init()
+		//Last Revised: 18.10.2026
+		//	Initialize Voice Controll System.
+		//=====================================================
+		void CVCSystem::Init(uint32 argc, char8** argv)
+		{
+			uint64 initStart = CLogClock::Now();
+			bShouldQuit = false;
+		#ifdef WIN32
+			TTSVoice = NULL;
+		#endif //WIN32
+			logger.Init();
+
+		#if VCS_LOG_BINARY
+			logOutput = new CLogOutput_BinaryFile("vcs.blog", LOG_BUFFER_SIZE, LOG_FLUSH_INTERVAL);
+		#else //VCS_LOG_BINARY
+			logOutput = new CLogOutput_TextFile("vcs.log", LOG_BUFFER_SIZE, LOG_FLUSH_INTERVAL);
+		#endif //VCS_LOG_BINARY
+
+			flightRecorder = new CLogOutput_FlightRecorder("vcs.ring", "vcs-flight.log", LOG_RING_SIZE);
+
+			if(logOutput)
+			{
+				logOutput->Init();
+			}
+			if(flightRecorder)
+			{
+				flightRecorder->Init();
+			}
+
+			//debug detail goes only to the flight recorder; it's dumped on fatal errors;
+			//a stalled disk makes the main log sample records rather than stall recognition
+			logger.AddLogOutput(logOutput, LMTF_Default & ~LMT_Debug, LOP_Sample, LOG_SAMPLE_RATE);
+			logger.AddLogOutput(flightRecorder, LMTF_Default, LOP_DropOldest);
+			logger.StartAsync(LOG_QUEUE_SIZE);	//keep disk I/O off the recognition path
+
+			//don't let a message repeated in a loop flood the logs
+			logger.SetDefaultLimit(SLogLimit(LOG_LIMIT_BURST, LOG_LIMIT_INTERVAL, LOG_LIMIT_SAMPLE_RATE));
+			logger.SetLimit(CCommandLatency::DumpFormat(), SLogLimit());	//...but a latency dump is meant to be long
+			logger.SetLimit(CEarlyExecution::DumpFormat(), SLogLimit());
+			logger.SetLimit(CRescorer::DumpFormat(), SLogLimit());
+			logger.SetLimit(CRuleActivation::DumpFormat(), SLogLimit());
+
+			std::string transcript;
+			uint32 interval = 0;
+			bool bRealTime = true;
+			bool bFuzzy = false;
+			for(uint32 i = 1 ; i < argc ; ++i)
+			{
+				std::string arg(argv[i]);
+				if(arg == "-replay" && i + 1 < argc)
+				{
+					transcript = argv[++i];
+				}
+				else if(arg == "-interval" && i + 1 < argc)
+				{
+					interval = (uint32)atoi(argv[++i]);
+				}
+				else if(arg == "-fast")
+				{
+					bRealTime = false;
+				}
+				else if(arg == "-fuzzy")
+				{
+					bFuzzy = true;
+				}
+				else if(arg == "-quiet")
+				{
+					bQuiet = true;
+				}
+				else if(arg == "-early")
+				{
+					bEarly = true;
+				}
+			}
+
+			try
+			{
+				//-------- vvv SAPI INITIALIZATION
+			#ifdef WIN32
+				HRESULT hRes;
+
+				VCS_LOG_INFO(logger, "CVCSystem::Init() - Initializing SAPI");
+				if(FAILED(CoInitialize(NULL)))
+				{
+					throw std::runtime_error("Failed initializing COM");
+				}
+				VCS_LOG_SUCCESS(logger, "CVCSystem::Init() - COM initialized!");
+
+				hRes = CoCreateInstance(CLSID_SpVoice, NULL, CLSCTX_ALL, IID_ISpVoice, (void**)&TTSVoice);
+				if(FAILED(hRes))
+				{
+					TTSVoice = NULL;
+					throw std::runtime_error("Failed to initialize TTS Voice");
+				}
+				VCS_LOG_SUCCESS(logger, "CVCSystem::Init() - TTS Voice initialized!");
+			#endif //WIN32
+
+				if(recognizer == NULL)
+				{
+					if(!transcript.empty())
+					{
+						CRecognizer_Replay* replay = new CRecognizer_Replay(logger, transcript, interval, bRealTime);
+						replay->SetFuzzy(bFuzzy);
+						recognizer = replay;
+					}
+					else
+					{
+					#ifdef WIN32
+						recognizer = new CRecognizer_SAPI(logger);
+
+						//a live user - fit listen windows to them
+						const char8* user = getenv("USERNAME");
+						listenFile = std::string("listen-") + ((user && *user) ? user : "default") + ".txt";
+						bAdaptListen = true;
+						if(listenTimes.Load(listenFile))
+						{
+							VCS_LOGF_INFO(logger, "CVCSystem::Init() - Listen times loaded from %s", listenFile.c_str());
+							LogListenWindows();
+						}
+					#else //WIN32
+						throw std::runtime_error("No speech recognition here - use -replay <transcript>");
+					#endif //WIN32
+					}
+					bOwnRecognizer = true;
+				}
+				if(!recognizer->Init())
+				{
+					throw std::runtime_error("Failed to initialize Recognizer");
+				}
+				recognizer->SetHypotheses(bEarly);
+				VCS_LOG_SUCCESS(logger, "CVCSystem::Init() - Recognizer initialized!");
+
+				coreGrammar = LoadGrammar(CORE_GRAMMAR_ID, "grammar/core.xml");
+				if(coreGrammar == RECO_INVALID_GRAMMAR)
+				{
+					throw std::runtime_error("Failed to load Core Grammar from file!");
+				}
+				#define VCS_CORE_THRESHOLD(rule, percent) SetConfidenceThreshold(rule, percent);
+				VCS_CORE_CONFIDENCE(VCS_CORE_THRESHOLD)
+				#undef VCS_CORE_THRESHOLD
+				VCS_LOG_SUCCESS(logger, "CVCSystem::Init() - Core Grammar loaded!");
+
+				VCS_LOG_SUCCESS(logger, "CVCSystem::Init() - SAPI initialized!");
+				//-------- ^^^ SAPI INITIALIZED
+				soundList.resize(S_MaxSounds);
+				soundList[S_Exit] = "exit.wav";
+				soundList[S_Error] = "error.wav";
+				soundList[S_Accepted] = "accepted.wav";
+				soundList[S_Executing] = "executing.wav";
+				soundList[S_NotYetImplemented] = "nyi.wav";
+				soundList[S_RestateCommand] = "restate.wav";
+				soundList[S_Activate] = "activate.wav";
+				soundList[S_Deny] = "deny.wav";
+
+				winAmpController.Init();
+				VCS_LOGF_SUCCESS(logger, "CVCSystem::Init() - Started in %u ms", (uint32)((CLogClock::Now() - initStart) / 1000000));
+			}
+			catch(std::exception& ex)
+			{
+				VCS_LOGF_FATAL(logger, "CVCSystem::Init() - Failed to initialize VC System - %s", ex.what());
+				bShouldQuit = true;
+			}
+			return;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::LoadGrammar()
+		//Last Revised: 18.10.2026
+		//	Load a grammar into recognizer, timing it - compiled ones are cached (see GrammarCache.h).
+		//=====================================================
+		uint32 CVCSystem::LoadGrammar(uint32 grammarId, const std::string& fileName)
+		{
+			uint64 start = CLogClock::Now();
+			uint32 grammar = recognizer->LoadGrammar(grammarId, fileName);
+			std::string error;
+			if(grammar != RECO_INVALID_GRAMMAR && bEarly && !early.AddGrammar(fileName, error))
+			{
+				//early execution can't tell stable hypotheses without phrases of all rules
+				VCS_LOGF_ERROR(logger, "CVCSystem::LoadGrammar() - %s: %s; not acting on hypotheses", fileName.c_str(), error.c_str());
+				bEarly = false;
+				recognizer->SetHypotheses(false);
+			}
+			if(grammar != RECO_INVALID_GRAMMAR)
+			{
+				VCS_LOGF_INFO(logger, "CVCSystem::LoadGrammar() - %s loaded in %u us", fileName.c_str(), (uint32)((CLogClock::Now() - start) / 1000));
+			}
+			return grammar;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::DeInit()
+		//Last Revised: 18.10.2026
+		//	Deinitialize Voice Controll System.
+		//=====================================================
+		void CVCSystem::DeInit()
+		{
+			CompleteCommand();
+			DumpLatency();
+
+			if(!listenFile.empty())
+			{
+				LogListenWindows();
+				if(!listenTimes.Save(listenFile))
+				{
+					VCS_LOGF_ERROR(logger, "CVCSystem::DeInit() - Can't save listen times to %s", listenFile.c_str());
+				}
+			}
+
+			try
+			{
+				winAmpController.DeInit();
+				if(recognizer)
+				{
+					recognizer->DeInit();
+					if(bOwnRecognizer)
+					{
+						delete recognizer;
+						bOwnRecognizer = false;
+					}
+					recognizer = NULL;
+					coreGrammar = RECO_INVALID_GRAMMAR;
+					VCS_LOG_SUCCESS(logger, "CVCSystem::DeInit() - Recognizer deinitialized!");
+				}
+			#ifdef WIN32
+				if(TTSVoice)
+				{
+					TTSVoice->Release();
+					TTSVoice = NULL;
+					VCS_LOG_SUCCESS(logger, "CVCSystem::DeInit() - TTS Voice deinitialized!");
+				}
+				CoUninitialize();
+				VCS_LOG_SUCCESS(logger, "CVCSystem::DeInit() - COM deinitialized!");
+			#endif //WIN32
+			}
+			catch(std::exception& ex)
+			{
+				VCS_LOGF_FATAL(logger, "CVCSystem::DeInit() Failed to deinitialize VC System - %s", ex.what());
+			}
+
+			SLogOutputStats stats;
+			if(logger.GetOutputStats(logOutput, stats))
+			{
+				VCS_LOGF_INFO(logger, "CVCSystem::DeInit() - Main log: %u written, %u dropped, %u sampled out, %u delayed; %u rate limited",
+					stats.written, stats.dropped, stats.sampled, stats.delayed, logger.GetSuppressedCount());
+			}
+
+			logger.RemoveLogOutput(logOutput);
+			if(logOutput)
+			{
+				logOutput->DeInit();
+				delete logOutput;
+			}
+			logger.RemoveLogOutput(flightRecorder);
+			if(flightRecorder)
+			{
+				flightRecorder->DeInit();
+				delete flightRecorder;
+			}
+			logger.DeInit();
+			return;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::Run()
+		//Last Revised: 18.10.2026
+		//	Run VC System.
+		//=====================================================
+		void CVCSystem::Run(uint32 argc, char8** argv)
+		{
+			if(!bShouldQuit)
+			{
+				VCS_LOG_INFO(logger, "ojej!");
+			#ifdef WIN32
+				if(!bQuiet)
+				{
+					TTSVoice->Speak(L"Good day, Commander!", SPF_ASYNC, NULL);
+				}
+			#endif //WIN32
+			}
+
+			waitable_t recoWaitable = INVALID_WAITABLE;
+			if(!bShouldQuit)
+			{
+				recoWaitable = recognizer->GetWaitable();
+				if(!reactor.Watch(recoWaitable, this, EV_Recognizer))
+				{
+					VCS_LOG_FATAL(logger, "CVCSystem::Run() - Can't wait for recognizer");
+					bShouldQuit = true;
+				}
+			}
+
+			if(!bShouldQuit)
+			{
+				StartDialogue(coreDialogue);
+				CommitRules();
+			}
+			while(!bShouldQuit)
+			{
+				reactor.RunOnce();
+			}
+
+			StopDialogues();
+			CommitRules();
+			reactor.Unwatch(recoWaitable);
+			return;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::OnEvent()
+		//Last Revised: 18.10.2026
+		//	Handle reactor event.
+		//=====================================================
+		void CVCSystem::OnEvent(uint32 id)
+		{
+			SRecoResult result;
+			if(id == EV_Recognizer)
+			{
+				uint32 slot;
+				uint32 timeLeft = GetTimeLeft(slot);
+				E_RecoStatus status = PollForResult(result, timeLeft);
+				if(status == RS_Hypothesis)
+				{
+					OnHypothesis(result);
+				}
+				else if(status == RS_Recognized && !Rescore(result))
+				{
+					if(early.IsPending())
+					{
+						AbandonEarly();	//what ran early was noise too
+					}
+				}
+				else if(status == RS_Recognized && early.IsPending())
+				{
+					ReconcileEarly(result);
+				}
+				else if(status == RS_Recognized)
+				{
+					RouteResult(result);
+				}
+				else if(status == RS_Timeout && timeLeft != RECO_INFINITE)
+				{
+					ResumeDialogue(slot, RS_Timeout, result);	//recognizer keeps its own time
+				}
+			}
+			else if(id >= EV_DialogueTimeout && id < EV_DialogueTimeout + MAX_DIALOGUES)
+			{
+				uint32 slot = id - EV_DialogueTimeout;
+				dialogueTimers[slot] = 0;
+				ResumeDialogue(slot, RS_Timeout, result);
+			}
+			else if(id == EV_EarlyTimeout)
+			{
+				earlyTimer = 0;
+				if(early.IsPending())
+				{
+					AbandonEarly();
+				}
+			}
+			CommitRules();	//whatever transitions the event went through
+		}
+
+		//=====================================================
+		//Function: CVCSystem::StartDialogue()
+		//Last Revised: 18.10.2026
+		//	Start a dialogue.
+		//=====================================================
+		bool CVCSystem::StartDialogue(CDialogue& dialogue)
+		{
+			if(dialogue.IsRunning())
+			{
+				return false;
+			}
+			for(uint32 slot = 0 ; slot < MAX_DIALOGUES ; ++slot)
+			{
+				if(dialogues[slot] == NULL)
+				{
+					dialogues[slot] = &dialogue;
+					dialogue.Start();
+					ResumeDialogue(slot, RS_Pending, SRecoResult());
+					return true;
+				}
+			}
+			VCS_LOG_ERROR(logger, "CVCSystem::StartDialogue() - Too many dialogues");
+			return false;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::ResumeDialogue()
+		//Last Revised: 18.10.2026
+		//	Run dialogue till it waits again.
+		//=====================================================
+		void CVCSystem::ResumeDialogue(uint32 slot, E_RecoStatus status, const SRecoResult& result)
+		{
+			CDialogue* dialogue = dialogues[slot];
+			if(dialogue == NULL)
+			{
+				return;
+			}
+			reactor.CancelTimer(dialogueTimers[slot]);
+			dialogueTimers[slot] = 0;
+			RecordResponse(slot, status, result);
+			dialogueWindows[slot] = 0;
+
+			dialogue->Resume(status, result);
+
+			uint32 timeout = dialogue->GetTimeout();
+			if(timeout == LISTEN_ADAPTIVE)
+			{
+				timeout = dialogueWindows[slot] = GetListenWindow(dialogue->GetRule(0));
+			}
+			if(!dialogue->IsRunning())
+			{
+				dialogues[slot] = NULL;
+			}
+			else if(timeout != RECO_INFINITE)
+			{
+				dialogueTimers[slot] = reactor.SetTimer(timeout, this, EV_DialogueTimeout + slot);
+				dialogueDeadlines[slot] = CLogClock::Now() + (uint64)timeout * 1000000;
+			}
+			SyncRules();
+		}
+
+		//=====================================================
+		//Function: CVCSystem::RecordResponse()
+		//Last Revised: 18.10.2026
+		//	Record user's response time to a listen window.
+		//=====================================================
+		void CVCSystem::RecordResponse(uint32 slot, E_RecoStatus status, const SRecoResult& result)
+		{
+			uint32 window = dialogueWindows[slot];
+			if(!bAdaptListen || window == 0)
+			{
+				return;
+			}
+			uint32 rule = dialogues[slot]->GetRule(0);
+			if(status == RS_Timeout)
+			{
+				listenTimes.RecordTimeout(rule);	//says nothing of how long an answer takes - most often there was none
+			}
+			else if(status == RS_Recognized)
+			{
+				uint64 start = dialogueDeadlines[slot] - (uint64)window * 1000000;
+				uint64 answered = (result.speechStart != 0) ? result.speechStart : result.recognized;
+				listenTimes.Record(rule, (answered > start) ? (uint32)((answered - start) / 1000000) : 0);
+			}
+		}
+
+		//=====================================================
+		//Function: CVCSystem::LogListenWindows()
+		//Last Revised: 18.10.2026
+		//	Log listen windows fitted so far.
+		//=====================================================
+		void CVCSystem::LogListenWindows()
+		{
+			uint32 rules[32];
+			uint32 count = listenTimes.GetRules(rules, sizeof(rules) / sizeof(rules[0]));
+			for(uint32 i = 0 ; i < count ; ++i)
+			{
+				VCS_LOGF_INFO(logger, "CVCSystem::LogListenWindows() - [rule %u] %u ms, from %u responses and %u timeouts", rules[i], GetListenWindow(rules[i]), listenTimes.GetCount(rules[i]), listenTimes.GetTimeouts(rules[i]));
+			}
+		}
+
+		//=====================================================
+		//Function: CVCSystem::RouteResult()
+		//Last Revised: 18.10.2026
+		//	Resume dialogue waiting for a result's rule.
+		//=====================================================
+		void CVCSystem::RouteResult(const SRecoResult& result)
+		{
+			for(uint32 slot = 0 ; slot < MAX_DIALOGUES ; ++slot)
+			{
+				if(IsListening(slot) && dialogues[slot]->Awaits(result.ruleId))
+				{
+					ResumeDialogue(slot, RS_Recognized, result);
+					return;
+				}
+			}
+			VCS_LOGF_DEBUG(logger, "CVCSystem::RouteResult() - No dialogue waits for [rule %u]", result.ruleId);
+		}
+
+		//=====================================================
+		//Function: CVCSystem::IsAwaited()
+		//Last Revised: 18.10.2026
+		//	Check if a dialogue waits for a rule.
+		//=====================================================
+		bool CVCSystem::IsAwaited(uint32 rule) const
+		{
+			for(uint32 slot = 0 ; slot < MAX_DIALOGUES ; ++slot)
+			{
+				if(IsListening(slot) && dialogues[slot]->Awaits(rule))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::OnHypothesis()
+		//Last Revised: 18.10.2026
+		//	Run command of a stable hypothesis.
+		//=====================================================
+		void CVCSystem::OnHypothesis(const SRecoResult& result)
+		{
+			if(early.IsPending() || !IsAwaited(result.ruleId) || !winAmpController.CanUndo(result) || !rescorer.IsConfident(result) || !early.IsStable(result, activeRules))
+			{
+				return;	//one per utterance, only what can be taken back, and not on a guess
+			}
+			VCS_LOGF_DEBUG(logger, "CVCSystem::OnHypothesis() - running \"%s\" early", result.text.c_str());
+			early.Start(result);	//first, so SyncRules() keeps its rule active for the final result
+			earlyTimer = reactor.SetTimer(EARLY_CONFIRM_TIME, this, EV_EarlyTimeout);
+			RouteResult(result);
+		}
+
+		//=====================================================
+		//Function: CVCSystem::ReconcileEarly()
+		//Last Revised: 18.10.2026
+		//	Settle command that ran early with the final result.
+		//=====================================================
+		void CVCSystem::ReconcileEarly(const SRecoResult& result)
+		{
+			reactor.CancelTimer(earlyTimer);
+			earlyTimer = 0;
+			SRecoResult hypothesis = early.GetPending();
+			if(early.Confirm(result))
+			{
+				SyncRules();
+				return;	//done already
+			}
+
+			VCS_LOGF_INFO(logger, "CVCSystem::ReconcileEarly() - heard \"%s\", not \"%s\"; undoing it", result.text.c_str(), hypothesis.text.c_str());
+			winAmpController.Undo(hypothesis);
+			if(result.ruleId == hypothesis.ruleId)
+			{
+				Dispatch(result);	//the hypothesis took its dialogue past the wait for it
+			}
+			else
+			{
+				RouteResult(result);
+			}
+			SyncRules();
+		}
+
+		//=====================================================
+		//Function: CVCSystem::AbandonEarly()
+		//Last Revised: 18.10.2026
+		//	Undo command that ran early.
+		//=====================================================
+		void CVCSystem::AbandonEarly()
+		{
+			reactor.CancelTimer(earlyTimer);
+			earlyTimer = 0;
+			VCS_LOGF_INFO(logger, "CVCSystem::AbandonEarly() - \"%s\" wasn't confirmed, undoing it", early.GetPending().text.c_str());
+			winAmpController.Undo(early.GetPending());
+			early.Abandon();
+			SyncRules();
+		}
+
+		//=====================================================
+		//Function: CVCSystem::Rescore()
+		//Last Revised: 18.10.2026
+		//	Check result against confidence thresholds.
+		//=====================================================
+		bool CVCSystem::Rescore(SRecoResult& result)
+		{
+			std::string heard = result.text;
+			float32 confidence = result.confidence;
+			switch(rescorer.Resolve(result, activeRules))
+			{
+			case RV_Rejected:
+				VCS_LOGF_DEBUG(logger, "CVCSystem::Rescore() - \"%s\" (%.2f) is noise, dropped", heard.c_str(), confidence);
+				return false;
+			case RV_Recovered:
+				VCS_LOGF_INFO(logger, "CVCSystem::Rescore() - \"%s\" (%.2f) taken as \"%s\" (%.2f)", heard.c_str(), confidence, result.text.c_str(), result.confidence);
+				return true;
+			default:
+				return true;
+			}
+		}
+
+		//=====================================================
+		//Function: CVCSystem::StopDialogues()
+		//Last Revised: 18.10.2026
+		//	Stop all dialogues.
+		//=====================================================
+		void CVCSystem::StopDialogues()
+		{
+			for(uint32 slot = 0 ; slot < MAX_DIALOGUES ; ++slot)
+			{
+				if(dialogues[slot])
+				{
+					reactor.CancelTimer(dialogueTimers[slot]);
+					dialogueTimers[slot] = 0;
+					dialogues[slot]->Stop();
+					dialogues[slot] = NULL;
+				}
+			}
+			SyncRules();
+		}
+
+		//=====================================================
+		//Function: CVCSystem::GetTimeLeft()
+		//Last Revised: 18.10.2026
+		//	Return time left until the first dialogue times out.
+		//=====================================================
+		uint32 CVCSystem::GetTimeLeft(uint32& slot) const
+		{
+			uint32 timeLeft = RECO_INFINITE;
+			uint64 now = CLogClock::Now();
+			slot = 0;
+			for(uint32 i = 0 ; i < MAX_DIALOGUES ; ++i)
+			{
+				if(dialogueTimers[i] != 0)
+				{
+					uint32 left = (dialogueDeadlines[i] > now) ? (uint32)((dialogueDeadlines[i] - now) / 1000000) : 0;
+					if(timeLeft == RECO_INFINITE || left < timeLeft)
+					{
+						timeLeft = left;
+						slot = i;
+					}
+				}
+			}
+			return timeLeft;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::SyncRules()
+		//Last Revised: 18.10.2026
+		//	Work out the rules dialogues wait for.
+		//=====================================================
+		void CVCSystem::SyncRules()
+		{
+			std::vector<uint32> awaited;
+			if(early.IsPending())
+			{
+				awaited.push_back(early.GetPending().ruleId);	//its final result is still to come
+			}
+			for(uint32 slot = 0 ; slot < MAX_DIALOGUES ; ++slot)
+			{
+				for(uint32 i = 0 ; IsListening(slot) && i < CDialogue::MAX_AWAIT_RULES ; ++i)
+				{
+					uint32 rule = dialogues[slot]->GetRule(i);
+					if(rule != 0 && std::find(awaited.begin(), awaited.end(), rule) == awaited.end())
+					{
+						awaited.push_back(rule);
+					}
+				}
+			}
+
+			ruleActivation.Begin();
+			for(std::vector<uint32>::const_iterator itor = awaited.begin() ; itor != awaited.end() ; ++itor)
+			{
+				if(std::find(activeRules.begin(), activeRules.end(), *itor) == activeRules.end())
+				{
+					VCS_LOGF_DEBUG(logger, "CVCSystem::SyncRules() - listening for rule %u", *itor);
+				}
+				ruleActivation.Want(GetRuleGrammar(*itor), *itor);
+			}
+			activeRules.swap(awaited);
+		}
+
+		//=====================================================
+		//Function: CVCSystem::PollForResult()
+		//Last Revised: 18.10.2026
+		//	Take a recognized command, if there is one.
+		//=====================================================
+		E_RecoStatus CVCSystem::PollForResult(SRecoResult& result, uint32 timeLeft)
+		{
+			E_RecoStatus status = recognizer->PollResult(result, timeLeft);
+			switch(status)
+			{
+				case RS_Recognized:
+				case RS_Hypothesis:
+				{
+					trace.Clear();
+					trace.speechEnd = result.speechEnd;
+					trace.event = result.recognized;
+					trace.decoded = result.decoded;
+					VCS_LOGF_DEBUG(logger, "Reco! - %s%s [rule %u, value %u, confidence %.2f]", (status == RS_Hypothesis) ? "~" : "", result.text.c_str(), result.ruleId, result.value, result.confidence);
+					break;
+				}
+				case RS_Finished:
+				{
+					VCS_LOG_INFO(logger, "CVCSystem::PollForResult() - Recognizer is done, quitting");
+					bShouldQuit = true;
+					break;
+				}
+				default:
+					break;
+			}
+			return status;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::DumpLatency()
+		//Last Revised: 18.10.2026
+		//	Log latency percentiles of all commands.
+		//=====================================================
+		void CVCSystem::DumpLatency()
+		{
+			VCS_LOG_INFO(logger, "CVCSystem::DumpLatency() - Command latency by stage:");
+			commandLatency.Dump(logger);
+			winAmpController.GetLatency().Dump(logger);
+			if(bEarly)
+			{
+				VCS_LOG_INFO(logger, "CVCSystem::DumpLatency() - Commands run early, by rule/value:");
+				early.Dump(logger);
+			}
+			rescorer.Dump(logger);
+			ruleActivation.Dump(logger);
+		}
+
+		//=====================================================
+		//Function: CVCSystem::Dispatch()
+		//Last Revised: 18.10.2026
+		//	Run handler of a recognized command.
+		//=====================================================
+		bool CVCSystem::Dispatch(const SRecoResult& result)
+		{
+			commandTable_t::handler_t handler = commands.Find(result.ruleId, result.value);
+			if(handler == NULL)
+			{
+				return winAmpController.Dispatch(result);
+			}
+			DispatchCommand(commandLatency, result.value);
+			(this->*handler)(result);
+			CompleteCommand();
+			return true;
+		}
+
+		//=====================================================
+		//Function: CVCSystem::GetRuleGrammar()
+		//Last Revised: 18.10.2026
+		//	Return handle of grammar a rule is in.
+		//=====================================================
+		uint32 CVCSystem::GetRuleGrammar(uint32 rule) const
+		{
+			#define VCS_RULE_CASE(name, value) case name:
+			switch(rule)
+			{
+				VCS_CORE_RULES(VCS_RULE_CASE)
+					return coreGrammar;
+			}
+			#undef VCS_RULE_CASE
+			return winAmpController.GetGrammar();
+		}
+
+		//=====================================================
+		//Function: CVCSystem::CoreDialogue()
+		//Last Revised: 18.10.2026
+		//	"computer" ... - pick a module, or say a deep command.
+		//=====================================================
+		void CVCSystem::CoreDialogue(CDialogue& dialogue, E_RecoStatus status, const SRecoResult& result)
+		{
+			VCS_DIALOGUE_BEGIN(dialogue)
+				for(;;)
+				{
+					VCS_DIALOGUE_AWAIT(dialogue, NextUtterance(RECO_INFINITE, MODE_Select, MODE_MusicDirect));	//"computer music volume half" too
+					if(status != RS_Recognized)
+					{
+						continue;
+					}
+					Dispatch(result);
+					if(result.ruleId != MODE_Select)
+					{
+						continue;	//deep command's done
+					}
+
+					VCS_DIALOGUE_AWAIT(dialogue, NextUtterance(LISTEN_ADAPTIVE, MODE_SelectModule, MODE_MusicDirect));
+					if(status == RS_Recognized)
+					{
+						Dispatch(result);
+					}
+					else if(!bShouldQuit)
+					{
+						VCS_LOGF_DEBUG(logger, "CVCSystem::CoreDialogue() - dropping [rule %u]", MODE_SelectModule);
+						PlayNotifySound(S_RestateCommand);
+					}
+				}
+			VCS_DIALOGUE_END(dialogue)
+		}
+
+		//---- command handlers
+
+		void CVCSystem::OnActivate(const SRecoResult& result)
+		{
+			PlayNotifySound(S_Activate);
+		}
+
+		void CVCSystem::OnMusicControl(const SRecoResult& result)
+		{
+			//TTSVoice->Speak(L"exit exit exit", SPF_ASYNC, NULL);
+			PlayNotifySound(S_Accepted);
+			//pass control to WinAMP Controller; it goes on alongside the core dialogue, which is parked while control is preserved
+			if(!StartDialogue(winAmpController.GetDialogue()))
+			{
+				PlayNotifySound(S_Deny);	//already in control
+			}
+		}
+
+		void CVCSystem::OnShutdown(const SRecoResult& result)
+		{
+			bShouldQuit = true;
+			//TTSVoice->Speak(L"exit exit exit", SPF_ASYNC, NULL);
+			PlayNotifySound(S_Exit, false);
+		}
+
+		#define VCS_CORE_ROW(rule, value, handler) VCS_COMMAND_ROW(CVCSystem, rule, value, handler)
+		const CVCSystem::commandTable_t::SRow CVCSystem::commandRows[] =
+		{
+			VCS_CORE_COMMANDS(VCS_CORE_ROW)
+		};
+		#undef VCS_CORE_ROW
+
+		const uint32 CVCSystem::commandCount = sizeof(CVCSystem::commandRows) / sizeof(CVCSystem::commandRows[0]);
+	} //end of namespace VCS
 } //end of namespace TRC
\ No newline at end of file
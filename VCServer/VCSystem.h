@@ -1,106 +1,323 @@
-#ifndef __TRC_VCS_VOICE_CONTROL_SYSTEM_H__
-#define __TRC_VCS_VOICE_CONTROL_SYSTEM_H__
-
-/*!
-\file VCSystem.h
-\brief Header class for main VC System class.
-
-
-Project:	TRC Voice Control System
-
-Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
-
-Created: 29.11.2006
-Last Revised:	29.11.2006
-
-Implementation File: VCSystem.cpp
-
-Notes:
-
-*/
-
-/*
-   
-*/
-
-#include "Defines.h"
-#include "BaseTypes.h"
-#include "Singleton.h"
-
-#include "Logger.h"
-
-#include <sapi.h>
-#include <sphelper.h>
-
-#include "WinAMPController.h"
-
-namespace TRC
-{
-	namespace VCS
-	{
-		enum
-		{
-			CORE_GRAMMAR_ID = 1,	//!< ID of Core Grammar Object.
-			MODULE_COMMAND_LISTEN_TIME = 8000
-		};
-		class CVCSystem : public CSingleton<CVCSystem>
-		{
-		public:
-			CLogger logger;	//!< Logger system.
-			CComPtr<ISpRecoContext> recoContext;	//!< Core recognition context.
-			ISpVoice* TTSVoice;	//!< Default TTS Voice.
-		protected:
-			bool bShouldQuit;	//!< Should the application stop?
-
-			//---vv modules
-			CWinAMPController winAmpController;	//!< WinAMP Controll Module
-			//---^^ modules
-
-			//log outputs
-			ILogOutput* textOutput;	//!< Text output for logger.
-
-			//SAPI Objects
-			CComPtr<ISpRecognizer> recoEngine;	//!< Recognition engine.
-			CComPtr<ISpRecoGrammar> recoGrammar; //!< Core recognition grammar.
-
-		public:
-			enum E_Sounds
-			{
-				S_Exit = 0,
-				S_Error,
-				S_Accepted,
-				S_Executing,
-				S_NotYetImplemented,
-				S_RestateCommand,
-				S_Deny,
-				S_Activate,
-				S_MaxSounds	//!< Count of sounds
-			};
-
-			std::vector<std::string> soundList;
-
-			CVCSystem(){ TTSVoice = NULL; textOutput = NULL;}	//!< Constructor.
-			virtual ~CVCSystem(){}	//!< Destructor.
-			//! \brief Initialize VC System.
-			void Init();
-
-			//! \brief Deinitialize VC System.
-			void DeInit();
-
-			//! \brief Main function of VC System.
-			void Run(uint32 argc, char8** argv);
-
-			//utility functions
-			void PlayNotifySound(E_Sounds sound, bool bAsync = true)
-			{
-				PlaySoundA((std::string("sounds/") + soundList[sound]).c_str(), NULL, SND_FILENAME | ((bAsync)? SND_ASYNC : SND_SYNC));
-			}
-
-			void SelectModule();
-
-			HRESULT CVCSystem::BlockForResult(CComPtr<ISpRecoContext> pRecoCtxt, ISpRecoResult ** ppResult, DWORD dwHowLong = INFINITE);
-		};
-	};
-};
-
+#ifndef __TRC_VCS_VOICE_CONTROL_SYSTEM_H__
+#define __TRC_VCS_VOICE_CONTROL_SYSTEM_H__
+
+/*!
+\file VCSystem.h
+\brief Header class for main VC System class.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 29.11.2006
+Last Revised:	29.11.2006
+
+Implementation File: VCSystem.cpp
+
+Notes:
+
+*/
+
+/*
+   
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+#include "Singleton.h"
+
+#include "Logger.h"
+#include "Recognizer.h"
+#include "Reactor.h"
+#include "Dialogue.h"
+#include "Player.h"
+#include "CommandLatency.h"
+#include "CommandTable.h"
+#include "ListenTimes.h"
+#include "EarlyExecution.h"
+#include "Rescorer.h"
+#include "RuleActivation.h"
+
+#include <string>
+#include <vector>
+
+#ifdef WIN32
+	#include <sapi.h>
+	#include <sphelper.h>
+#endif //WIN32
+
+#include "WinAMPController.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		enum
+		{
+			CORE_GRAMMAR_ID = 1,	//!< ID of Core Grammar Object.
+			WINAMP_GRAMMAR_ID = 2,	//!< ID of WinAMP Grammar Object.
+			MODULE_COMMAND_LISTEN_TIME = 8000,	//!< Listen window [ms] until the user's own is known.
+			EARLY_CONFIRM_TIME = 3000,	//!< Max wait [ms] for the final result of a command that ran early; it's undone after that.
+			LOG_QUEUE_SIZE = 4096,	//!< Max count of log records awaiting the log writer thread.
+			LOG_BUFFER_SIZE = 64 * 1024,	//!< Size of log file write buffer.
+			LOG_FLUSH_INTERVAL = 1000,	//!< Max time [ms] a line waits in log file write buffer.
+			LOG_SAMPLE_RATE = 10,	//!< Main log keeps every n-th record when its queue fills up.
+			LOG_LIMIT_BURST = 50,	//!< Records of the same message logged per LOG_LIMIT_INTERVAL...
+			LOG_LIMIT_SAMPLE_RATE = 10,	//!< ...past that, only every n-th one is.
+			LOG_LIMIT_INTERVAL = 1000,	//!< Rate limit interval [ms].
+			LOG_RING_SIZE = 4 * 1024 * 1024	//!< Size of flight recorder ring file.
+		};
+		class CVCSystem : public CSingleton<CVCSystem>, public IEventHandler
+		{
+		public:
+			CLogger logger;	//!< Logger system.
+			IRecognizer* recognizer;	//!< Speech recognition backend.
+		#ifdef WIN32
+			ISpVoice* TTSVoice;	//!< Default TTS Voice.
+		#endif //WIN32
+		protected:
+			bool bShouldQuit;	//!< Should the application stop?
+			bool bQuiet;	//!< Don't play sounds nor speak.
+			bool bOwnRecognizer;	//!< Did Init() create the recognizer?
+
+			//---vv modules
+			CWinAMPController winAmpController;	//!< WinAMP Controll Module
+			//---^^ modules
+
+			//log outputs
+			ILogOutput* logOutput;	//!< Main output for logger.
+			ILogOutput* flightRecorder;	//!< Keeps recent debug detail for post-mortems.
+
+			uint32 coreGrammar;	//!< Handle of core recognition grammar.
+
+			//command path timing
+			CCommandLatency commandLatency;	//!< Latency of core commands.
+			SCommandTrace trace;	//!< Timestamps of command in progress.
+			CCommandLatency* traceLatency;	//!< Where the command in progress is recorded; NULL if none is.
+			uint32 traceCommand;	//!< ID of command in progress.
+
+			//core commands
+			typedef CCommandTable<CVCSystem> commandTable_t;
+			static const commandTable_t::SRow commandRows[];	//!< Core commands, from grammar/grammar.h.
+			static const uint32 commandCount;	//!< Count of commandRows.
+			commandTable_t commands;	//!< Handlers of core commands.
+
+			//dialogues
+			enum
+			{
+				MAX_DIALOGUES = 4	//!< Max count of dialogues going on at once.
+			};
+
+			CReactor reactor;	//!< Event loop of Run().
+			CMemberDialogue<CVCSystem> coreDialogue;	//!< "computer" ...
+			CDialogue* dialogues[MAX_DIALOGUES];	//!< Dialogues going on; NULL if slot's free.
+			uint32 dialogueTimers[MAX_DIALOGUES];	//!< Reactor timers timing dialogues' waits out; 0 if wait doesn't end.
+			uint64 dialogueDeadlines[MAX_DIALOGUES];	//!< When dialogueTimers fire [CLogClock::Now()].
+			uint32 dialogueWindows[MAX_DIALOGUES];	//!< Length [ms] of dialogues' LISTEN_ADAPTIVE waits; 0 if wait isn't one.
+			std::vector<uint32> activeRules;	//!< Rules dialogues wait for.
+			CRuleActivation ruleActivation;	//!< Rules active in recognizer; activeRules get there on CommitRules().
+
+			//listen windows
+			CListenTimes listenTimes;	//!< User's response times, by menu level.
+			std::string listenFile;	//!< Where listenTimes are kept between runs; empty if they aren't.
+			bool bAdaptListen;	//!< Fit LISTEN_ADAPTIVE waits to the user? Only a live user; a replay's timing says nothing about them.
+
+			//early execution
+			bool bEarly;	//!< Act on stable hypotheses?
+			CEarlyExecution early;	//!< Commands that ran on hypotheses.
+			uint32 earlyTimer;	//!< Reactor timer giving up on the final result of early command; 0 if none runs.
+
+			CRescorer rescorer;	//!< Confidence thresholds of rules; rescores doubtful results.
+
+			//! \brief Event sources of the reactor.
+			enum E_Events
+			{
+				EV_Recognizer = 0,	//!< Recognizer may have a result.
+				EV_EarlyTimeout,	//!< Final result of early command didn't come.
+				EV_DialogueTimeout	//!< Wait of dialogue in slot (id - EV_DialogueTimeout) timed out.
+			};
+
+			//! \brief Takes a result from recognizer, if it has one; quits VC System if recognizer has nothing more to say.
+			//! \param result: Receives the command.
+			//! \param timeLeft: Time left until the first dialogue times out [ms], or RECO_INFINITE.
+			//! \return Returns RS_Pending if there's no result yet.
+			E_RecoStatus PollForResult(SRecoResult& result, uint32 timeLeft);
+
+			//! \brief Runs dialogue in slot till it waits again; (re)starts its timeout and syncs rules.
+			void ResumeDialogue(uint32 slot, E_RecoStatus status, const SRecoResult& result);
+
+			//! \brief Records how long the user took to answer a LISTEN_ADAPTIVE wait of dialogue in slot, if it was one.
+			void RecordResponse(uint32 slot, E_RecoStatus status, const SRecoResult& result);
+
+			//! \brief Returns listen window [ms] of a LISTEN_ADAPTIVE wait for rule.
+			uint32 GetListenWindow(uint32 rule) const { return (bAdaptListen) ? listenTimes.GetWindow(rule) : (uint32)MODULE_COMMAND_LISTEN_TIME; }
+
+			//! \brief Logs listen windows fitted so far.
+			void LogListenWindows();
+
+			//! \brief Checks if dialogue in slot is listening; the core dialogue is parked while WinAMP control is preserved.
+			bool IsListening(uint32 slot) const { return dialogues[slot] && !(dialogues[slot] == &coreDialogue && winAmpController.IsPreserved()); }
+
+			//! \brief Resumes dialogue waiting for rule of result, if any.
+			void RouteResult(const SRecoResult& result);
+
+			//! \brief Checks if some dialogue waits for rule.
+			bool IsAwaited(uint32 rule) const;
+
+			//! \brief Runs command of a hypothesis right away, if it's stable and can be undone.
+			void OnHypothesis(const SRecoResult& result);
+
+			//! \brief Settles command that ran early with the final result; undoes it and runs result if they differ.
+			void ReconcileEarly(const SRecoResult& result);
+
+			//! \brief Undoes command that ran early; its final result won't come, or is noise.
+			void AbandonEarly();
+
+			//! \brief Checks result against confidence thresholds; may swap it for an alternate.
+			//! \return Returns false if result is noise, and has to be dropped.
+			bool Rescore(SRecoResult& result);
+
+			//! \brief Stops all dialogues.
+			void StopDialogues();
+
+			//! \brief Returns time left until the first dialogue times out [ms], or RECO_INFINITE.
+			//! \param slot: Receives slot of that dialogue.
+			uint32 GetTimeLeft(uint32& slot) const;
+
+			//! \brief Makes activeRules the rules dialogues wait for, and the rule of a command that ran early till it's settled.
+			//! Recognizer gets them on CommitRules().
+			void SyncRules();
+
+			//! \brief Activates activeRules in recognizer, and deactivates the rest; call once an event is handled.
+			void CommitRules(){ ruleActivation.Commit(*recognizer); }
+
+			//! \brief "computer" - listen for a module, or a deep command.
+			void CoreDialogue(CDialogue& dialogue, E_RecoStatus status, const SRecoResult& result);
+
+			//! \brief Runs handler of a recognized command, of whichever module.
+			//! \return Returns false if result isn't a command.
+			bool Dispatch(const SRecoResult& result);
+
+			//! \brief Returns handle of grammar a rule is in.
+			uint32 GetRuleGrammar(uint32 rule) const;
+
+			void OnActivate(const SRecoResult& result);	//!< "computer" - listen for a module.
+			void OnMusicControl(const SRecoResult& result);	//!< "music control" - start dialogue of WinAMP Controll Module.
+			void OnShutdown(const SRecoResult& result);	//!< "exit" - quit VC System.
+
+		public:
+			enum E_Sounds
+			{
+				S_Exit = 0,
+				S_Error,
+				S_Accepted,
+				S_Executing,
+				S_NotYetImplemented,
+				S_RestateCommand,
+				S_Deny,
+				S_Activate,
+				S_MaxSounds	//!< Count of sounds
+			};
+
+			std::vector<std::string> soundList;
+
+			CVCSystem():commandLatency("core"), commands(commandRows, commandCount), listenTimes(MODULE_COMMAND_LISTEN_TIME)
+			{
+			#ifdef WIN32
+				TTSVoice = NULL;
+			#endif //WIN32
+				recognizer = NULL; coreGrammar = RECO_INVALID_GRAMMAR; logOutput = NULL; flightRecorder = NULL;
+				traceLatency = NULL; traceCommand = 0;
+				for(uint32 i = 0 ; i < MAX_DIALOGUES ; ++i)
+				{
+					dialogues[i] = NULL; dialogueTimers[i] = 0; dialogueDeadlines[i] = 0; dialogueWindows[i] = 0;
+				}
+				coreDialogue.Bind(this, &CVCSystem::CoreDialogue);
+				bShouldQuit = false; bQuiet = false; bOwnRecognizer = false; bAdaptListen = false; bEarly = false; earlyTimer = 0;
+			}	//!< Constructor.
+			virtual ~CVCSystem(){}	//!< Destructor.
+			//! \brief Initialize VC System.
+			//! Command line: [-replay <transcript> [-interval <ms>] [-fast] [-fuzzy]] - recognize utterances
+			//! from transcript instead of the microphone (see Recognizer_Replay.h), -fuzzy - taking
+			//! ones that aren't phrases as the nearest phrase (see FuzzyMatcher.h); [-quiet] - no
+			//! sounds nor speech; [-early] - run commands on stable hypotheses (see EarlyExecution.h).
+			void Init(uint32 argc, char8** argv);
+
+			//! \brief Loads a grammar into recognizer; call from Init() of a module.
+			//! \return Returns grammar handle, or RECO_INVALID_GRAMMAR on failure.
+			uint32 LoadGrammar(uint32 grammarId, const std::string& fileName);
+
+			//! \brief Sets confidence threshold of rule; see Rescorer.h.
+			//! \param percent: Confidence [%] results of rule need to be taken as they are.
+			void SetConfidenceThreshold(uint32 rule, uint32 percent){ rescorer.SetThreshold(rule, percent); }
+
+			//! \brief Sets recognizer to use, instead of the one picked by Init(); call before Init().
+			//! Recognizer isn't deleted by VC System; Init() and DeInit() still init and deinit it.
+			void SetRecognizer(IRecognizer* _recognizer){ recognizer = _recognizer; }
+
+			//! \brief Sets player for WinAMP Controll Module, instead of WinAMP; call before Init().
+			void SetPlayer(IPlayer* player){ winAmpController.SetPlayer(player); }
+
+			//! \brief Deinitialize VC System.
+			void DeInit();
+
+			//! \brief Main function of VC System.
+			//! Starts the core dialogue and runs the reactor, which resumes dialogues with what they wait for.
+			void Run(uint32 argc, char8** argv);
+
+			//! \brief Handles reactor events; see E_Events.
+			virtual void OnEvent(uint32 id);
+
+			//! \brief Starts a dialogue; it runs till its first wait right away.
+			//! \return Returns false if it's running already, or there are too many dialogues.
+			bool StartDialogue(CDialogue& dialogue);
+
+			//utility functions
+			void PlayNotifySound(E_Sounds sound, bool bAsync = true)
+			{
+				if(traceLatency && trace.notified == 0)
+				{
+					trace.notified = CLogClock::Now();
+				}
+			#ifdef WIN32
+				if(!bQuiet)
+				{
+					PlaySoundA((std::string("sounds/") + soundList[sound]).c_str(), NULL, SND_FILENAME | ((bAsync)? SND_ASYNC : SND_SYNC));
+				}
+			#endif //WIN32
+			}
+
+			//! \brief Checks if VC System is about to quit.
+			bool ShouldQuit() const { return bShouldQuit; }
+
+			//! \brief Marks the last result as picked up by a module's switch.
+			//! \param latency: Module's latency stats, to record the command in.
+			//! \param command: Command ID (result value).
+			void DispatchCommand(CCommandLatency& latency, uint32 command)
+			{
+				trace.dispatched = CLogClock::Now();
+				traceLatency = &latency;
+				traceCommand = command;
+			}
+
+			//! \brief Marks dispatched command as done and records its latency.
+			//! Called right after player call returns; Dispatch() calls it for commands that didn't.
+			void CompleteCommand()
+			{
+				if(traceLatency)
+				{
+					trace.done = CLogClock::Now();
+					traceLatency->Record(traceCommand, trace);
+					traceLatency = NULL;
+				}
+			}
+
+			//! \brief Logs latency percentiles of all commands, and stats of early execution, rescoring and rule activation.
+			//! Safe to call from any thread (main.cpp does on Ctrl+Break): whatever it dumps has to be atomic, or guarded by a lock of its own.
+			void DumpLatency();
+		};
+	};
+};
+
 #endif //__TRC_VCS_VOICE_CONTROL_SYSTEM_H__
\ No newline at end of file
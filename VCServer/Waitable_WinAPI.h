@@ -0,0 +1,131 @@
+#ifndef __TRC_VCS_WAITABLE_WINAPI_H__
+#define __TRC_VCS_WAITABLE_WINAPI_H__
+
+/*!
+\file Waitable_WinAPI.h
+\brief Waiting on event handles, WinAPI flavour.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Don't include directly - Reactor.h picks the backend for the platform.
+	See Waitable_epoll.h for the other one; both provide the same waitable_t,
+	CWaitSet and CWaitableTimer interfaces.
+
+	A waitable is any handle WaitForMultipleObjects() takes - events, waitable
+	timers, processes; up to MAXIMUM_WAIT_OBJECTS of them per set. It returns
+	the first signaled handle only, so Wait() reports one at a time.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <vector>
+#include <windows.h>
+
+#include <boost/noncopyable.hpp>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		typedef HANDLE waitable_t;	//!< Something to wait on.
+		static const waitable_t INVALID_WAITABLE = NULL;	//!< No waitable.
+
+		//! \brief Set of waitables, waited on all at once.
+		class CWaitSet : private boost::noncopyable
+		{
+		protected:
+			std::vector<HANDLE> handles;	//!< Waitables...
+			std::vector<uint32> keys;	//!< ...and keys they're reported with.
+
+		public:
+			//! \brief Adds waitable to the set.
+			//! \param key: Reported by Wait() when waitable is signaled.
+			//! \return Returns false if set is full.
+			bool Add(waitable_t waitable, uint32 key)
+			{
+				if(handles.size() >= MAXIMUM_WAIT_OBJECTS)
+				{
+					return false;
+				}
+				handles.push_back(waitable);
+				keys.push_back(key);
+				return true;
+			}
+
+			//! \brief Removes waitable from the set.
+			void Remove(waitable_t waitable)
+			{
+				for(size_t i = 0 ; i < handles.size() ; ++i)
+				{
+					if(handles[i] == waitable)
+					{
+						handles.erase(handles.begin() + i);
+						keys.erase(keys.begin() + i);
+						return;
+					}
+				}
+			}
+
+			//! \brief Waits until some waitables are signaled.
+			//! \param timeout: Max time to wait [ms]; -1 waits forever.
+			//! \param ready: Receives keys of signaled waitables.
+			//! \param maxReady: Size of ready.
+			//! \return Returns count of keys in ready; 0 on timeout.
+			uint32 Wait(sint32 timeout, uint32* ready, uint32 maxReady)
+			{
+				DWORD dwHowLong = (timeout < 0) ? INFINITE : (DWORD)timeout;
+				if(handles.empty())
+				{
+					Sleep(dwHowLong);
+					return 0;
+				}
+				DWORD dwResult = WaitForMultipleObjects((DWORD)handles.size(), &handles[0], FALSE, dwHowLong);
+				if(dwResult >= WAIT_OBJECT_0 && dwResult < WAIT_OBJECT_0 + handles.size() && maxReady > 0)
+				{
+					ready[0] = keys[dwResult - WAIT_OBJECT_0];
+					return 1;
+				}
+				return 0;
+			}
+		};
+
+		//! \brief One-shot timer that can be waited on with other waitables.
+		class CWaitableTimer : private boost::noncopyable
+		{
+		protected:
+			HANDLE hTimer;	//!< Auto-reset waitable timer; a wait on it resets it.
+
+		public:
+			CWaitableTimer(){ hTimer = CreateWaitableTimer(NULL, FALSE, NULL); }	//!< Default c-tor.
+			~CWaitableTimer(){ if(hTimer){ CloseHandle(hTimer); } }	//!< D-tor.
+
+			//! \brief Returns waitable signaled when timer expires; INVALID_WAITABLE if timer couldn't be created.
+			waitable_t GetWaitable() const { return hTimer; }
+
+			//! \brief Makes timer expire after ms [ms]; 0 expires it right away.
+			void Arm(uint32 ms)
+			{
+				LARGE_INTEGER due;
+				due.QuadPart = (ms > 0) ? -(LONGLONG)ms * 10000 : -1;	//relative, 100 ns units
+				SetWaitableTimer(hTimer, &due, 0, NULL, NULL, FALSE);
+			}
+
+			//! \brief Resets expired timer, so it's not signaled anymore.
+			void Clear(){ WaitForSingleObject(hTimer, 0); }
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_WAITABLE_WINAPI_H__
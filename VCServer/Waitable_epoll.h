@@ -0,0 +1,138 @@
+#ifndef __TRC_VCS_WAITABLE_EPOLL_H__
+#define __TRC_VCS_WAITABLE_EPOLL_H__
+
+/*!
+\file Waitable_epoll.h
+\brief Waiting on file descriptors, Linux epoll flavour.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 18.10.2026
+Last Revised:	18.10.2026
+
+Implementation File: none.
+
+Notes:
+
+	Don't include directly - Reactor.h picks the backend for the platform.
+	See Waitable_WinAPI.h for the other one; both provide the same waitable_t,
+	CWaitSet and CWaitableTimer interfaces.
+
+	A waitable is any file descriptor epoll takes - eventfd, timerfd, pipe,
+	socket - and it's signaled while it's readable. Descriptors are watched
+	level-triggered, so one stays signaled until whoever owns it reads it.
+
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include <boost/noncopyable.hpp>
+
+namespace TRC
+{
+	namespace VCS
+	{
+		typedef int waitable_t;	//!< Something to wait on.
+		static const waitable_t INVALID_WAITABLE = -1;	//!< No waitable.
+
+		//! \brief Set of waitables, waited on all at once.
+		class CWaitSet : private boost::noncopyable
+		{
+		protected:
+			enum
+			{
+				MAX_EVENTS = 16	//!< Max count of waitables reported per Wait().
+			};
+
+			int epollFd;	//!< The epoll instance.
+
+		public:
+			CWaitSet(){ epollFd = epoll_create(MAX_EVENTS); }	//!< Default c-tor.
+			~CWaitSet(){ if(epollFd != -1){ close(epollFd); } }	//!< D-tor.
+
+			//! \brief Adds waitable to the set.
+			//! \param key: Reported by Wait() when waitable is signaled.
+			//! \return Returns false on failure.
+			bool Add(waitable_t waitable, uint32 key)
+			{
+				struct epoll_event event;
+				event.events = EPOLLIN;
+				event.data.u64 = 0;
+				event.data.u32 = key;
+				return (epoll_ctl(epollFd, EPOLL_CTL_ADD, waitable, &event) == 0);
+			}
+
+			//! \brief Removes waitable from the set.
+			void Remove(waitable_t waitable)
+			{
+				struct epoll_event event;	//ignored, but old kernels want it
+				epoll_ctl(epollFd, EPOLL_CTL_DEL, waitable, &event);
+			}
+
+			//! \brief Waits until some waitables are signaled.
+			//! \param timeout: Max time to wait [ms]; -1 waits forever.
+			//! \param ready: Receives keys of signaled waitables.
+			//! \param maxReady: Size of ready.
+			//! \return Returns count of keys in ready; 0 on timeout.
+			uint32 Wait(sint32 timeout, uint32* ready, uint32 maxReady)
+			{
+				struct epoll_event events[MAX_EVENTS];
+				int count = epoll_wait(epollFd, events, (maxReady < MAX_EVENTS) ? (int)maxReady : MAX_EVENTS, timeout);
+				if(count <= 0)
+				{
+					return 0;	//timeout, or EINTR - the caller just waits again
+				}
+				for(int i = 0 ; i < count ; ++i)
+				{
+					ready[i] = events[i].data.u32;
+				}
+				return (uint32)count;
+			}
+		};
+
+		//! \brief One-shot timer that can be waited on with other waitables.
+		class CWaitableTimer : private boost::noncopyable
+		{
+		protected:
+			int timerFd;	//!< Non-blocking timerfd.
+
+		public:
+			CWaitableTimer(){ timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK); }	//!< Default c-tor.
+			~CWaitableTimer(){ if(timerFd != -1){ close(timerFd); } }	//!< D-tor.
+
+			//! \brief Returns waitable signaled when timer expires; INVALID_WAITABLE if timer couldn't be created.
+			waitable_t GetWaitable() const { return timerFd; }
+
+			//! \brief Makes timer expire after ms [ms]; 0 expires it right away.
+			void Arm(uint32 ms)
+			{
+				struct itimerspec spec;
+				spec.it_interval.tv_sec = 0;
+				spec.it_interval.tv_nsec = 0;
+				spec.it_value.tv_sec = ms / 1000;
+				spec.it_value.tv_nsec = (ms % 1000) * 1000000 + ((ms == 0) ? 1 : 0);	//all zeros would disarm it
+				timerfd_settime(timerFd, 0, &spec, NULL);
+			}
+
+			//! \brief Resets expired timer, so it's not signaled anymore.
+			void Clear()
+			{
+				uint64 expirations;
+				while(read(timerFd, &expirations, sizeof(expirations)) == -1 && errno == EINTR)
+				{
+				}
+			}
+		};
+	} //end of namespace VCS
+} //end of namespace TRC
+
+#endif //__TRC_VCS_WAITABLE_EPOLL_H__
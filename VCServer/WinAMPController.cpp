@@ -1,445 +1,328 @@
-/*!
-\file VCSystem.h
-\brief Header class for main VC System class.
-
-
-Project:	TRC Voice Control System
-
-Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
-
-Created: 02.12.2006
-Last Revised:	02.12.2006
-
-Implementation File: VCSystem.cpp
-
-Notes:
-
-*/
-
-/*
-   
-*/
-
-#include "Defines.h"
-
-#include "VCSystem.h"
-#include "WinAMPController.h"
-
-#include "LogOutput_TextFile.h"
-
-//SAPI
-#include <sapi.h>
-#include <sphelper.h>
-
-#include "grammar/winamp.h"
-#include "wa_ipc.h"	//<-- from WinAMP SDK
-
-namespace TRC
-{
-	namespace VCS
-	{
-		const std::string winampClassName = "Winamp v1.x";	//i guess...
-		//=====================================================
-		//Function: CWinAMPController::Init()
-		//Last Revised: 02.12.2006
-		//	Initialize WinAMP Voice Controll Module
-		//=====================================================
-		void CWinAMPController::Init()
-		{
-			HRESULT hRes;
-			CVCSystem::GetSingleton().logger.Log(LMT_Info, "WinAMP Controller INIT!");
-			
-			hRes = CVCSystem::GetSingleton().recoContext->CreateGrammar(CORE_GRAMMAR_ID, &grammar);
-			if(FAILED(hRes))
-			{
-				throw std::runtime_error("Failed to create WinAMP Grammar!");
-			}
-			hRes = grammar->LoadCmdFromFile(L"grammar/winamp.xml", SPLO_STATIC);
-			if(FAILED(hRes))
-			{
-				throw std::runtime_error("Failed to load WinAMP Grammar from file!");
-			}
-			grammar->SetRuleState( NULL, NULL, SPRS_ACTIVE );
-			grammar->SetGrammarState(SPGS_DISABLED);
-			CVCSystem::GetSingleton().logger.Log(LMT_Success, "WinAMP Controller init done!!");
-
-			bPreserve = false;
-		}
-		
-		//=====================================================
-		//Function: CWinAMPController::Init()
-		//Last Revised: 02.12.2006
-		//	Deinitialize WinAMP Voice Controll Module
-		//=====================================================
-		void CWinAMPController::DeInit()
-		{
-			CVCSystem::GetSingleton().logger.Log(LMT_Info, "WinAMP Controller DE-INIT!");
-			if(grammar)
-			{
-				grammar = NULL;
-				CVCSystem::GetSingleton().logger.Log(LMT_Success, "CWinAMPController::DeInit() - WinAMP Grammar deinitialized!");
-			}
-		}
-
-		//=====================================================
-		//Function: CWinAMPController::TakeControll()
-		//Last Revised: 02.12.2006
-		//	Listen for WinAMP commands.
-		//=====================================================
-		void CWinAMPController::TakeControll()
-		{
-			CVCSystem::GetSingleton().logger.Log(LMT_Info, "WinAMP Controller TakeControll!");
-			//check for WinAMP presense
-			hWinAMP = FindWindow(winampClassName.c_str(), NULL);
-			if(hWinAMP == NULL)
-			{
-				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Error);
-				ShellExecute(NULL, "open", "startup.mp3", NULL, NULL, SW_SHOWNORMAL);
-				return;
-			}
-
-			//----
-			grammar->SetGrammarState(SPGS_ENABLED);
-			grammar->SetRuleIdState(MODE_Select, SPRS_ACTIVE);
-			
-			CComPtr<ISpRecoResult> result;
-			SPPHRASE *pElements;
-
-			do
-			{
-				if(SUCCEEDED(CVCSystem::GetSingleton().BlockForResult(CVCSystem::GetSingleton().recoContext, &result, MODULE_COMMAND_LISTEN_TIME)))
-				{
-					CSpDynamicString dstrText;
-					if (SUCCEEDED(result->GetPhrase(&pElements)))
-					{        
-
-						switch ( pElements->Rule.ulId )
-						{
-							case MODE_Select:
-							{
-								switch( pElements->pProperties->vValue.ulVal )
-								{
-									case CMD_Preserve:
-									{
-										//TTSVoice->Speak(L"exit exit exit", SPF_ASYNC, NULL);
-										if(bPreserve == false)
-										{
-											bPreserve=true;
-											CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-										}
-										else
-										{
-											CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Deny);
-										}
-										continue;
-									}
-									case CMD_Release:
-									{
-										if(bPreserve)
-										{
-											bPreserve = false;
-											CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-										}
-										else
-										{
-											CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Deny);
-										}
-										continue;
-									}
-									case CMD_TrackInfo:
-									{
-										CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_NotYetImplemented);
-										continue;
-									}
-									case MODE_Volume:
-									{
-										CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Accepted);
-										VolumeMenu();
-										continue;
-									}
-									case MODE_Playback:
-									{
-										CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Accepted);
-										PlaybackMenu();
-										continue;
-									}
-									case MODE_Playlist:
-									{
-										CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Accepted);
-										PlaylistMenu();
-										continue;
-									}
-								}
-							}
-							break;
-						}
-						::CoTaskMemFree(pElements);
-					}
-				}
-				else
-				{
-					if(!bPreserve)
-					{
-						CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_RestateCommand);
-					}
-					//PlayNotifySound(S_Exit);
-				}
-				CVCSystem::GetSingleton().logger.Log(LMT_Debug, "perserve!");
-			}
-			while(bPreserve);
-			grammar->SetGrammarState(SPGS_DISABLED);
-		}
-
-		//=====================================================
-		//Function: CWinAMPController::VolumeMenu()
-		//Last Revised: 02.12.2006
-		//	Listen for WinAMP commands.
-		//=====================================================
-		void CWinAMPController::VolumeMenu()
-		{
-			grammar->SetRuleIdState(MODE_Select, SPRS_INACTIVE);
-			grammar->SetRuleIdState(MODE_Volume, SPRS_ACTIVE);
-
-			CComPtr<ISpRecoResult> result;
-			SPPHRASE *pElements;
-
-			if(SUCCEEDED(CVCSystem::GetSingleton().BlockForResult(CVCSystem::GetSingleton().recoContext, &result, MODULE_COMMAND_LISTEN_TIME)))
-			{
-				CSpDynamicString dstrText;
-				if (SUCCEEDED(result->GetPhrase(&pElements)))
-				{        
-
-					switch ( pElements->Rule.ulId )
-					{
-						case MODE_Volume:
-						{
-							switch( pElements->pProperties->vValue.ulVal )
-							{
-								case CMD_Mute:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_WA_IPC, 0, IPC_SETVOLUME);
-									break;
-								}
-								case CMD_Full:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_WA_IPC, 255, IPC_SETVOLUME);
-									break;
-								}
-								case CMD_Half:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_WA_IPC, 128, IPC_SETVOLUME);
-									break;
-								}
-								case CMD_OneQuater:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_WA_IPC, 255/3, IPC_SETVOLUME);
-									break;
-								}
-								case CMD_ThreeQuater:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_WA_IPC, 510/3, IPC_SETVOLUME);
-									break;
-								}
-								case CMD_Louder:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									for(uint32 i = 0 ; i < 10 ; ++i)
-									{
-										SendMessage(hWinAMP, WM_COMMAND, WINAMP_VOLUMEUP, 0);
-									}
-									break;
-								}
-								case CMD_Quieter:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									
-									for(uint32 i = 0 ; i < 10 ; ++i)
-									{
-										SendMessage(hWinAMP, WM_COMMAND, WINAMP_VOLUMEDOWN, 0);
-									}
-									break;
-								}
-							}
-						}
-						break;
-					}
-					::CoTaskMemFree(pElements);
-				}
-			}
-			else
-			{
-				CVCSystem::GetSingleton().logger.Log(LMT_Debug, "VC: dropping");
-				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_RestateCommand);
-				//PlayNotifySound(S_Exit);
-			}
-
-			grammar->SetRuleIdState(MODE_Volume, SPRS_INACTIVE);
-			grammar->SetRuleIdState(MODE_Select, SPRS_ACTIVE);
-
-		}
-
-		//=====================================================
-		//Function: CWinAMPController::PlaybackMenu()
-		//Last Revised: 02.12.2006
-		//	Listen for WinAMP commands.
-		//=====================================================
-		void CWinAMPController::PlaybackMenu()
-		{
-			grammar->SetRuleIdState(MODE_Select, SPRS_INACTIVE);
-			grammar->SetRuleIdState(MODE_Playback, SPRS_ACTIVE);
-
-			CComPtr<ISpRecoResult> result;
-			SPPHRASE *pElements;
-
-			if(SUCCEEDED(CVCSystem::GetSingleton().BlockForResult(CVCSystem::GetSingleton().recoContext, &result, MODULE_COMMAND_LISTEN_TIME)))
-			{
-				CSpDynamicString dstrText;
-				if (SUCCEEDED(result->GetPhrase(&pElements)))
-				{        
-
-					switch ( pElements->Rule.ulId )
-					{
-						case MODE_Playback:
-						{
-							switch( pElements->pProperties->vValue.ulVal )
-							{
-								case CMD_Stop:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_COMMAND, WINAMP_BUTTON4, 0);
-									break;
-								}
-								case CMD_Pause:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_COMMAND, WINAMP_BUTTON3, 0);
-									break;
-								}
-								case CMD_Resume:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_COMMAND, WINAMP_BUTTON2, 0);
-									break;
-								}
-								case CMD_NextSong:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_COMMAND, WINAMP_BUTTON5, 0);
-									break;
-								}
-								case CMD_PreviousSong:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									SendMessage(hWinAMP, WM_COMMAND, WINAMP_BUTTON1, 0);
-									break;
-								}
-								case CMD_Shuffle:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									uint32 res = SendMessage(hWinAMP, WM_WA_IPC, 1, IPC_GET_SHUFFLE);
-									SendMessage(hWinAMP, WM_WA_IPC, (res==0)?1:0, IPC_SET_SHUFFLE);
-									break;
-								}
-								case CMD_Repeat:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									uint32 res = SendMessage(hWinAMP, WM_WA_IPC, 1, IPC_GET_REPEAT);
-									SendMessage(hWinAMP, WM_WA_IPC, (res==0)?1:0, IPC_SET_REPEAT);
-									break;
-								}
-							}
-						}
-						break;
-					}
-					::CoTaskMemFree(pElements);
-				}
-			}
-			else
-			{
-				CVCSystem::GetSingleton().logger.Log(LMT_Debug, "PC: dropping");
-				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_RestateCommand);
-
-				//PlayNotifySound(S_Exit);
-			}
-
-			grammar->SetRuleIdState(MODE_Playback, SPRS_INACTIVE);
-			grammar->SetRuleIdState(MODE_Select, SPRS_ACTIVE);
-
-		}
-
-		
-		//=====================================================
-		//Function: CWinAMPController::PlaylistMenu()
-		//Last Revised: 02.12.2006
-		//	Listen for WinAMP commands.
-		//=====================================================
-		void CWinAMPController::PlaylistMenu()
-		{
-			grammar->SetRuleIdState(MODE_Select, SPRS_INACTIVE);
-			grammar->SetRuleIdState(MODE_Playlist, SPRS_ACTIVE);
-
-			CComPtr<ISpRecoResult> result;
-			SPPHRASE *pElements;
-
-			if(SUCCEEDED(CVCSystem::GetSingleton().BlockForResult(CVCSystem::GetSingleton().recoContext, &result, MODULE_COMMAND_LISTEN_TIME)))
-			{
-				CSpDynamicString dstrText;
-				if (SUCCEEDED(result->GetPhrase(&pElements)))
-				{        
-
-					switch ( pElements->Rule.ulId )
-					{
-						case MODE_Playlist:
-						{
-							switch( pElements->pProperties->vValue.ulVal )
-							{
-								case PLAYLIST_Alpha:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									ShellExecute(NULL, "open", "playlist/alpha.m3u", NULL, NULL, SW_SHOWNORMAL);
-									break;
-								}
-								case PLAYLIST_Beta:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									ShellExecute(NULL, "open", "playlist/beta.m3u", NULL, NULL, SW_SHOWNORMAL);
-									break;
-								}
-								case PLAYLIST_Gamma:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									ShellExecute(NULL, "open", "playlist/gamma.m3u", NULL, NULL, SW_SHOWNORMAL);
-									break;
-								}
-								case PLAYLIST_Delta:
-								{
-									CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
-									ShellExecute(NULL, "open", "playlist/delta.m3u", NULL, NULL, SW_SHOWNORMAL);
-									break;
-								}
-							}
-						}
-						break;
-					}
-					::CoTaskMemFree(pElements);
-				}
-			}
-			else
-			{
-				CVCSystem::GetSingleton().logger.Log(LMT_Debug, "PL: dropping");
-				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_RestateCommand);
-
-				//PlayNotifySound(S_Exit);
-			}
-
-			grammar->SetRuleIdState(MODE_Playlist, SPRS_INACTIVE);
-			grammar->SetRuleIdState(MODE_Select, SPRS_ACTIVE);
-
-		}
-	} //end of namespace VCS
-} //end of namespace TRC
+/*!
+\file VCSystem.h
+\brief Header class for main VC System class.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 02.12.2006
+Last Revised:	02.12.2006
+
+Implementation File: VCSystem.cpp
+
+Notes:
+
+*/
+
+/*
+   
+*/
+
+#include "Defines.h"
+
+#include "VCSystem.h"
+#include "WinAMPController.h"
+
+#include "LogOutput_TextFile.h"
+
+#ifdef WIN32
+	#include "Player_WinAMP.h"
+#endif //WIN32
+
+#include "Commands.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		//=====================================================
+		//Function: CWinAMPController::Init()
+		//Last Revised: 02.12.2006
+		//	Initialize WinAMP Voice Controll Module
+		//=====================================================
+		void CWinAMPController::Init()
+		{
+			VCS_LOG_INFO(CVCSystem::GetSingleton().logger, "WinAMP Controller INIT!");
+
+			if(player == NULL)
+			{
+			#ifdef WIN32
+				player = new CPlayer_WinAMP;
+				bOwnPlayer = true;
+			#else //WIN32
+				throw std::runtime_error("No player to control!");
+			#endif //WIN32
+			}
+			
+			grammar = CVCSystem::GetSingleton().LoadGrammar(WINAMP_GRAMMAR_ID, "grammar/winamp.xml");
+			if(grammar == RECO_INVALID_GRAMMAR)
+			{
+				throw std::runtime_error("Failed to load WinAMP Grammar from file!");
+			}
+			#define VCS_WINAMP_THRESHOLD(rule, percent) CVCSystem::GetSingleton().SetConfidenceThreshold(rule, percent);
+			VCS_WINAMP_CONFIDENCE(VCS_WINAMP_THRESHOLD)
+			#undef VCS_WINAMP_THRESHOLD
+			VCS_LOG_SUCCESS(CVCSystem::GetSingleton().logger, "WinAMP Controller init done!!");
+
+			bPreserve = false;
+		}
+		
+		//=====================================================
+		//Function: CWinAMPController::Init()
+		//Last Revised: 02.12.2006
+		//	Deinitialize WinAMP Voice Controll Module
+		//=====================================================
+		void CWinAMPController::DeInit()
+		{
+			VCS_LOG_INFO(CVCSystem::GetSingleton().logger, "WinAMP Controller DE-INIT!");
+			if(grammar != RECO_INVALID_GRAMMAR)
+			{
+				grammar = RECO_INVALID_GRAMMAR;	//recognizer releases it
+				VCS_LOG_SUCCESS(CVCSystem::GetSingleton().logger, "CWinAMPController::DeInit() - WinAMP Grammar deinitialized!");
+			}
+			if(bOwnPlayer)
+			{
+				delete player;
+				player = NULL;
+				bOwnPlayer = false;
+			}
+		}
+
+		//=====================================================
+		//Function: CWinAMPController::MusicDialogue()
+		//Last Revised: 18.10.2026
+		//	Listen for WinAMP commands.
+		//=====================================================
+		void CWinAMPController::MusicDialogue(CDialogue& dialogue, E_RecoStatus status, const SRecoResult& result)
+		{
+			VCS_DIALOGUE_BEGIN(dialogue)
+				VCS_LOG_INFO(CVCSystem::GetSingleton().logger, "WinAMP Controller TakeControll!");
+				for(retry = 0 ; !player->Find() ; ++retry)
+				{
+					if(retry == 0)
+					{
+						CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Error);
+						player->Open("startup.mp3");
+					}
+					if(retry == START_RETRIES)
+					{
+						VCS_LOG_ERROR(CVCSystem::GetSingleton().logger, "CWinAMPController::MusicDialogue() - WinAMP didn't start");
+						bDeferred = false;
+						VCS_DIALOGUE_EXIT(dialogue);
+					}
+					VCS_DIALOGUE_AWAIT(dialogue, Delay(START_RETRY_TIME << retry));	//back off while it starts
+				}
+
+				if(bDeferred)
+				{
+					bDeferred = false;
+					Dispatch(deferred);	//deep command - no menus after it
+					VCS_DIALOGUE_EXIT(dialogue);
+				}
+
+				do
+				{
+					VCS_DIALOGUE_AWAIT(dialogue, NextUtterance((bPreserve) ? (uint32)RECO_INFINITE : (uint32)LISTEN_ADAPTIVE, MODE_MusicSelect, MODE_MusicPath));	//"volume half" too; preserved control waits till released
+					if(status == RS_Recognized)
+					{
+						menu = 0;
+						Dispatch(result);	//OnMenu() picks a menu
+						if(menu != 0)
+						{
+							VCS_DIALOGUE_AWAIT(dialogue, NextUtterance(LISTEN_ADAPTIVE, menu));
+							if(status == RS_Recognized)
+							{
+								Dispatch(result);
+							}
+							else
+							{
+								VCS_LOGF_DEBUG(CVCSystem::GetSingleton().logger, "CWinAMPController::MusicDialogue() - dropping [rule %u]", menu);
+								CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_RestateCommand);
+							}
+						}
+					}
+					else
+					{
+						CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_RestateCommand);
+					}
+					VCS_LOG_DEBUG(CVCSystem::GetSingleton().logger, "perserve!");
+				}
+				while(bPreserve);
+			VCS_DIALOGUE_END(dialogue)
+		}
+
+		//=====================================================
+		//Function: CWinAMPController::Dispatch()
+		//Last Revised: 18.10.2026
+		//	Run handler of a WinAMP command.
+		//=====================================================
+		bool CWinAMPController::Dispatch(const SRecoResult& result)
+		{
+			commandTable_t::handler_t handler = commands.Find(result.ruleId, result.value);
+			if(handler == NULL && (result.ruleId == MODE_MusicDirect || result.ruleId == MODE_MusicPath))
+			{
+				//deep command; its value is the leaf's, so find it by value
+				handler = commands.FindByValue(result.value);
+				if(handler != NULL && result.ruleId == MODE_MusicDirect && !player->Find())
+				{
+					//WinAMP isn't there; MusicDialogue() starts it and runs the command then
+					if(dialogue.IsRunning())
+					{
+						VCS_LOGF_DEBUG(CVCSystem::GetSingleton().logger, "CWinAMPController::Dispatch() - WinAMP is gone, dropping [value %u]", result.value);
+						CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Error);
+						return true;
+					}
+					deferred = result;
+					bDeferred = true;
+					CVCSystem::GetSingleton().StartDialogue(dialogue);
+					return true;
+				}
+			}
+			if(handler == NULL)
+			{
+				return false;
+			}
+			CVCSystem::GetSingleton().DispatchCommand(latency, result.value);
+			(this->*handler)(result);
+			CVCSystem::GetSingleton().CompleteCommand();
+			return true;
+		}
+
+		//=====================================================
+		//Function: CWinAMPController::Undo()
+		//Last Revised: 18.10.2026
+		//	Revert a command that ran early.
+		//=====================================================
+		bool CWinAMPController::Undo(const SRecoResult& result)
+		{
+			commandTable_t::handler_t handler = undoCommands.Find(result.ruleId, result.value);
+			if(handler == NULL)
+			{
+				return false;
+			}
+			(this->*handler)(result);
+			return true;
+		}
+
+		//---- command handlers
+
+		void CWinAMPController::OnPreserve(const SRecoResult& result)
+		{
+			//TTSVoice->Speak(L"exit exit exit", SPF_ASYNC, NULL);
+			if(bPreserve == false)
+			{
+				bPreserve=true;
+				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
+			}
+			else
+			{
+				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Deny);
+			}
+		}
+
+		void CWinAMPController::OnRelease(const SRecoResult& result)
+		{
+			if(bPreserve)
+			{
+				bPreserve = false;
+				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
+			}
+			else
+			{
+				CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Deny);
+			}
+		}
+
+		void CWinAMPController::OnTrackInfo(const SRecoResult& result)
+		{
+			CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_NotYetImplemented);
+		}
+
+		void CWinAMPController::OnMenu(const SRecoResult& result)
+		{
+			CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Accepted);
+			menu = result.value;	//phrase's value is the menu's rule
+		}
+
+		void CWinAMPController::Execute()
+		{
+			CVCSystem::GetSingleton().PlayNotifySound(CVCSystem::S_Executing);
+		}
+
+		void CWinAMPController::SetVolume(uint32 volume)
+		{
+			lastVolume = player->GetVolume();
+			player->SetVolume(volume);
+		}
+
+		void CWinAMPController::OnMute(const SRecoResult& result){ Execute(); SetVolume(0); }
+		void CWinAMPController::OnFull(const SRecoResult& result){ Execute(); SetVolume(PLAYER_MAX_VOLUME); }
+		void CWinAMPController::OnHalf(const SRecoResult& result){ Execute(); SetVolume(128); }
+		void CWinAMPController::OnOneQuater(const SRecoResult& result){ Execute(); SetVolume(255/3); }
+		void CWinAMPController::OnThreeQuater(const SRecoResult& result){ Execute(); SetVolume(510/3); }
+
+		void CWinAMPController::OnLouder(const SRecoResult& result)
+		{
+			Execute();
+			lastVolume = player->GetVolume();	//steps stop at 0 and max - don't count on stepping back
+			for(uint32 i = 0 ; i < 10 ; ++i)
+			{
+				player->VolumeUp();
+			}
+		}
+
+		void CWinAMPController::OnQuieter(const SRecoResult& result)
+		{
+			Execute();
+			lastVolume = player->GetVolume();	//steps stop at 0 and max - don't count on stepping back
+			for(uint32 i = 0 ; i < 10 ; ++i)
+			{
+				player->VolumeDown();
+			}
+		}
+
+		void CWinAMPController::OnStop(const SRecoResult& result){ Execute(); player->Stop(); }
+		void CWinAMPController::OnPause(const SRecoResult& result){ Execute(); player->Pause(); }
+		void CWinAMPController::OnResume(const SRecoResult& result){ Execute(); player->Play(); }
+		void CWinAMPController::OnNextSong(const SRecoResult& result){ Execute(); player->Next(); }
+		void CWinAMPController::OnPreviousSong(const SRecoResult& result){ Execute(); player->Previous(); }
+		void CWinAMPController::OnShuffle(const SRecoResult& result){ Execute(); player->ToggleShuffle(); }
+		void CWinAMPController::OnRepeat(const SRecoResult& result){ Execute(); player->ToggleRepeat(); }
+
+		void CWinAMPController::OnPlaylist(const SRecoResult& result)
+		{
+			static const char8* playlists[] = { "playlist/alpha.m3u", "playlist/beta.m3u", "playlist/gamma.m3u", "playlist/delta.m3u" };	//from PLAYLIST_Alpha on
+			BOOST_STATIC_ASSERT(PLAYLIST_Delta - PLAYLIST_Alpha + 1 == sizeof(playlists) / sizeof(playlists[0]));
+
+			Execute();
+			player->Open(playlists[result.value - PLAYLIST_Alpha]);
+		}
+
+		//---- undo handlers; no sounds - the user hears what the final result does
+
+		void CWinAMPController::UndoVolume(const SRecoResult& result){ player->SetVolume(lastVolume); }
+
+		void CWinAMPController::UndoPause(const SRecoResult& result){ player->Pause(); }	//pause toggles
+		void CWinAMPController::UndoNextSong(const SRecoResult& result){ player->Previous(); }
+		void CWinAMPController::UndoPreviousSong(const SRecoResult& result){ player->Next(); }
+		void CWinAMPController::UndoShuffle(const SRecoResult& result){ player->ToggleShuffle(); }
+		void CWinAMPController::UndoRepeat(const SRecoResult& result){ player->ToggleRepeat(); }
+
+		#define VCS_WINAMP_ROW(rule, value, handler) VCS_COMMAND_ROW(CWinAMPController, rule, value, handler)
+		const CWinAMPController::commandTable_t::SRow CWinAMPController::commandRows[] =
+		{
+			VCS_WINAMP_COMMANDS(VCS_WINAMP_ROW)
+		};
+
+		const CWinAMPController::commandTable_t::SRow CWinAMPController::undoRows[] =
+		{
+			VCS_WINAMP_EARLY(VCS_WINAMP_ROW)
+		};
+		#undef VCS_WINAMP_ROW
+
+		const uint32 CWinAMPController::commandCount = sizeof(CWinAMPController::commandRows) / sizeof(CWinAMPController::commandRows[0]);
+		const uint32 CWinAMPController::undoCount = sizeof(CWinAMPController::undoRows) / sizeof(CWinAMPController::undoRows[0]);
+	} //end of namespace VCS
+} //end of namespace TRC
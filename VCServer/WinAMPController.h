@@ -1,52 +1,146 @@
-#ifndef __TRC_VCS_WINAMP_CONTROLLER_H__
-#define __TRC_VCS_WINAMP_CONTROLLER_H__
-
-/*!
-\file WinAMPController.h
-\brief Header class for WinAMP Controll Tool.
-
-
-Project:	TRC Voice Control System
-
-Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
-
-Created: 29.11.2006
-Last Revised:	29.11.2006
-
-Implementation File: WinAMPController.cpp
-
-Notes:
-
-*/
-
-/*
-   
-*/
-
-#include "Defines.h"
-
-#include <windows.h>
-namespace TRC
-{
-	namespace VCS
-	{
-		class CWinAMPController
-		{
-		protected:
-			CComPtr<ISpRecoGrammar> grammar; //!< WinAMP controll grammar.
-			bool bPreserve;	//!< Keep control ;)
-
-			HWND hWinAMP;
-		public:
-			void Init();
-			void DeInit();
-			
-			void TakeControll();
-			void VolumeMenu();
-			void PlaybackMenu();
-			void PlaylistMenu();
-		};
-	};
-};
-
+#ifndef __TRC_VCS_WINAMP_CONTROLLER_H__
+#define __TRC_VCS_WINAMP_CONTROLLER_H__
+
+/*!
+\file WinAMPController.h
+\brief Header class for WinAMP Controll Tool.
+
+
+Project:	TRC Voice Control System
+
+Programmer:	Jacek "TeMPOraL" Zlydach	[temporal@v-lo.krakow.pl]
+
+Created: 29.11.2006
+Last Revised:	29.11.2006
+
+Implementation File: WinAMPController.cpp
+
+Notes:
+
+*/
+
+/*
+   
+*/
+
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include "Recognizer.h"
+#include "Player.h"
+#include "CommandLatency.h"
+#include "CommandTable.h"
+#include "Dialogue.h"
+
+namespace TRC
+{
+	namespace VCS
+	{
+		class CWinAMPController
+		{
+		public:
+			enum
+			{
+				START_RETRY_TIME = 250,	//!< Wait [ms] before checking again if WinAMP started; doubles every time...
+				START_RETRIES = 5	//!< ...this many times.
+			};
+
+		protected:
+			uint32 grammar; //!< Handle of WinAMP controll grammar.
+			bool bPreserve;	//!< Keep control ;)
+
+			IPlayer* player;	//!< Player we control.
+			bool bOwnPlayer;	//!< Did Init() create the player?
+
+			CCommandLatency latency;	//!< Latency of WinAMP commands.
+
+			CMemberDialogue<CWinAMPController> dialogue;	//!< "music control" ...
+			uint32 menu;	//!< Rule of menu picked by the last command; 0 if none was.
+			uint32 retry;	//!< Checks of WinAMP presence so far.
+			SRecoResult deferred;	//!< Deep command waiting for WinAMP to start.
+			bool bDeferred;	//!< Is there a deferred command?
+			uint32 lastVolume;	//!< Volume before the last command that changed it.
+
+			typedef CCommandTable<CWinAMPController> commandTable_t;
+			static const commandTable_t::SRow commandRows[];	//!< WinAMP commands, from grammar/winamp.h.
+			static const uint32 commandCount;	//!< Count of commandRows.
+			commandTable_t commands;	//!< Handlers of WinAMP commands.
+			static const commandTable_t::SRow undoRows[];	//!< Undo handlers of early commands, from grammar/winamp.h.
+			static const uint32 undoCount;	//!< Count of undoRows.
+			commandTable_t undoCommands;	//!< Undo handlers of early commands.
+
+			void Execute();	//!< Lets the user know a command is being executed.
+			void SetVolume(uint32 volume);	//!< Sets volume, remembering the one it was.
+
+			//! \brief "music control" - start WinAMP if needed, and listen for its commands and menus until released;
+			//! or just run the deferred deep command, once WinAMP is up.
+			void MusicDialogue(CDialogue& dialogue, E_RecoStatus status, const SRecoResult& result);
+
+			//---- command handlers, see grammar/winamp.h
+			void OnPreserve(const SRecoResult& result);
+			void OnRelease(const SRecoResult& result);
+			void OnTrackInfo(const SRecoResult& result);
+			void OnMenu(const SRecoResult& result);
+			void OnMute(const SRecoResult& result);
+			void OnFull(const SRecoResult& result);
+			void OnHalf(const SRecoResult& result);
+			void OnOneQuater(const SRecoResult& result);
+			void OnThreeQuater(const SRecoResult& result);
+			void OnLouder(const SRecoResult& result);
+			void OnQuieter(const SRecoResult& result);
+			void OnStop(const SRecoResult& result);
+			void OnPause(const SRecoResult& result);
+			void OnResume(const SRecoResult& result);
+			void OnNextSong(const SRecoResult& result);
+			void OnPreviousSong(const SRecoResult& result);
+			void OnShuffle(const SRecoResult& result);
+			void OnRepeat(const SRecoResult& result);
+			void OnPlaylist(const SRecoResult& result);
+
+			//---- undo handlers of early commands, see grammar/winamp.h
+			void UndoVolume(const SRecoResult& result);
+			void UndoPause(const SRecoResult& result);
+			void UndoNextSong(const SRecoResult& result);
+			void UndoPreviousSong(const SRecoResult& result);
+			void UndoShuffle(const SRecoResult& result);
+			void UndoRepeat(const SRecoResult& result);
+		public:
+			CWinAMPController():grammar(RECO_INVALID_GRAMMAR), bPreserve(false), player(NULL), bOwnPlayer(false), latency("winamp"), menu(0), retry(0), bDeferred(false), lastVolume(PLAYER_MAX_VOLUME), commands(commandRows, commandCount), undoCommands(undoRows, undoCount)
+			{
+				dialogue.Bind(this, &CWinAMPController::MusicDialogue);
+			}	//!< Constructor.
+
+			//! \brief Sets player to control, instead of WinAMP; call before Init().
+			//! Player isn't deleted by the controller.
+			void SetPlayer(IPlayer* _player){ player = _player; }
+
+			//! \brief Returns latency of WinAMP commands.
+			const CCommandLatency& GetLatency() const { return latency; }
+
+			//! \brief Returns handle of WinAMP grammar.
+			uint32 GetGrammar() const { return grammar; }
+
+			//! \brief Returns dialogue taking control of WinAMP; for CVCSystem::StartDialogue().
+			CDialogue& GetDialogue(){ return dialogue; }
+
+			//! \brief Checks if control is preserved - nothing but WinAMP commands is listened for.
+			bool IsPreserved() const { return bPreserve; }
+
+			void Init();
+			void DeInit();
+			
+			//! \brief Runs handler of a WinAMP command, menu or deep one.
+			//! \return Returns false if result isn't a WinAMP command.
+			bool Dispatch(const SRecoResult& result);
+
+			//! \brief Checks if command may run early - it can be undone.
+			bool CanUndo(const SRecoResult& result) const { return undoCommands.Find(result.ruleId, result.value) != NULL; }
+
+			//! \brief Reverts a command that ran early, on a hypothesis the final result didn't confirm.
+			//! \return Returns false if command can't be undone.
+			bool Undo(const SRecoResult& result);
+		};
+	};
+};
+
 #endif //__TRC_VCS_WINAMP_CONTROLLER_H__
\ No newline at end of file
@@ -1,6 +1,25 @@
-#define CMD_ActivateVC 64
-#define CMD_ShutdownVC 65
-#define CMD_MusicControl 66
-#define MODE_SelectModule 252
-#define MODE_Select 253
-#define MODE_Music 254
+//Core grammar (core.xml); values must match its <DEFINE> section.
+//X(name, value)
+
+//rules - IDs unique across all grammars
+#define VCS_CORE_RULES(X) \
+	X(MODE_SelectModule, 252) \
+	X(MODE_Select, 253) \
+	X(MODE_Music, 254)
+
+//property values
+#define VCS_CORE_VALUES(X) \
+	X(CMD_ActivateVC, 64) \
+	X(CMD_ShutdownVC, 65) \
+	X(CMD_MusicControl, 66)
+
+//commands: X(rule, value, handler) - CVCSystem::handler() runs when phrase of value is recognized in rule
+#define VCS_CORE_COMMANDS(X) \
+	X(MODE_Select, CMD_ActivateVC, OnActivate) \
+	X(MODE_SelectModule, CMD_MusicControl, OnMusicControl) \
+	X(MODE_SelectModule, CMD_ShutdownVC, OnShutdown)
+//confidence thresholds: X(rule, percent) - results of rule the engine is less sure of are rescored (see Rescorer.h);
+//"computer" comes out of silence, and music, so it has to be sure
+#define VCS_CORE_CONFIDENCE(X) \
+	X(MODE_Select, 60) \
+	X(MODE_SelectModule, 40)
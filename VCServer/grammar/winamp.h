@@ -1,27 +1,88 @@
-#define PLAYLIST_Alpha 1
-#define PLAYLIST_Beta 2
-#define PLAYLIST_Gamma 3
-#define PLAYLIST_Delta 4
-#define CMD_Stop 64
-#define CMD_Pause 65
-#define CMD_Loop 66
-#define CMD_Repeat 67
-#define CMD_Shuffle 68
-#define CMD_NextSong 69
-#define CMD_PreviousSong 70
-#define CMD_Mute 71
-#define CMD_Full 72
-#define CMD_Half 73
-#define CMD_OneQuater 74
-#define CMD_ThreeQuater 75
-#define CMD_Louder 76
-#define CMD_Quieter 77
-#define CMD_Resume 78
-#define CMD_TrackInfo 79
-#define CMD_Preserve 80
-#define CMD_Release 81
-#define MODE_TrackInfo 250
-#define MODE_Playback 251
-#define MODE_Volume 252
-#define MODE_Playlist 253
-#define MODE_Select 254
+//WinAMP grammar (winamp.xml); values must match its <DEFINE> section.
+//X(name, value)
+
+//rules - IDs unique across all grammars; MODE_MusicPath and MODE_MusicDirect match deep
+//commands ("music volume half"), dispatched by value
+#define VCS_WINAMP_RULES(X) \
+	X(MODE_MusicPath, 244) \
+	X(MODE_MusicDirect, 245) \
+	X(MODE_TrackInfo, 246) \
+	X(MODE_Playback, 247) \
+	X(MODE_Volume, 248) \
+	X(MODE_Playlist, 249) \
+	X(MODE_MusicSelect, 250)
+
+//property values
+#define VCS_WINAMP_VALUES(X) \
+	X(PLAYLIST_Alpha, 1) \
+	X(PLAYLIST_Beta, 2) \
+	X(PLAYLIST_Gamma, 3) \
+	X(PLAYLIST_Delta, 4) \
+	X(CMD_Stop, 64) \
+	X(CMD_Pause, 65) \
+	X(CMD_Loop, 66) \
+	X(CMD_Repeat, 67) \
+	X(CMD_Shuffle, 68) \
+	X(CMD_NextSong, 69) \
+	X(CMD_PreviousSong, 70) \
+	X(CMD_Mute, 71) \
+	X(CMD_Full, 72) \
+	X(CMD_Half, 73) \
+	X(CMD_OneQuater, 74) \
+	X(CMD_ThreeQuater, 75) \
+	X(CMD_Louder, 76) \
+	X(CMD_Quieter, 77) \
+	X(CMD_Resume, 78) \
+	X(CMD_TrackInfo, 79) \
+	X(CMD_Preserve, 80) \
+	X(CMD_Release, 81)
+
+//commands: X(rule, value, handler) - CWinAMPController::handler() runs when phrase of value is recognized in rule
+#define VCS_WINAMP_COMMANDS(X) \
+	X(MODE_MusicSelect, CMD_Preserve, OnPreserve) \
+	X(MODE_MusicSelect, CMD_Release, OnRelease) \
+	X(MODE_MusicSelect, CMD_TrackInfo, OnTrackInfo) \
+	X(MODE_MusicSelect, MODE_Volume, OnMenu) \
+	X(MODE_MusicSelect, MODE_Playback, OnMenu) \
+	X(MODE_MusicSelect, MODE_Playlist, OnMenu) \
+	X(MODE_Volume, CMD_Mute, OnMute) \
+	X(MODE_Volume, CMD_Full, OnFull) \
+	X(MODE_Volume, CMD_Half, OnHalf) \
+	X(MODE_Volume, CMD_OneQuater, OnOneQuater) \
+	X(MODE_Volume, CMD_ThreeQuater, OnThreeQuater) \
+	X(MODE_Volume, CMD_Louder, OnLouder) \
+	X(MODE_Volume, CMD_Quieter, OnQuieter) \
+	X(MODE_Playback, CMD_Stop, OnStop) \
+	X(MODE_Playback, CMD_Pause, OnPause) \
+	X(MODE_Playback, CMD_Resume, OnResume) \
+	X(MODE_Playback, CMD_NextSong, OnNextSong) \
+	X(MODE_Playback, CMD_PreviousSong, OnPreviousSong) \
+	X(MODE_Playback, CMD_Shuffle, OnShuffle) \
+	X(MODE_Playback, CMD_Repeat, OnRepeat) \
+	X(MODE_Playlist, PLAYLIST_Alpha, OnPlaylist) \
+	X(MODE_Playlist, PLAYLIST_Beta, OnPlaylist) \
+	X(MODE_Playlist, PLAYLIST_Gamma, OnPlaylist) \
+	X(MODE_Playlist, PLAYLIST_Delta, OnPlaylist)
+//early commands: X(rule, value, undo) - may run on a hypothesis (-early, see EarlyExecution.h);
+//CWinAMPController::undo() reverts one the final result didn't confirm; CMD_Resume isn't
+//one of them - Play() restarts a playing track, nothing brings its position back
+#define VCS_WINAMP_EARLY(X) \
+	X(MODE_Volume, CMD_Mute, UndoVolume) \
+	X(MODE_Volume, CMD_Full, UndoVolume) \
+	X(MODE_Volume, CMD_Half, UndoVolume) \
+	X(MODE_Volume, CMD_Louder, UndoVolume) \
+	X(MODE_Volume, CMD_Quieter, UndoVolume) \
+	X(MODE_Playback, CMD_Pause, UndoPause) \
+	X(MODE_Playback, CMD_NextSong, UndoNextSong) \
+	X(MODE_Playback, CMD_PreviousSong, UndoPreviousSong) \
+	X(MODE_Playback, CMD_Shuffle, UndoShuffle) \
+	X(MODE_Playback, CMD_Repeat, UndoRepeat)
+//confidence thresholds: X(rule, percent) - results of rule the engine is less sure of are rescored (see Rescorer.h);
+//MODE_MusicDirect comes out of silence, like "computer"
+#define VCS_WINAMP_CONFIDENCE(X) \
+	X(MODE_MusicDirect, 60) \
+	X(MODE_MusicPath, 40) \
+	X(MODE_MusicSelect, 35) \
+	X(MODE_Playback, 35) \
+	X(MODE_Volume, 35) \
+	X(MODE_Playlist, 35)
@@ -1,22 +1,35 @@
-#include "Defines.h"
-#include "BaseTypes.h"
-
-#include "VCSystem.h"
-
-#include <windows.h>
-
-//int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nShowCmd)
-int main(int argc, char*argv[])
-{
-	new TRC::VCS::CVCSystem;
-
-	TRC::VCS::CVCSystem::GetSingleton().Init();
-
-	TRC::VCS::CVCSystem::GetSingleton().Run(argc, argv);
-
-	TRC::VCS::CVCSystem::GetSingleton().DeInit();
-
-	delete TRC::VCS::CVCSystem::GetSingletonPtr();
-
-	return 0;
+#include "Defines.h"
+#include "BaseTypes.h"
+
+#include "VCSystem.h"
+
+#include <windows.h>
+
+//! \brief Dumps command latency on Ctrl+Break; lets other console events through.
+static BOOL WINAPI ConsoleHandler(DWORD ctrlType)
+{
+	if(ctrlType == CTRL_BREAK_EVENT)
+	{
+		TRC::VCS::CVCSystem::GetSingleton().DumpLatency();	//runs on its own thread; see CVCSystem::DumpLatency()
+		return TRUE;
+	}
+	return FALSE;
+}
+
+//int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nShowCmd)
+int main(int argc, char*argv[])
+{
+	new TRC::VCS::CVCSystem;
+
+	TRC::VCS::CVCSystem::GetSingleton().Init(argc, argv);
+	SetConsoleCtrlHandler(ConsoleHandler, TRUE);
+
+	TRC::VCS::CVCSystem::GetSingleton().Run(argc, argv);
+
+	SetConsoleCtrlHandler(ConsoleHandler, FALSE);
+	TRC::VCS::CVCSystem::GetSingleton().DeInit();
+
+	delete TRC::VCS::CVCSystem::GetSingletonPtr();
+
+	return 0;
 }
\ No newline at end of file